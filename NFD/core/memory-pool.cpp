@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "memory-pool.hpp"
+
+#include <cstddef>
+
+namespace nfd {
+
+const size_t MemoryPool::MIN_CHUNK_BLOCKS = 32;
+const size_t MemoryPool::MAX_CHUNK_BLOCKS = 4096;
+
+MemoryPool::MemoryPool(size_t blockSize)
+  : m_requestSize(0)
+  , m_blockSize(0)
+  , m_freeList(nullptr)
+  , m_nAllocatedBlocks(0)
+  , m_nBlocks(0)
+{
+  if (blockSize > 0) {
+    m_requestSize = blockSize;
+  }
+}
+
+MemoryPool::~MemoryPool()
+{
+  BOOST_ASSERT_MSG(m_nAllocatedBlocks == 0, "MemoryPool destroyed while blocks are in use");
+
+  for (void* chunk : m_chunks) {
+    ::operator delete(chunk);
+  }
+}
+
+void*
+MemoryPool::allocate(size_t size)
+{
+  BOOST_ASSERT(this->canAllocate(size));
+  if (m_requestSize == 0) {
+    m_requestSize = size;
+  }
+
+  if (m_freeList == nullptr) {
+    this->grow();
+  }
+
+  FreeBlock* block = m_freeList;
+  m_freeList = block->next;
+  ++m_nAllocatedBlocks;
+  return block;
+}
+
+void
+MemoryPool::deallocate(void* p)
+{
+  BOOST_ASSERT(p != nullptr);
+  BOOST_ASSERT(m_nAllocatedBlocks > 0);
+
+  FreeBlock* block = static_cast<FreeBlock*>(p);
+  block->next = m_freeList;
+  m_freeList = block;
+  --m_nAllocatedBlocks;
+}
+
+void
+MemoryPool::grow()
+{
+  if (m_blockSize == 0) {
+    // every block must hold a FreeBlock, and be aligned for any type
+    const size_t alignment = alignof(std::max_align_t);
+    m_blockSize = std::max(m_requestSize, sizeof(FreeBlock));
+    m_blockSize = (m_blockSize + alignment - 1) / alignment * alignment;
+  }
+
+  size_t nChunkBlocks = std::min(std::max(m_nBlocks, MIN_CHUNK_BLOCKS), MAX_CHUNK_BLOCKS);
+  m_chunks.reserve(m_chunks.size() + 1);
+  char* chunk = static_cast<char*>(::operator new(nChunkBlocks * m_blockSize));
+  m_chunks.push_back(chunk);
+  m_nBlocks += nChunkBlocks;
+
+  // link blocks so that they are allocated in address order
+  for (size_t i = nChunkBlocks; i > 0; --i) {
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * m_blockSize);
+    block->next = m_freeList;
+    m_freeList = block;
+  }
+}
+
+} // namespace nfd
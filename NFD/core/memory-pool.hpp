@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NFD_CORE_MEMORY_POOL_HPP
+#define NFD_CORE_MEMORY_POOL_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+/** \brief a pool of fixed-size memory blocks
+ *
+ *  Blocks are carved from chunks obtained from the heap. A deallocated block is kept in
+ *  a free list and reused by the next allocation; chunks are released only when the pool
+ *  is destroyed. This avoids malloc/free for tables that create and erase many entries of
+ *  the same type.
+ *
+ *  The pool is not thread-safe.
+ */
+class MemoryPool : noncopyable
+{
+public:
+  /** \param blockSize size of each block; if zero, it's set by the first allocation
+   */
+  explicit
+  MemoryPool(size_t blockSize = 0);
+
+  ~MemoryPool();
+
+  /** \return whether a request of \p size bytes can be served from this pool
+   */
+  bool
+  canAllocate(size_t size) const
+  {
+    return m_requestSize == 0 || size == m_requestSize;
+  }
+
+  /** \brief allocates a block
+   *  \pre canAllocate(size)
+   */
+  void*
+  allocate(size_t size);
+
+  /** \brief returns a block to the pool
+   *  \param p a block obtained from allocate() of this pool
+   */
+  void
+  deallocate(void* p);
+
+  /** \return size of each block, including padding for alignment
+   */
+  size_t
+  getBlockSize() const
+  {
+    return m_blockSize;
+  }
+
+  /** \return number of blocks in use
+   */
+  size_t
+  getNAllocatedBlocks() const
+  {
+    return m_nAllocatedBlocks;
+  }
+
+  /** \return number of blocks in all chunks, including free blocks
+   */
+  size_t
+  getNBlocks() const
+  {
+    return m_nBlocks;
+  }
+
+private:
+  /** \brief obtains a new chunk and adds its blocks to the free list
+   */
+  void
+  grow();
+
+public:
+  /// number of blocks in the first chunk
+  static const size_t MIN_CHUNK_BLOCKS;
+
+  /// maximum number of blocks in a chunk; chunks double in size up to this limit
+  static const size_t MAX_CHUNK_BLOCKS;
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  size_t m_requestSize;
+  size_t m_blockSize;
+  FreeBlock* m_freeList;
+  std::vector<void*> m_chunks;
+  size_t m_nAllocatedBlocks;
+  size_t m_nBlocks;
+};
+
+/** \brief an allocator that obtains single objects from a MemoryPool
+ *
+ *  This is intended for std::allocate_shared: the object and its control block are placed
+ *  in one pool block. Every copy of the allocator, including the one kept in the control
+ *  block, shares ownership of the pool, so that the pool outlives all objects allocated
+ *  from it. Requests that don't fit the pool's block size are served by operator new.
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+  typedef T value_type;
+
+  explicit
+  PoolAllocator(shared_ptr<MemoryPool> pool)
+    : m_pool(std::move(pool))
+  {
+    BOOST_ASSERT(m_pool != nullptr);
+  }
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U>& other)
+    : m_pool(other.getPool())
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    if (n == 1 && m_pool->canAllocate(sizeof(T))) {
+      return static_cast<T*>(m_pool->allocate(sizeof(T)));
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void
+  deallocate(T* p, size_t n)
+  {
+    if (n == 1 && m_pool->canAllocate(sizeof(T))) {
+      m_pool->deallocate(p);
+    }
+    else {
+      ::operator delete(p);
+    }
+  }
+
+  const shared_ptr<MemoryPool>&
+  getPool() const
+  {
+    return m_pool;
+  }
+
+private:
+  shared_ptr<MemoryPool> m_pool;
+};
+
+template<typename T, typename U>
+bool
+operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+{
+  return lhs.getPool() == rhs.getPool();
+}
+
+template<typename T, typename U>
+bool
+operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs)
+{
+  return lhs.getPool() != rhs.getPool();
+}
+
+} // namespace nfd
+
+#endif // NFD_CORE_MEMORY_POOL_HPP
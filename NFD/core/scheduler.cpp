@@ -24,43 +24,35 @@
  */
 
 #include "scheduler.hpp"
+#include "global-io.hpp"
 
-namespace ns3 {
+#include <boost/thread/tss.hpp>
 
-/// @cond include_hidden
-
-template<>
-struct EventMemberImplObjTraits<std::function<void()>> {
-  typedef std::function<void()> T;
-  static T&
-  GetReference(T& p)
-  {
-    return p;
-  }
-};
+namespace nfd {
+namespace scheduler {
 
-/// @endcond
+static boost::thread_specific_ptr<Scheduler> g_scheduler;
 
-} // namespace ns3
+Scheduler&
+getGlobalScheduler()
+{
+  if (g_scheduler.get() == nullptr) {
+    g_scheduler.reset(new Scheduler(getGlobalIoService()));
+  }
 
-namespace nfd {
-namespace scheduler {
+  return *g_scheduler;
+}
 
 EventId
 schedule(const time::nanoseconds& after, const std::function<void()>& event)
 {
-  ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
-                                             &std::function<void()>::operator(), event);
-  return std::make_shared<ns3::EventId>(id);
+  return getGlobalScheduler().scheduleEvent(after, event);
 }
 
 void
 cancel(const EventId& eventId)
 {
-  if (eventId != nullptr) {
-    ns3::Simulator::Remove(*eventId);
-    const_cast<EventId&>(eventId).reset();
-  }
+  getGlobalScheduler().cancelEvent(eventId);
 }
 
 ScopedEventId::ScopedEventId()
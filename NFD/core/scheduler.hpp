@@ -28,15 +28,22 @@
 
 #include "common.hpp"
 
-#include "ns3/simulator.h"
+#include <ndn-cxx/util/scheduler.hpp>
 
 namespace nfd {
 namespace scheduler {
 
+using ndn::util::scheduler::Scheduler;
+
 /** \class EventId
  *  \brief Opaque type (shared_ptr) representing ID of a scheduled event
  */
-typedef std::shared_ptr<ns3::EventId> EventId;
+using ndn::util::scheduler::EventId;
+
+/** \return the Scheduler used by schedule() and cancel() on the calling thread
+ */
+Scheduler&
+getGlobalScheduler();
 
 /** \brief schedule an event
  */
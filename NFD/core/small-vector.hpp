@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NFD_CORE_SMALL_VECTOR_HPP
+#define NFD_CORE_SMALL_VECTOR_HPP
+
+#include "common.hpp"
+
+#include <algorithm>
+
+namespace nfd {
+
+/** \brief a sequence container that stores up to N elements inline
+ *  \tparam T element type, must be MoveConstructible
+ *  \tparam N number of elements stored without a heap allocation
+ *
+ *  Elements are contiguous, so iterators are plain pointers.
+ *  Inserting or erasing an element invalidates iterators at and after that position;
+ *  spilling to the heap when more than N elements are stored invalidates all iterators.
+ */
+template<typename T, size_t N>
+class SmallVector : noncopyable
+{
+  static_assert(N > 0, "SmallVector must have inline capacity");
+
+public:
+  typedef T value_type;
+  typedef T* iterator;
+  typedef const T* const_iterator;
+  typedef size_t size_type;
+
+  SmallVector()
+    : m_begin(reinterpret_cast<T*>(m_inline))
+    , m_size(0)
+    , m_capacity(N)
+  {
+  }
+
+  ~SmallVector()
+  {
+    this->clear();
+    if (!this->isInline()) {
+      ::operator delete(m_begin);
+    }
+  }
+
+  iterator
+  begin()
+  {
+    return m_begin;
+  }
+
+  const_iterator
+  begin() const
+  {
+    return m_begin;
+  }
+
+  iterator
+  end()
+  {
+    return m_begin + m_size;
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_begin + m_size;
+  }
+
+  size_type
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  size_type
+  capacity() const
+  {
+    return m_capacity;
+  }
+
+  T&
+  front()
+  {
+    BOOST_ASSERT(!this->empty());
+    return *m_begin;
+  }
+
+  const T&
+  front() const
+  {
+    BOOST_ASSERT(!this->empty());
+    return *m_begin;
+  }
+
+  /** \brief constructs an element in place before \p pos
+   *  \return iterator to the new element
+   */
+  template<typename... A>
+  iterator
+  emplace(const_iterator pos, A&&... args)
+  {
+    size_type index = pos - m_begin;
+    BOOST_ASSERT(index <= m_size);
+    if (m_size == m_capacity) {
+      this->grow();
+    }
+
+    iterator it = m_begin + index;
+    if (index == m_size) {
+      new (it) T(std::forward<A>(args)...);
+    }
+    else {
+      // construct first so that an exception leaves the container unchanged
+      T element(std::forward<A>(args)...);
+      iterator last = this->end();
+      new (last) T(std::move(*(last - 1)));
+      std::move_backward(it, last - 1, last);
+      *it = std::move(element);
+    }
+    ++m_size;
+    return it;
+  }
+
+  template<typename... A>
+  iterator
+  emplace_back(A&&... args)
+  {
+    return this->emplace(this->end(), std::forward<A>(args)...);
+  }
+
+  /** \brief erases the element at \p pos
+   *  \return iterator following the erased element
+   */
+  iterator
+  erase(const_iterator pos)
+  {
+    iterator it = m_begin + (pos - m_begin);
+    BOOST_ASSERT(it >= m_begin && it < this->end());
+    std::move(it + 1, this->end(), it);
+    --m_size;
+    m_begin[m_size].~T();
+    return it;
+  }
+
+  void
+  clear()
+  {
+    for (iterator it = m_begin; it != this->end(); ++it) {
+      it->~T();
+    }
+    m_size = 0;
+  }
+
+private:
+  bool
+  isInline() const
+  {
+    return m_begin == reinterpret_cast<const T*>(m_inline);
+  }
+
+  void
+  grow()
+  {
+    // grow slowly: containers are expected to stay small
+    size_type newCapacity = m_capacity + std::max<size_type>(m_capacity / 2, 1);
+    T* storage = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+    for (size_type i = 0; i < m_size; ++i) {
+      new (storage + i) T(std::move(m_begin[i]));
+      m_begin[i].~T();
+    }
+    if (!this->isInline()) {
+      ::operator delete(m_begin);
+    }
+    m_begin = storage;
+    m_capacity = newCapacity;
+  }
+
+private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type m_inline[N];
+  T* m_begin;
+  size_type m_size;
+  size_type m_capacity;
+};
+
+} // namespace nfd
+
+#endif // NFD_CORE_SMALL_VECTOR_HPP
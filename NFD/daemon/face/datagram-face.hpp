@@ -29,6 +29,13 @@
 #include "face.hpp"
 #include "core/global-io.hpp"
 
+#include <deque>
+
+#ifdef __linux__
+#include <cerrno>       // for errno
+#include <sys/socket.h> // for recvmmsg() and sendmmsg()
+#endif
+
 namespace nfd {
 
 struct Unicast {};
@@ -47,6 +54,35 @@ public:
   DatagramFace(const FaceUri& remoteUri, const FaceUri& localUri,
                typename protocol::socket socket);
 
+  /** \brief set the number of datagrams received or sent with one system call
+   *
+   *  With \p batchSize greater than 1, the face receives with recvmmsg into a ring
+   *  of \p batchSize preallocated buffers, and packets sent while the same event is
+   *  being processed are sent together with sendmmsg.  The default is 1, i.e., one
+   *  system call per datagram.  Batching is available only on Linux; elsewhere
+   *  the batch size stays 1.
+   */
+  void
+  setBatchSize(size_t batchSize);
+
+  size_t
+  getBatchSize() const
+  {
+    return m_batchSize;
+  }
+
+  const BatchCounters&
+  getReceiveBatchCounters() const
+  {
+    return m_receiveBatchCounters;
+  }
+
+  const BatchCounters&
+  getSendBatchCounters() const
+  {
+    return m_sendBatchCounters;
+  }
+
   // from Face
   void
   sendInterest(const Interest& interest) DECL_OVERRIDE;
@@ -63,6 +99,17 @@ public:
                   const boost::system::error_code& error);
 
 protected:
+  /** \brief send packets through \p socket to \p destination
+   *
+   *  By default, packets are sent through the face's own socket, which is connected
+   *  to the remote endpoint.
+   */
+  void
+  setSendSocket(typename protocol::socket& socket, const typename protocol::endpoint& destination);
+
+  void
+  sendBlock(const Block& block);
+
   void
   processErrorCode(const boost::system::error_code& error);
 
@@ -95,9 +142,37 @@ protected:
 
   NFD_LOG_INCLASS_DECLARE();
 
+private:
+  void
+  startReceive();
+
+  void
+  handleReceiveReady(const boost::system::error_code& error);
+
+  void
+  flushSendQueue(const shared_ptr<Face>& face);
+
+  void
+  handleSendReady(const boost::system::error_code& error, const shared_ptr<Face>& face);
+
 private:
   uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
   bool m_hasBeenUsedRecently;
+
+  size_t m_batchSize;
+  typename protocol::socket* m_outSocket;
+  unique_ptr<typename protocol::endpoint> m_outDestination;
+  std::deque<Block> m_sendQueue; ///< packets waiting for sendmmsg
+  bool m_isFlushPending;
+#ifdef __linux__
+  std::vector<uint8_t> m_receiveRing; ///< m_batchSize buffers of MAX_NDN_PACKET_SIZE octets
+  std::vector<iovec> m_receiveIovecs;
+  std::vector<mmsghdr> m_receiveMsgs;
+  std::vector<iovec> m_sendIovecs;
+  std::vector<mmsghdr> m_sendMsgs;
+#endif
+  BatchCounters m_receiveBatchCounters;
+  BatchCounters m_sendBatchCounters;
 };
 
 
@@ -107,13 +182,52 @@ DatagramFace<T, U>::DatagramFace(const FaceUri& remoteUri, const FaceUri& localU
                                  typename DatagramFace::protocol::socket socket)
   : Face(remoteUri, localUri, false, std::is_same<U, Multicast>::value)
   , m_socket(std::move(socket))
+  , m_batchSize(1)
+  , m_outSocket(&m_socket)
+  , m_isFlushPending(false)
 {
   NFD_LOG_FACE_INFO("Creating face");
 
-  m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                         bind(&DatagramFace<T, U>::handleReceive, this,
-                              boost::asio::placeholders::error,
-                              boost::asio::placeholders::bytes_transferred));
+  startReceive();
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::setBatchSize(size_t batchSize)
+{
+  BOOST_ASSERT(batchSize > 0);
+#ifdef __linux__
+  m_batchSize = batchSize;
+  if (m_batchSize == 1) {
+    m_receiveRing.clear();
+    return;
+  }
+
+  m_receiveRing.resize(m_batchSize * ndn::MAX_NDN_PACKET_SIZE);
+  m_receiveIovecs.resize(m_batchSize);
+  m_receiveMsgs.resize(m_batchSize);
+  for (size_t i = 0; i < m_batchSize; ++i) {
+    m_receiveIovecs[i].iov_base = &m_receiveRing[i * ndn::MAX_NDN_PACKET_SIZE];
+    m_receiveIovecs[i].iov_len = ndn::MAX_NDN_PACKET_SIZE;
+    m_receiveMsgs[i] = mmsghdr();
+    m_receiveMsgs[i].msg_hdr.msg_iov = &m_receiveIovecs[i];
+    m_receiveMsgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  m_sendIovecs.resize(m_batchSize);
+  m_sendMsgs.resize(m_batchSize);
+#else
+  if (batchSize > 1)
+    NFD_LOG_FACE_DEBUG("Batched datagram I/O is not supported on this platform");
+#endif
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::setSendSocket(typename protocol::socket& socket,
+                                  const typename protocol::endpoint& destination)
+{
+  m_outSocket = &socket;
+  m_outDestination.reset(new typename protocol::endpoint(destination));
 }
 
 template<class T, class U>
@@ -123,13 +237,7 @@ DatagramFace<T, U>::sendInterest(const Interest& interest)
   NFD_LOG_FACE_TRACE(__func__);
 
   this->emitSignal(onSendInterest, interest);
-
-  const Block& payload = interest.wireEncode();
-  m_socket.async_send(boost::asio::buffer(payload.wire(), payload.size()),
-                      bind(&DatagramFace<T, U>::handleSend, this,
-                           boost::asio::placeholders::error,
-                           boost::asio::placeholders::bytes_transferred,
-                           payload));
+  sendBlock(interest.wireEncode());
 }
 
 template<class T, class U>
@@ -139,13 +247,33 @@ DatagramFace<T, U>::sendData(const Data& data)
   NFD_LOG_FACE_TRACE(__func__);
 
   this->emitSignal(onSendData, data);
+  sendBlock(data.wireEncode());
+}
 
-  const Block& payload = data.wireEncode();
-  m_socket.async_send(boost::asio::buffer(payload.wire(), payload.size()),
-                      bind(&DatagramFace<T, U>::handleSend, this,
-                           boost::asio::placeholders::error,
-                           boost::asio::placeholders::bytes_transferred,
-                           payload));
+template<class T, class U>
+inline void
+DatagramFace<T, U>::sendBlock(const Block& block)
+{
+  if (m_batchSize == 1 && m_sendQueue.empty()) {
+    auto handler = bind(&DatagramFace<T, U>::handleSend, this,
+                        boost::asio::placeholders::error,
+                        boost::asio::placeholders::bytes_transferred,
+                        block);
+    if (m_outDestination != nullptr)
+      m_outSocket->async_send_to(boost::asio::buffer(block.wire(), block.size()),
+                                  *m_outDestination, handler);
+    else
+      m_outSocket->async_send(boost::asio::buffer(block.wire(), block.size()), handler);
+    return;
+  }
+
+  // packets sent while the current event is being processed are sent together
+  m_sendQueue.push_back(block);
+  if (!m_isFlushPending) {
+    m_isFlushPending = true;
+    getGlobalIoService().post(bind(&DatagramFace<T, U>::flushSendQueue,
+                                   this, this->shared_from_this()));
+  }
 }
 
 template<class T, class U>
@@ -203,6 +331,105 @@ DatagramFace<T, U>::handleSend(const boost::system::error_code& error,
   this->getMutableCounters().getNOutBytes() += nBytesSent;
 }
 
+template<class T, class U>
+inline void
+DatagramFace<T, U>::flushSendQueue(const shared_ptr<Face>& face)
+{
+  m_isFlushPending = false;
+
+#ifdef __linux__
+  while (!m_sendQueue.empty() && m_socket.is_open()) {
+    size_t nMsgs = std::min(m_sendQueue.size(), m_sendMsgs.size());
+    if (nMsgs == 0) // batching was disabled after the packets were queued
+      break;
+
+    for (size_t i = 0; i < nMsgs; ++i) {
+      const Block& block = m_sendQueue[i];
+      m_sendIovecs[i].iov_base = const_cast<uint8_t*>(block.wire());
+      m_sendIovecs[i].iov_len = block.size();
+      m_sendMsgs[i] = mmsghdr();
+      m_sendMsgs[i].msg_hdr.msg_iov = &m_sendIovecs[i];
+      m_sendMsgs[i].msg_hdr.msg_iovlen = 1;
+      if (m_outDestination != nullptr) {
+        m_sendMsgs[i].msg_hdr.msg_name = m_outDestination->data();
+        m_sendMsgs[i].msg_hdr.msg_namelen = m_outDestination->size();
+      }
+    }
+
+    int nSent = ::sendmmsg(m_outSocket->native_handle(), m_sendMsgs.data(), nMsgs, MSG_DONTWAIT);
+    if (nSent < 0) {
+      if (errno == EINTR)
+        continue;
+
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // socket send buffer is full, continue when the socket becomes writable
+        m_isFlushPending = true;
+        m_outSocket->async_send(boost::asio::null_buffers(),
+                                 bind(&DatagramFace<T, U>::handleSendReady, this,
+                                      boost::asio::placeholders::error, face));
+        return;
+      }
+
+      // the first datagram could not be sent
+      m_sendQueue.pop_front();
+      processErrorCode(boost::system::error_code(errno, boost::system::system_category()));
+      continue;
+    }
+
+    size_t nBytesSent = 0;
+    for (int i = 0; i < nSent; ++i) {
+      nBytesSent += m_sendMsgs[i].msg_len;
+    }
+    NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes in "
+                       << nSent << " datagrams");
+    this->getMutableCounters().getNOutBytes() += nBytesSent;
+    m_sendBatchCounters.add(nSent);
+    m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + nSent);
+  }
+#endif
+
+  // send the rest one by one, e.g., after the face is closed or batching is disabled
+  std::deque<Block> queue;
+  queue.swap(m_sendQueue);
+  if (m_socket.is_open()) {
+    for (const Block& block : queue) {
+      sendBlock(block);
+    }
+  }
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::handleSendReady(const boost::system::error_code& error,
+                                    const shared_ptr<Face>& face)
+{
+  if (error) {
+    m_isFlushPending = false;
+    m_sendQueue.clear();
+    return processErrorCode(error);
+  }
+
+  flushSendQueue(face);
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::startReceive()
+{
+  if (m_batchSize > 1) {
+    // wait until the socket is readable, then receive all available datagrams at once
+    m_socket.async_receive(boost::asio::null_buffers(),
+                           bind(&DatagramFace<T, U>::handleReceiveReady, this,
+                                boost::asio::placeholders::error));
+    return;
+  }
+
+  m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
+                         bind(&DatagramFace<T, U>::handleReceive, this,
+                              boost::asio::placeholders::error,
+                              boost::asio::placeholders::bytes_transferred));
+}
+
 template<class T, class U>
 inline void
 DatagramFace<T, U>::handleReceive(const boost::system::error_code& error,
@@ -211,10 +438,36 @@ DatagramFace<T, U>::handleReceive(const boost::system::error_code& error,
   receiveDatagram(m_inputBuffer, nBytesReceived, error);
 
   if (m_socket.is_open())
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                           bind(&DatagramFace<T, U>::handleReceive, this,
-                                boost::asio::placeholders::error,
-                                boost::asio::placeholders::bytes_transferred));
+    startReceive();
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::handleReceiveReady(const boost::system::error_code& error)
+{
+  if (error) {
+    processErrorCode(error);
+  }
+#ifdef __linux__
+  else if (m_batchSize > 1) {
+    int nReceived = ::recvmmsg(m_socket.native_handle(), m_receiveMsgs.data(), m_batchSize,
+                               MSG_DONTWAIT, nullptr);
+    if (nReceived < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        processErrorCode(boost::system::error_code(errno, boost::system::system_category()));
+    }
+    else if (nReceived > 0) {
+      m_receiveBatchCounters.add(nReceived);
+      for (int i = 0; i < nReceived && m_socket.is_open(); ++i) {
+        receiveDatagram(&m_receiveRing[i * ndn::MAX_NDN_PACKET_SIZE],
+                        m_receiveMsgs[i].msg_len, boost::system::error_code());
+      }
+    }
+  }
+#endif
+
+  if (m_socket.is_open())
+    startReceive();
 }
 
 template<class T, class U>
@@ -38,7 +38,8 @@
 #include <unistd.h>       // for dup()
 
 #if defined(__linux__)
-#include <netpacket/packet.h> // for struct packet_mreq
+#include <linux/filter.h>     // for struct sock_fprog
+#include <linux/if_packet.h>  // for struct packet_mreq
 #include <sys/socket.h>       // for setsockopt()
 #endif
 
@@ -67,6 +68,9 @@ EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
                            const ethernet::Address& address)
   : Face(FaceUri(address), FaceUri::fromDev(interface.name), false, true)
   , m_pcap(nullptr, pcap_close)
+#ifdef NFD_HAVE_PACKET_RING
+  , m_isFlushPending(false)
+#endif
   , m_socket(std::move(socket))
 #if defined(__linux__)
   , m_interfaceIndex(interface.index)
@@ -79,22 +83,27 @@ EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
 #endif
 {
   NFD_LOG_FACE_INFO("Creating face on " << m_interfaceName << "/" << m_srcAddress);
-  pcapInit();
-
-  int fd = pcap_get_selectable_fd(m_pcap.get());
-  if (fd < 0)
-    BOOST_THROW_EXCEPTION(Error("pcap_get_selectable_fd failed"));
-
-  // need to duplicate the fd, otherwise both pcap_close()
-  // and stream_descriptor::close() will try to close the
-  // same fd and one of them will fail
-  m_socket.assign(::dup(fd));
 
   m_interfaceMtu = getInterfaceMtu();
   NFD_LOG_FACE_DEBUG("Interface MTU is: " << m_interfaceMtu);
 
   m_slicer.reset(new ndnlp::Slicer(m_interfaceMtu));
 
+  if (!packetRingInit()) {
+    pcapInit();
+    m_frameBuffer.resize(ethernet::HDR_LEN + std::max<size_t>(m_interfaceMtu,
+                                                              ethernet::MIN_DATA_LEN));
+
+    int fd = pcap_get_selectable_fd(m_pcap.get());
+    if (fd < 0)
+      BOOST_THROW_EXCEPTION(Error("pcap_get_selectable_fd failed"));
+
+    // need to duplicate the fd, otherwise both pcap_close()
+    // and stream_descriptor::close() will try to close the
+    // same fd and one of them will fail
+    m_socket.assign(::dup(fd));
+  }
+
   char filter[100];
   // std::snprintf not found in some environments
   // http://redmine.named-data.net/issues/2299 for more information
@@ -108,9 +117,27 @@ EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
   if (!m_destAddress.isBroadcast() && !joinMulticastGroup())
     {
       NFD_LOG_FACE_WARN("Falling back to promiscuous mode");
+#ifdef NFD_HAVE_PACKET_RING
+      if (m_ring)
+        {
+          packet_mreq mr{};
+          mr.mr_ifindex = m_interfaceIndex;
+          mr.mr_type = PACKET_MR_PROMISC;
+          if (::setsockopt(m_socket.native_handle(), SOL_PACKET,
+                           PACKET_ADD_MEMBERSHIP, &mr, sizeof(mr)) < 0)
+            NFD_LOG_FACE_WARN("setsockopt(PACKET_MR_PROMISC) failed: " << std::strerror(errno));
+        }
+      else
+#endif
       pcap_set_promisc(m_pcap.get(), 1);
     }
 
+#ifdef NFD_HAVE_PACKET_RING
+  // start receiving only after the packet filter is in place
+  if (m_ring)
+    m_ring->bind(m_interfaceIndex, ethernet::ETHERTYPE_NDN);
+#endif
+
   m_socket.async_read_some(boost::asio::null_buffers(),
                            bind(&EthernetFace::handleRead, this,
                                 boost::asio::placeholders::error,
@@ -124,10 +151,7 @@ EthernetFace::sendInterest(const Interest& interest)
 
   this->emitSignal(onSendInterest, interest);
 
-  ndnlp::PacketArray pa = m_slicer->slice(interest.wireEncode());
-  for (const auto& packet : *pa) {
-    sendPacket(packet);
-  }
+  sendPacket(interest.wireEncode());
 }
 
 void
@@ -137,16 +161,13 @@ EthernetFace::sendData(const Data& data)
 
   this->emitSignal(onSendData, data);
 
-  ndnlp::PacketArray pa = m_slicer->slice(data.wireEncode());
-  for (const auto& packet : *pa) {
-    sendPacket(packet);
-  }
+  sendPacket(data.wireEncode());
 }
 
 void
 EthernetFace::close()
 {
-  if (!m_pcap)
+  if (!isOpen())
     return;
 
   NFD_LOG_FACE_INFO("Closing face");
@@ -155,10 +176,29 @@ EthernetFace::close()
   m_socket.cancel(error); // ignore errors
   m_socket.close(error);  // ignore errors
   m_pcap.reset();
+#ifdef NFD_HAVE_PACKET_RING
+  m_ring.reset();
+#endif
 
   fail("Face closed");
 }
 
+bool
+EthernetFace::isPacketRingEnabled() const
+{
+#ifdef NFD_HAVE_PACKET_RING
+  return m_ring != nullptr;
+#else
+  return false;
+#endif
+}
+
+bool
+EthernetFace::isOpen() const
+{
+  return m_pcap != nullptr || isPacketRingEnabled();
+}
+
 void
 EthernetFace::pcapInit()
 {
@@ -186,9 +226,56 @@ EthernetFace::pcapInit()
     NFD_LOG_FACE_WARN("pcap_setdirection failed: " << pcap_geterr(m_pcap.get()));
 }
 
+bool
+EthernetFace::packetRingInit()
+{
+#ifdef NFD_HAVE_PACKET_RING
+  try {
+    m_ring.reset(new PacketRing(ethernet::HDR_LEN + m_interfaceMtu));
+  }
+  catch (const PacketRing::Error& e) {
+    NFD_LOG_FACE_WARN("Cannot create AF_PACKET ring, falling back to libpcap: " << e.what());
+    return false;
+  }
+
+  // the ring owns the socket, stream_descriptor gets a duplicate as with libpcap
+  m_socket.assign(::dup(m_ring->getFd()));
+  return true;
+#else
+  return false;
+#endif
+}
+
 void
 EthernetFace::setPacketFilter(const char* filterString)
 {
+#ifdef NFD_HAVE_PACKET_RING
+  if (m_ring)
+    {
+      // compile with a dead libpcap handle and attach the program to the ring's socket
+      unique_ptr<pcap_t, void(*)(pcap_t*)> pcap(pcap_open_dead(DLT_EN10MB, 65535), pcap_close);
+      if (!pcap)
+        BOOST_THROW_EXCEPTION(Error("pcap_open_dead failed"));
+
+      bpf_program filter;
+      if (pcap_compile(pcap.get(), &filter, filterString, 1, PCAP_NETMASK_UNKNOWN) < 0)
+        BOOST_THROW_EXCEPTION(Error("pcap_compile: " + std::string(pcap_geterr(pcap.get()))));
+
+      // struct bpf_insn and struct sock_filter have the same layout
+      sock_fprog program{};
+      program.len = static_cast<unsigned short>(filter.bf_len);
+      program.filter = reinterpret_cast<sock_filter*>(filter.bf_insns);
+      int ret = ::setsockopt(m_socket.native_handle(), SOL_SOCKET, SO_ATTACH_FILTER,
+                             &program, sizeof(program));
+      int errorNumber = errno;
+      pcap_freecode(&filter);
+      if (ret < 0)
+        BOOST_THROW_EXCEPTION(Error("setsockopt(SO_ATTACH_FILTER): " +
+                                    std::string(std::strerror(errorNumber))));
+      return;
+    }
+#endif
+
   bpf_program filter;
   if (pcap_compile(m_pcap.get(), &filter, filterString, 1, PCAP_NETMASK_UNKNOWN) < 0)
     BOOST_THROW_EXCEPTION(Error("pcap_compile: " + std::string(pcap_geterr(m_pcap.get()))));
@@ -268,61 +355,177 @@ EthernetFace::joinMulticastGroup()
 void
 EthernetFace::sendPacket(const ndn::Block& block)
 {
-  if (!m_pcap)
+  if (!m_slicer->sliceInPlace(block, m_fragments))
+    {
+      // fits in one frame, no NDNLP header is needed
+      return sendFrame(block.wire(), block.size(), nullptr, 0);
+    }
+
+  for (const ndnlp::Fragment& fragment : m_fragments)
+    {
+      sendFrame(fragment.header, fragment.headerSize, fragment.payload, fragment.payloadSize);
+      if (!isOpen())
+        break;
+    }
+}
+
+void
+EthernetFace::sendFrame(const uint8_t* header, size_t headerSize,
+                        const uint8_t* payload, size_t payloadSize)
+{
+  if (!isOpen())
     {
       NFD_LOG_FACE_WARN("Trying to send on closed face");
       return fail("Face closed");
     }
 
-  BOOST_ASSERT(block.size() <= m_interfaceMtu);
+  size_t size = headerSize + payloadSize;
+  BOOST_ASSERT(size <= m_interfaceMtu);
 
-  /// \todo Right now there is no reserve when packet is received, but
-  ///       we should reserve some space at the beginning and at the end
-  ndn::EncodingBuffer buffer(block);
+  // build the frame directly in the TX slot, or in m_frameBuffer for libpcap
+  uint8_t* frame = nullptr;
+#ifdef NFD_HAVE_PACKET_RING
+  if (m_ring)
+    {
+      frame = m_ring->beginSend();
+      if (frame == nullptr)
+        {
+          // all TX slots are taken, wait until the kernel has transmitted them
+          flushPacketRing(true);
+          frame = m_ring->beginSend();
+          if (frame == nullptr)
+            {
+              NFD_LOG_FACE_WARN("TX ring is full, dropping frame");
+              return;
+            }
+        }
+    }
+  else
+#endif
+    {
+      frame = m_frameBuffer.data();
+    }
 
+  static const uint16_t ethertype = htons(ethernet::ETHERTYPE_NDN);
+  uint8_t* end = std::copy(m_destAddress.begin(), m_destAddress.end(), frame);
+  end = std::copy(m_srcAddress.begin(), m_srcAddress.end(), end);
+  end = std::copy_n(reinterpret_cast<const uint8_t*>(&ethertype), ethernet::TYPE_LEN, end);
+  end = std::copy_n(header, headerSize, end);
+  end = std::copy_n(payload, payloadSize, end);
   // pad with zeroes if the payload is too short
-  if (block.size() < ethernet::MIN_DATA_LEN)
+  if (size < ethernet::MIN_DATA_LEN)
+    end = std::fill_n(end, ethernet::MIN_DATA_LEN - size, 0);
+
+#ifdef NFD_HAVE_PACKET_RING
+  if (m_ring)
     {
-      static const uint8_t padding[ethernet::MIN_DATA_LEN] = {};
-      buffer.appendByteArray(padding, ethernet::MIN_DATA_LEN - block.size());
+      m_ring->commitSend(end - frame);
+
+      NFD_LOG_FACE_TRACE("Queued for sending: " << size << " bytes");
+      this->getMutableCounters().getNOutBytes() += size;
+
+      // frames queued while the current event is being processed are sent together
+      if (!m_isFlushPending)
+        {
+          m_isFlushPending = true;
+          getGlobalIoService().post(bind(&EthernetFace::handleFlush, this, shared_from_this()));
+        }
+      return;
     }
-
-  // construct and prepend the ethernet header
-  static uint16_t ethertype = htons(ethernet::ETHERTYPE_NDN);
-  buffer.prependByteArray(reinterpret_cast<const uint8_t*>(&ethertype), ethernet::TYPE_LEN);
-  buffer.prependByteArray(m_srcAddress.data(), m_srcAddress.size());
-  buffer.prependByteArray(m_destAddress.data(), m_destAddress.size());
+#endif
 
   // send the packet
-  int sent = pcap_inject(m_pcap.get(), buffer.buf(), buffer.size());
+  int sent = pcap_inject(m_pcap.get(), frame, end - frame);
   if (sent < 0)
     {
       return fail("pcap_inject: " + std::string(pcap_geterr(m_pcap.get())));
     }
-  else if (static_cast<size_t>(sent) < buffer.size())
+  else if (sent < end - frame)
     {
       return fail("Failed to inject frame");
     }
 
-  NFD_LOG_FACE_TRACE("Successfully sent: " << block.size() << " bytes");
-  this->getMutableCounters().getNOutBytes() += block.size();
+  NFD_LOG_FACE_TRACE("Successfully sent: " << size << " bytes");
+  this->getMutableCounters().getNOutBytes() += size;
+}
+
+#ifdef NFD_HAVE_PACKET_RING
+void
+EthernetFace::flushPacketRing(bool wait)
+{
+  int nFrames = m_ring->flush(wait);
+  if (nFrames < 0)
+    return fail("send: " + std::string(std::strerror(errno)));
+
+  if (nFrames > 0)
+    m_sendBatchCounters.add(nFrames);
 }
 
+void
+EthernetFace::handleFlush(const shared_ptr<Face>& face)
+{
+  m_isFlushPending = false;
+  if (m_ring)
+    flushPacketRing(false);
+}
+#endif
+
 void
 EthernetFace::handleRead(const boost::system::error_code& error, size_t)
 {
-  if (!m_pcap)
+  if (!isOpen())
     return fail("Face closed");
 
   if (error)
     return processErrorCode(error);
 
+#ifdef NFD_HAVE_PACKET_RING
+  if (m_ring)
+    readFromPacketRing();
+  else
+#endif
+  if (!readFromPcap())
+    return;
+
+  // the face may have been closed while processing the received frames
+  if (!isOpen())
+    return;
+
+  m_socket.async_read_some(boost::asio::null_buffers(),
+                           bind(&EthernetFace::handleRead, this,
+                                boost::asio::placeholders::error,
+                                boost::asio::placeholders::bytes_transferred));
+}
+
+#ifdef NFD_HAVE_PACKET_RING
+void
+EthernetFace::readFromPacketRing()
+{
+  size_t nFrames = 0;
+  const uint8_t* frame = nullptr;
+  size_t length = 0;
+  // stop if the face is closed, which destroys the ring
+  while (m_ring && m_ring->receive(frame, length))
+    {
+      ++nFrames;
+      processIncomingFrame(frame, length);
+    }
+
+  if (nFrames > 0)
+    m_receiveBatchCounters.add(nFrames);
+}
+#endif
+
+bool
+EthernetFace::readFromPcap()
+{
   pcap_pkthdr* header;
   const uint8_t* packet;
   int ret = pcap_next_ex(m_pcap.get(), &header, &packet);
   if (ret < 0)
     {
-      return fail("pcap_next_ex: " + std::string(pcap_geterr(m_pcap.get())));
+      fail("pcap_next_ex: " + std::string(pcap_geterr(m_pcap.get())));
+      return false;
     }
   else if (ret == 0)
     {
@@ -348,16 +551,18 @@ EthernetFace::handleRead(const boost::system::error_code& error, size_t)
     }
 #endif
 
-  m_socket.async_read_some(boost::asio::null_buffers(),
-                           bind(&EthernetFace::handleRead, this,
-                                boost::asio::placeholders::error,
-                                boost::asio::placeholders::bytes_transferred));
+  return true;
 }
 
 void
 EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* packet)
 {
-  size_t length = header->caplen;
+  processIncomingFrame(packet, header->caplen);
+}
+
+void
+EthernetFace::processIncomingFrame(const uint8_t* packet, size_t length)
+{
   if (length < ethernet::HDR_LEN + ethernet::MIN_DATA_LEN) {
     NFD_LOG_FACE_WARN("Received frame is too short (" << length << " bytes)");
     return;
@@ -391,6 +596,14 @@ EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* pa
                      << sourceAddress.toString());
   this->getMutableCounters().getNInBytes() += fragmentBlock.size();
 
+  if (fragmentBlock.type() != tlv::NdnlpData) {
+    // the sender does not use NDNLP for packets that fit in one frame
+    if (!decodeAndDispatchInput(fragmentBlock))
+      NFD_LOG_FACE_WARN("Received unrecognized TLV block of type " << fragmentBlock.type()
+                        << " from " << sourceAddress.toString());
+    return;
+  }
+
   Reassembler& reassembler = m_reassemblers[sourceAddress];
   if (!reassembler.pms) {
     // new sender, setup a PartialMessageStore for it
@@ -444,14 +657,11 @@ size_t
 EthernetFace::getInterfaceMtu()
 {
 #ifdef SIOCGIFMTU
-#if defined(__APPLE__) || defined(__FreeBSD__)
-  // see bug #2328
+  // the capture socket cannot be used on OS X and FreeBSD (see bug #2328),
+  // and it is not open yet when the MTU is needed to size the AF_PACKET ring
   using boost::asio::ip::udp;
-  udp::socket sock(ref(getGlobalIoService()), udp::v4());
+  udp::socket sock(getGlobalIoService(), udp::v4());
   int fd = sock.native_handle();
-#else
-  int fd = m_socket.native_handle();
-#endif
 
   ifreq ifr{};
   std::strncpy(ifr.ifr_name, m_interfaceName.c_str(), sizeof(ifr.ifr_name) - 1);
@@ -28,9 +28,11 @@
 
 #include "common.hpp"
 #include "face.hpp"
+#include "ethernet-packet-ring.hpp"
 #include "ndnlp-partial-message-store.hpp"
 #include "ndnlp-slicer.hpp"
 #include "core/network-interface.hpp"
+#include "core/scheduler.hpp"
 
 #include <unordered_map>
 
@@ -48,6 +50,11 @@ namespace nfd {
 /**
  * @brief Implementation of Face abstraction that uses raw
  *        Ethernet frames as underlying transport mechanism
+ *
+ * On Linux, frames are received and sent through the memory-mapped rings of an
+ * AF_PACKET socket (see PacketRing), so that all frames available at a wakeup are
+ * processed together and all frames sent during an event are transmitted with one
+ * system call. libpcap is used where the rings are not available.
  */
 class EthernetFace : public Face
 {
@@ -80,6 +87,24 @@ public:
   void
   close() DECL_OVERRIDE;
 
+  /**
+   * @brief Returns whether frames go through an AF_PACKET ring instead of libpcap
+   */
+  bool
+  isPacketRingEnabled() const;
+
+  const BatchCounters&
+  getReceiveBatchCounters() const
+  {
+    return m_receiveBatchCounters;
+  }
+
+  const BatchCounters&
+  getSendBatchCounters() const
+  {
+    return m_sendBatchCounters;
+  }
+
 private:
   /**
    * @brief Allocates and initializes a libpcap context for live capture
@@ -87,6 +112,17 @@ private:
   void
   pcapInit();
 
+  /**
+   * @brief Creates the AF_PACKET ring, if supported
+   *
+   * @return true if successful, false if libpcap should be used instead
+   */
+  bool
+  packetRingInit();
+
+  bool
+  isOpen() const;
+
   /**
    * @brief Installs a BPF filter on the receiving socket
    *
@@ -104,17 +140,52 @@ private:
   joinMulticastGroup();
 
   /**
-   * @brief Sends the specified TLV block on the network wrapped in an Ethernet frame
+   * @brief Sends the specified TLV block on the network wrapped in Ethernet frames
+   *
+   * The block is sent as is if it fits in the MTU, otherwise it is sliced into
+   * NDNLP fragments that refer to its wire encoding.
    */
   void
   sendPacket(const ndn::Block& block);
 
+  /**
+   * @brief Sends one Ethernet frame whose payload is @p header followed by @p payload
+   */
+  void
+  sendFrame(const uint8_t* header, size_t headerSize,
+            const uint8_t* payload, size_t payloadSize);
+
   /**
    * @brief Receive callback
    */
   void
   handleRead(const boost::system::error_code& error, size_t nBytesRead);
 
+  /**
+   * @brief Reads one frame with libpcap
+   *
+   * @return false if the face has failed
+   */
+  bool
+  readFromPcap();
+
+#ifdef NFD_HAVE_PACKET_RING
+  /**
+   * @brief Reads all frames available in the RX ring
+   */
+  void
+  readFromPacketRing();
+
+  /**
+   * @brief Transmits the frames queued in the TX ring
+   */
+  void
+  flushPacketRing(bool wait);
+
+  void
+  handleFlush(const shared_ptr<Face>& face);
+#endif
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /**
    * @brief Processes an incoming frame as captured by libpcap
@@ -125,6 +196,15 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   processIncomingPacket(const pcap_pkthdr* header, const uint8_t* packet);
 
+  /**
+   * @brief Processes an incoming frame
+   *
+   * @param frame pointer to the received frame, including the link-layer header
+   * @param length length of the frame
+   */
+  void
+  processIncomingFrame(const uint8_t* frame, size_t length);
+
 private:
   /**
    * @brief Handles errors encountered by Boost.Asio on the receive path
@@ -146,6 +226,10 @@ private:
   };
 
   unique_ptr<pcap_t, void(*)(pcap_t*)> m_pcap;
+#ifdef NFD_HAVE_PACKET_RING
+  unique_ptr<PacketRing> m_ring;
+  bool m_isFlushPending;
+#endif
   boost::asio::posix::stream_descriptor m_socket;
 
 #if defined(__linux__)
@@ -157,9 +241,14 @@ private:
 
   size_t m_interfaceMtu;
   unique_ptr<ndnlp::Slicer> m_slicer;
+  ndnlp::FragmentArray m_fragments;
+  std::vector<uint8_t> m_frameBuffer; ///< frame being sent with libpcap
   std::unordered_map<ethernet::Address, Reassembler> m_reassemblers;
   static const time::nanoseconds REASSEMBLER_LIFETIME;
 
+  BatchCounters m_receiveBatchCounters;
+  BatchCounters m_sendBatchCounters;
+
 #ifdef _DEBUG
   /// number of packets dropped by the kernel, as reported by libpcap
   unsigned int m_nDropped;
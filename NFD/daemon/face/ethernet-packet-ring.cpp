@@ -0,0 +1,246 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ethernet-packet-ring.hpp"
+
+#ifdef NFD_HAVE_PACKET_RING
+
+#include <algorithm>      // for std::max()
+#include <atomic>         // for std::atomic_thread_fence()
+#include <cerrno>         // for errno
+#include <cstring>        // for std::strerror()
+#include <arpa/inet.h>    // for htons()
+#include <sys/mman.h>     // for mmap() and munmap()
+#include <sys/socket.h>   // for socket() and setsockopt()
+#include <unistd.h>       // for close() and sysconf()
+
+namespace nfd {
+
+/// size of an RX block, in which the kernel batches frames between wakeups
+static const size_t RX_BLOCK_SIZE = 1 << 18;
+/// total size of the RX ring
+static const size_t RX_RING_SIZE = 1 << 21;
+/// maximum time (milliseconds) a partially filled RX block is held back by the kernel
+static const unsigned int RX_BLOCK_TIMEOUT = 1;
+/// size of a TX block
+static const size_t TX_BLOCK_SIZE = 1 << 16;
+/// total size of the TX ring
+static const size_t TX_RING_SIZE = 1 << 20;
+/// minimum number of frames in the TX ring
+static const size_t MIN_TX_FRAMES = 16;
+
+static std::string
+errnoMessage(const std::string& call)
+{
+  return call + ": " + std::strerror(errno);
+}
+
+PacketRingMemory::PacketRingMemory(size_t maxFrameLength, size_t pageSize)
+  : m_nTxQueued(0)
+  , m_rxRing(nullptr)
+  , m_rxBlock(0)
+  , m_nRxFramesLeft(0)
+  , m_rxFrame(nullptr)
+  , m_txRing(nullptr)
+  , m_txFrame(0)
+{
+  // frame slots are powers of two, so that they evenly divide the blocks
+  m_txDataOffset = TPACKET_ALIGN(sizeof(tpacket3_hdr));
+  m_frameSize = TPACKET_ALIGNMENT;
+  while (m_frameSize < m_txDataOffset + maxFrameLength) {
+    m_frameSize *= 2;
+  }
+
+  m_rxBlockSize = std::max({RX_BLOCK_SIZE, m_frameSize, pageSize});
+  m_nRxBlocks = std::max<size_t>(RX_RING_SIZE / m_rxBlockSize, 2);
+
+  m_txBlockSize = std::max({TX_BLOCK_SIZE, m_frameSize, pageSize});
+  size_t nTxFramesPerBlock = m_txBlockSize / m_frameSize;
+  size_t nTxFrames = std::max(TX_RING_SIZE / m_frameSize, MIN_TX_FRAMES);
+  m_nTxBlocks = (nTxFrames + nTxFramesPerBlock - 1) / nTxFramesPerBlock;
+  m_nTxFrames = m_nTxBlocks * nTxFramesPerBlock;
+}
+
+void
+PacketRingMemory::attach(uint8_t* rings)
+{
+  m_rxRing = rings;
+  m_txRing = rings + m_rxBlockSize * m_nRxBlocks;
+}
+
+bool
+PacketRingMemory::receive(const uint8_t*& frame, size_t& frameLength)
+{
+  while (m_nRxFramesLeft == 0) {
+    // all frames of the current block have been returned
+    if (m_rxFrame != nullptr)
+      releaseRxBlock();
+
+    auto block = reinterpret_cast<tpacket_block_desc*>(m_rxRing + m_rxBlock * m_rxBlockSize);
+    if ((block->hdr.bh1.block_status & TP_STATUS_USER) == 0)
+      return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    m_nRxFramesLeft = block->hdr.bh1.num_pkts;
+    m_rxFrame = reinterpret_cast<tpacket3_hdr*>(reinterpret_cast<uint8_t*>(block) +
+                                                block->hdr.bh1.offset_to_first_pkt);
+  }
+
+  frame = reinterpret_cast<const uint8_t*>(m_rxFrame) + m_rxFrame->tp_mac;
+  frameLength = m_rxFrame->tp_snaplen;
+  m_rxFrame = reinterpret_cast<tpacket3_hdr*>(reinterpret_cast<uint8_t*>(m_rxFrame) +
+                                              m_rxFrame->tp_next_offset);
+  --m_nRxFramesLeft;
+  return true;
+}
+
+void
+PacketRingMemory::releaseRxBlock()
+{
+  auto block = reinterpret_cast<tpacket_block_desc*>(m_rxRing + m_rxBlock * m_rxBlockSize);
+  std::atomic_thread_fence(std::memory_order_release);
+  block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+
+  m_rxBlock = (m_rxBlock + 1) % m_nRxBlocks;
+  m_rxFrame = nullptr;
+}
+
+uint8_t*
+PacketRingMemory::beginSend()
+{
+  auto header = reinterpret_cast<tpacket3_hdr*>(m_txRing + m_txFrame * m_frameSize);
+  if ((header->tp_status & (TP_STATUS_SEND_REQUEST | TP_STATUS_SENDING)) != 0)
+    return nullptr;
+  std::atomic_thread_fence(std::memory_order_acquire);
+
+  return reinterpret_cast<uint8_t*>(header) + m_txDataOffset;
+}
+
+void
+PacketRingMemory::commitSend(size_t frameLength)
+{
+  BOOST_ASSERT(frameLength <= getMaxFrameLength());
+
+  auto header = reinterpret_cast<tpacket3_hdr*>(m_txRing + m_txFrame * m_frameSize);
+  header->tp_len = frameLength;
+  header->tp_next_offset = 0;
+  std::atomic_thread_fence(std::memory_order_release);
+  header->tp_status = TP_STATUS_SEND_REQUEST;
+
+  m_txFrame = (m_txFrame + 1) % m_nTxFrames;
+  ++m_nTxQueued;
+}
+
+PacketRing::PacketRing(size_t maxFrameLength)
+  : PacketRingMemory(maxFrameLength, static_cast<size_t>(::sysconf(_SC_PAGESIZE)))
+  , m_fd(-1)
+  , m_map(static_cast<uint8_t*>(MAP_FAILED))
+{
+  // protocol 0: nothing is received until bind()
+  m_fd = ::socket(AF_PACKET, SOCK_RAW, 0);
+  if (m_fd < 0)
+    BOOST_THROW_EXCEPTION(Error(errnoMessage("socket(AF_PACKET)")));
+
+  try {
+    int version = TPACKET_V3;
+    if (::setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+      BOOST_THROW_EXCEPTION(Error(errnoMessage("setsockopt(PACKET_VERSION)")));
+
+    // discard malformed TX frames instead of stopping transmission
+    int loss = 1;
+    if (::setsockopt(m_fd, SOL_PACKET, PACKET_LOSS, &loss, sizeof(loss)) < 0)
+      BOOST_THROW_EXCEPTION(Error(errnoMessage("setsockopt(PACKET_LOSS)")));
+
+#ifdef PACKET_IGNORE_OUTGOING
+    // not fatal: the packet filter can drop frames sent by this host
+    int ignoreOutgoing = 1;
+    ::setsockopt(m_fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &ignoreOutgoing, sizeof(ignoreOutgoing));
+#endif
+
+    tpacket_req3 rxReq{};
+    rxReq.tp_block_size = getRxBlockSize();
+    rxReq.tp_block_nr = getNRxBlocks();
+    rxReq.tp_frame_size = getFrameSize();
+    rxReq.tp_frame_nr = getRxBlockSize() / getFrameSize() * getNRxBlocks();
+    rxReq.tp_retire_blk_tov = RX_BLOCK_TIMEOUT;
+    if (::setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0)
+      BOOST_THROW_EXCEPTION(Error(errnoMessage("setsockopt(PACKET_RX_RING)")));
+
+    tpacket_req3 txReq{};
+    txReq.tp_block_size = getTxBlockSize();
+    txReq.tp_block_nr = getNTxBlocks();
+    txReq.tp_frame_size = getFrameSize();
+    txReq.tp_frame_nr = getNTxFrames();
+    if (::setsockopt(m_fd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) < 0)
+      BOOST_THROW_EXCEPTION(Error(errnoMessage("setsockopt(PACKET_TX_RING)")));
+
+    // the TX ring is mapped right after the RX ring
+    m_map = static_cast<uint8_t*>(::mmap(nullptr, getRingsSize(), PROT_READ | PROT_WRITE,
+                                         MAP_SHARED, m_fd, 0));
+    if (m_map == MAP_FAILED)
+      BOOST_THROW_EXCEPTION(Error(errnoMessage("mmap")));
+    attach(m_map);
+  }
+  catch (const Error&) {
+    ::close(m_fd);
+    throw;
+  }
+}
+
+PacketRing::~PacketRing()
+{
+  if (m_map != MAP_FAILED)
+    ::munmap(m_map, getRingsSize());
+  ::close(m_fd);
+}
+
+void
+PacketRing::bind(int ifIndex, uint16_t ethertype)
+{
+  sockaddr_ll sll{};
+  sll.sll_family = AF_PACKET;
+  sll.sll_protocol = htons(ethertype);
+  sll.sll_ifindex = ifIndex;
+  if (::bind(m_fd, reinterpret_cast<sockaddr*>(&sll), sizeof(sll)) < 0)
+    BOOST_THROW_EXCEPTION(Error(errnoMessage("bind")));
+}
+
+int
+PacketRing::flush(bool wait)
+{
+  int nQueued = static_cast<int>(m_nTxQueued);
+  if (nQueued == 0 && !wait)
+    return 0;
+
+  if (::send(m_fd, nullptr, 0, wait ? 0 : MSG_DONTWAIT) < 0 &&
+      errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOBUFS)
+    return -1;
+
+  m_nTxQueued = 0;
+  return nQueued;
+}
+
+} // namespace nfd
+
+#endif // NFD_HAVE_PACKET_RING
@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+#define NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+
+#include "common.hpp"
+
+#if defined(__linux__)
+#include <linux/if_packet.h>
+#endif
+
+#if defined(__linux__) && defined(TPACKET3_HDRLEN)
+#define NFD_HAVE_PACKET_RING 1
+
+namespace nfd {
+
+/**
+ * \brief RX and TX rings of a Linux AF_PACKET socket (TPACKET_V3), as memory
+ *
+ * This class lays out the rings and walks their blocks and frame slots, which are exchanged
+ * with the kernel through the status field of each block or slot. It neither owns the memory
+ * nor uses the socket, so that PacketRing can map the rings of a socket while the indexing
+ * works on any memory of getRingsSize() octets.
+ */
+class PacketRingMemory : noncopyable
+{
+public:
+  /**
+   * \brief Computes the layout of the rings
+   * \param maxFrameLength length of the largest frame, including the link-layer header
+   * \param pageSize size of a memory page, the minimum size of a block
+   */
+  PacketRingMemory(size_t maxFrameLength, size_t pageSize);
+
+  /**
+   * \brief Starts using \p rings, which holds the RX ring followed by the TX ring
+   * \param rings getRingsSize() octets whose RX block and TX slot status fields are zero
+   */
+  void
+  attach(uint8_t* rings);
+
+  /**
+   * \brief Gets the next received frame
+   *
+   * The frame is valid until the next call. An RX block is given back to the kernel
+   * on the call after its last frame was returned, so call this until it returns false;
+   * otherwise the socket stays readable.
+   *
+   * \return false if no more frames have been received
+   */
+  bool
+  receive(const uint8_t*& frame, size_t& frameLength);
+
+  /**
+   * \brief Gets a free slot in the TX ring
+   * \return pointer to getMaxFrameLength() octets of frame buffer,
+   *         or nullptr if all slots are waiting to be transmitted
+   */
+  uint8_t*
+  beginSend();
+
+  /**
+   * \brief Queues the frame written into the slot returned by beginSend()
+   */
+  void
+  commitSend(size_t frameLength);
+
+  size_t
+  getMaxFrameLength() const
+  {
+    return m_frameSize - m_txDataOffset;
+  }
+
+  size_t
+  getFrameSize() const
+  {
+    return m_frameSize;
+  }
+
+  size_t
+  getRxBlockSize() const
+  {
+    return m_rxBlockSize;
+  }
+
+  size_t
+  getNRxBlocks() const
+  {
+    return m_nRxBlocks;
+  }
+
+  size_t
+  getTxBlockSize() const
+  {
+    return m_txBlockSize;
+  }
+
+  size_t
+  getNTxBlocks() const
+  {
+    return m_nTxBlocks;
+  }
+
+  size_t
+  getNTxFrames() const
+  {
+    return m_nTxFrames;
+  }
+
+  size_t
+  getRingsSize() const
+  {
+    return m_rxBlockSize * m_nRxBlocks + m_txBlockSize * m_nTxBlocks;
+  }
+
+private:
+  void
+  releaseRxBlock();
+
+protected:
+  size_t m_nTxQueued;        ///< frames committed since the last flush
+
+private:
+  uint8_t* m_rxRing;
+  size_t m_rxBlockSize;
+  size_t m_nRxBlocks;
+  size_t m_rxBlock;          ///< index of the block being read
+  size_t m_nRxFramesLeft;    ///< frames in the current block that have not been read
+  tpacket3_hdr* m_rxFrame;   ///< next frame to read in the current block
+
+  uint8_t* m_txRing;
+  size_t m_frameSize;
+  size_t m_txDataOffset;
+  size_t m_txBlockSize;
+  size_t m_nTxBlocks;
+  size_t m_nTxFrames;
+  size_t m_txFrame;          ///< index of the next slot to fill
+};
+
+/**
+ * \brief Memory-mapped RX and TX rings of a Linux AF_PACKET socket (TPACKET_V3)
+ *
+ * The kernel places received frames into blocks of the RX ring and hands a block over
+ * when it is full or when its retire timeout expires, so that all frames that arrived
+ * since the last wakeup are read without a system call per frame. Frames to send are
+ * written into slots of the TX ring and transmitted together by flush().
+ *
+ * The socket is created unbound so that no frame is queued before a packet filter is
+ * attached; call bind() to start receiving.
+ */
+class PacketRing : public PacketRingMemory
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * \brief Creates the socket and maps the rings
+   * \param maxFrameLength length of the largest frame, including the link-layer header
+   * \throw Error the kernel does not support TPACKET_V3 rings, or the caller lacks CAP_NET_RAW
+   */
+  explicit
+  PacketRing(size_t maxFrameLength);
+
+  ~PacketRing();
+
+  int
+  getFd() const
+  {
+    return m_fd;
+  }
+
+  /**
+   * \brief Starts receiving frames of \p ethertype on interface \p ifIndex
+   * \throw Error
+   */
+  void
+  bind(int ifIndex, uint16_t ethertype);
+
+  /**
+   * \brief Asks the kernel to transmit all queued frames
+   * \param wait whether to block until the frames have been transmitted
+   * \return number of queued frames, or -1 on error with errno set
+   */
+  int
+  flush(bool wait = false);
+
+private:
+  int m_fd;
+  uint8_t* m_map;
+};
+
+} // namespace nfd
+
+#endif // defined(__linux__) && defined(TPACKET3_HDRLEN)
+
+#endif // NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
@@ -28,6 +28,8 @@
 
 #include "common.hpp"
 
+#include <array>
+
 namespace nfd {
 
 /** \brief represents a counter of number of packets
@@ -229,6 +231,83 @@ private:
   ByteCounter m_nOutBytes;
 };
 
+/** \brief contains counters of batched I/O operations
+ *
+ *  A face that sends or receives several packets with one I/O operation
+ *  (e.g., a scatter-gather write) counts each such operation as a batch.
+ */
+class BatchCounters : noncopyable
+{
+public:
+  /** \brief number of histogram buckets
+   *
+   *  Bucket i counts batches of [2^i, 2^(i+1)) packets; the last bucket counts
+   *  all batches of 2^(N_BUCKETS-1) or more packets.
+   */
+  static const size_t N_BUCKETS = 8;
+
+  BatchCounters()
+    : m_nBatches(0)
+    , m_nPackets(0)
+    , m_maxBatchSize(0)
+    , m_histogram()
+  {
+  }
+
+  /** \brief record a batch of \p nPackets packets
+   */
+  void
+  add(size_t nPackets)
+  {
+    BOOST_ASSERT(nPackets > 0);
+    ++m_nBatches;
+    m_nPackets += nPackets;
+    m_maxBatchSize = std::max<uint64_t>(m_maxBatchSize, nPackets);
+
+    size_t bucket = 0;
+    while (nPackets > 1 && bucket < N_BUCKETS - 1) {
+      nPackets >>= 1;
+      ++bucket;
+    }
+    ++m_histogram[bucket];
+  }
+
+  /// number of I/O operations
+  uint64_t
+  getNBatches() const
+  {
+    return m_nBatches;
+  }
+
+  /// number of packets in all batches
+  uint64_t
+  getNPackets() const
+  {
+    return m_nPackets;
+  }
+
+  /// largest number of packets in one batch
+  uint64_t
+  getMaxBatchSize() const
+  {
+    return m_maxBatchSize;
+  }
+
+  /// number of batches in histogram bucket \p bucket
+  uint64_t
+  getNBatchesInBucket(size_t bucket) const
+  {
+    BOOST_ASSERT(bucket < N_BUCKETS);
+    return m_histogram[bucket];
+  }
+
+private:
+  uint64_t m_nBatches;
+  uint64_t m_nPackets;
+  uint64_t m_maxBatchSize;
+  std::array<uint64_t, N_BUCKETS> m_histogram;
+};
+
 /** \brief contains counters on face
  */
 class FaceCounters : public NetworkLayerCounters, public LinkLayerCounters
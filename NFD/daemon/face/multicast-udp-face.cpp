@@ -38,6 +38,7 @@ MulticastUdpFace::MulticastUdpFace(const protocol::endpoint& multicastGroup,
   , m_multicastGroup(multicastGroup)
   , m_sendSocket(std::move(sendSocket))
 {
+  setSendSocket(m_sendSocket, m_multicastGroup);
 }
 
 const MulticastUdpFace::protocol::endpoint&
@@ -64,14 +65,4 @@ MulticastUdpFace::sendData(const Data& data)
   sendBlock(data.wireEncode());
 }
 
-void
-MulticastUdpFace::sendBlock(const Block& block)
-{
-  m_sendSocket.async_send_to(boost::asio::buffer(block.wire(), block.size()), m_multicastGroup,
-                             bind(&MulticastUdpFace::handleSend, this,
-                                  boost::asio::placeholders::error,
-                                  boost::asio::placeholders::bytes_transferred,
-                                  block));
-}
-
 } // namespace nfd
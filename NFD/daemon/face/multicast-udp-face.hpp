@@ -53,10 +53,6 @@ public:
   void
   sendData(const Data& data) DECL_OVERRIDE;
 
-private:
-  void
-  sendBlock(const Block& block);
-
 private:
   protocol::endpoint m_multicastGroup;
   protocol::socket m_sendSocket;
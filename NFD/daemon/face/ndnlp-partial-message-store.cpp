@@ -32,34 +32,105 @@ namespace ndnlp {
 NFD_LOG_INIT("NdnlpPartialMessageStore");
 
 PartialMessage::PartialMessage()
-  : m_fragCount(0)
+  : m_messageIdentifier(0)
+  , m_fragCount(0)
   , m_received(0)
+  , m_fragSize(0)
   , m_totalLength(0)
 {
 }
 
+void
+PartialMessage::start(uint64_t messageIdentifier, uint16_t fragCount)
+{
+  m_messageIdentifier = messageIdentifier;
+  m_fragCount = fragCount;
+  m_received = 0;
+  m_hasFragment.assign(fragCount, false); // reuses the capacity of earlier messages
+  m_fragSize = 0;
+  m_totalLength = 0;
+  m_buffer.reset();
+  m_lastFragment = Block();
+}
+
+void
+PartialMessage::clear()
+{
+  m_fragCount = 0;
+  m_buffer.reset();
+  m_lastFragment = Block();
+}
+
 bool
 PartialMessage::add(uint16_t fragIndex, uint16_t fragCount, const Block& payload)
 {
-  if (m_received == 0) { // first packet
-    m_fragCount = fragCount;
-    m_payloads.resize(fragCount);
-  }
-
   if (m_fragCount != fragCount || fragIndex >= m_fragCount) {
     return false;
   }
 
-  if (!m_payloads[fragIndex].empty()) { // duplicate
+  if (m_hasFragment[fragIndex]) { // duplicate
     return false;
   }
 
-  m_payloads[fragIndex] = payload;
+  size_t payloadSize = payload.value_size();
+  size_t lastIndex = m_fragCount - 1;
+  if (fragIndex == lastIndex) {
+    if (m_fragSize == 0) { // offset not known yet
+      m_lastFragment = payload;
+    }
+    else if (payloadSize > m_fragSize) {
+      return false;
+    }
+    else {
+      std::copy(payload.value_begin(), payload.value_end(),
+                m_buffer->begin() + lastIndex * m_fragSize);
+      m_totalLength = lastIndex * m_fragSize + payloadSize;
+    }
+  }
+  else {
+    if (m_fragSize == 0) {
+      // the reassembled packet cannot be larger than MAX_NDN_PACKET_SIZE
+      if (payloadSize == 0 || lastIndex * payloadSize > ndn::MAX_NDN_PACKET_SIZE) {
+        return false;
+      }
+      m_fragSize = payloadSize;
+      m_buffer = make_shared<ndn::Buffer>(m_fragCount * m_fragSize);
+      this->placeLastFragment();
+    }
+    else if (payloadSize != m_fragSize) {
+      return false;
+    }
+
+    std::copy(payload.value_begin(), payload.value_end(),
+              m_buffer->begin() + fragIndex * m_fragSize);
+  }
+
+  m_hasFragment[fragIndex] = true;
   ++m_received;
-  m_totalLength += payload.value_size();
   return true;
 }
 
+void
+PartialMessage::placeLastFragment()
+{
+  if (m_lastFragment.empty()) {
+    return;
+  }
+
+  size_t lastIndex = m_fragCount - 1;
+  if (m_lastFragment.value_size() > m_fragSize) {
+    // inconsistent with the other fragments, wait for a retransmission
+    m_hasFragment[lastIndex] = false;
+    --m_received;
+  }
+  else {
+    std::copy(m_lastFragment.value_begin(), m_lastFragment.value_end(),
+              m_buffer->begin() + lastIndex * m_fragSize);
+    m_totalLength = lastIndex * m_fragSize + m_lastFragment.value_size();
+  }
+  m_lastFragment = Block();
+}
+
 bool
 PartialMessage::isComplete() const
 {
@@ -70,13 +141,11 @@ std::tuple<bool, Block>
 PartialMessage::reassemble()
 {
   BOOST_ASSERT(this->isComplete());
+  BOOST_ASSERT(m_buffer != nullptr);
 
-  ndn::BufferPtr buffer = make_shared<ndn::Buffer>(m_totalLength);
-  ndn::Buffer::iterator buf = buffer->begin();
-  for (const Block& payload : m_payloads) {
-    buf = std::copy(payload.value_begin(), payload.value_end(), buf);
-  }
-  BOOST_ASSERT(buf == buffer->end());
+  ndn::BufferPtr buffer = std::move(m_buffer);
+  buffer->resize(m_totalLength);
+  this->clear();
 
   return Block::fromBuffer(buffer, 0);
 }
@@ -96,7 +165,14 @@ PartialMessage::reassembleSingle(const NdnlpData& fragment)
 
 PartialMessageStore::PartialMessageStore(const time::nanoseconds& idleDuration)
   : m_idleDuration(idleDuration)
+  , m_nCollisions(0)
+{
+}
+
+PartialMessage&
+PartialMessageStore::getSlot(uint64_t messageIdentifier, uint16_t fragCount)
 {
+  return m_slots[(messageIdentifier / fragCount) % N_SLOTS];
 }
 
 void
@@ -110,14 +186,27 @@ PartialMessageStore::receive(const NdnlpData& pkt)
   }
   else {
     uint64_t messageIdentifier = pkt.seq - pkt.fragIndex;
-    PartialMessage& pm = m_partialMessages[messageIdentifier];
-    this->scheduleCleanup(messageIdentifier, pm);
+    PartialMessage& pm = this->getSlot(messageIdentifier, pkt.fragCount);
+
+    time::steady_clock::TimePoint now = time::steady_clock::now();
+    if (!pm.isInUse() || pm.getMessageIdentifier() != messageIdentifier || pm.expiry <= now) {
+      if (pm.isInUse()) {
+        if (pm.expiry > now) {
+          NFD_LOG_DEBUG(pm.getMessageIdentifier() << " evicted by " << messageIdentifier);
+          ++m_nCollisions;
+        }
+        else {
+          NFD_LOG_TRACE(pm.getMessageIdentifier() << " cleanup");
+        }
+      }
+      pm.start(messageIdentifier, pkt.fragCount);
+    }
+    pm.expiry = now + m_idleDuration;
 
     pm.add(pkt.fragIndex, pkt.fragCount, pkt.payload);
 
     if (pm.isComplete()) {
       std::tie(isReassembled, reassembled) = pm.reassemble();
-      m_partialMessages.erase(messageIdentifier);
     }
     else {
       return;
@@ -133,20 +222,5 @@ PartialMessageStore::receive(const NdnlpData& pkt)
   this->onReceive(reassembled);
 }
 
-void
-PartialMessageStore::scheduleCleanup(uint64_t messageIdentifier,
-                                     PartialMessage& partialMessage)
-{
-  partialMessage.expiry = scheduler::schedule(m_idleDuration,
-    bind(&PartialMessageStore::cleanup, this, messageIdentifier));
-}
-
-void
-PartialMessageStore::cleanup(uint64_t messageIdentifier)
-{
-  NFD_LOG_TRACE(messageIdentifier << " cleanup");
-  m_partialMessages.erase(messageIdentifier);
-}
-
 } // namespace ndnlp
 } // namespace nfd
@@ -27,27 +27,46 @@
 #define NFD_DAEMON_FACE_NDNLP_PARTIAL_MESSAGE_STORE_HPP
 
 #include "ndnlp-data.hpp"
-#include "core/scheduler.hpp"
+
+#include <array>
 
 namespace nfd {
 namespace ndnlp {
 
 /** \brief represents a partially received message
+ *
+ *  Fragment payloads are copied into one buffer at their final offsets as they arrive.
+ *  All fragments except the last carry the same payload size (see Slicer), so the offset
+ *  of a fragment is known once any fragment other than the last has been received.
  */
-class PartialMessage
+class PartialMessage : noncopyable
 {
 public:
   PartialMessage();
 
-  PartialMessage(const PartialMessage&) = delete;
+  /** \brief start reassembling a message of \p fragCount fragments
+   */
+  void
+  start(uint64_t messageIdentifier, uint16_t fragCount);
 
-  PartialMessage&
-  operator=(const PartialMessage&) = delete;
+  /** \brief discard the message and release its buffer
+   */
+  void
+  clear();
 
-  PartialMessage(PartialMessage&&) = default;
+  /** \return whether a message is being reassembled
+   */
+  bool
+  isInUse() const
+  {
+    return m_fragCount > 0;
+  }
 
-  PartialMessage&
-  operator=(PartialMessage&&) = default;
+  uint64_t
+  getMessageIdentifier() const
+  {
+    return m_messageIdentifier;
+  }
 
   bool
   add(uint16_t fragIndex, uint16_t fragCount, const Block& payload);
@@ -58,6 +77,7 @@ public:
   /** \brief reassemble network layer packet
    *  \pre isComplete() == true
    *  \return whether success, network layer packet
+   *  \post the message is cleared
    */
   std::tuple<bool, Block>
   reassemble();
@@ -69,17 +89,36 @@ public:
   static std::tuple<bool, Block>
   reassembleSingle(const NdnlpData& fragment);
 
+private:
+  /** \brief copy the held last fragment into the buffer once its offset is known
+   */
+  void
+  placeLastFragment();
+
 public:
-  scheduler::ScopedEventId expiry;
+  /** \brief the message is discarded if no fragment arrives before this time
+   */
+  time::steady_clock::TimePoint expiry;
 
 private:
+  uint64_t m_messageIdentifier;
   size_t m_fragCount;
   size_t m_received;
-  std::vector<Block> m_payloads;
+  std::vector<bool> m_hasFragment;
+  size_t m_fragSize; ///< payload size of every fragment except the last, 0 if not known yet
   size_t m_totalLength;
+  ndn::BufferPtr m_buffer;
+  Block m_lastFragment; ///< last fragment received before m_fragSize is known
 };
 
 /** \brief provides reassembly feature at receiver
+ *
+ *  Messages are kept in a fixed number of slots indexed by sequence: the message identifier
+ *  divided by the fragment count, modulo N_SLOTS.  Consecutive messages of the same size
+ *  from one sender therefore occupy consecutive slots, and up to N_SLOTS of them can be
+ *  reassembled concurrently.  A message that receives no fragment for the idle duration is
+ *  discarded when its slot is next used.  An incomplete message whose slot is needed by
+ *  another message before that is discarded too, and counted as a collision.
  */
 class PartialMessageStore : noncopyable
 {
@@ -98,17 +137,28 @@ public:
    */
   signal::Signal<PartialMessageStore, Block> onReceive;
 
-private:
-  void
-  scheduleCleanup(uint64_t messageIdentifier, PartialMessage& partialMessage);
+  /** \return number of incomplete messages discarded because their slot was needed
+   *          by another message before the idle duration elapsed
+   */
+  size_t
+  getNCollisions() const
+  {
+    return m_nCollisions;
+  }
 
-  void
-  cleanup(uint64_t messageIdentifier);
+  /** \brief number of messages that can be reassembled concurrently
+   */
+  static const size_t N_SLOTS = 64;
+
+private:
+  PartialMessage&
+  getSlot(uint64_t messageIdentifier, uint16_t fragCount);
 
 private:
-  std::unordered_map<uint64_t, PartialMessage> m_partialMessages;
+  std::array<PartialMessage, N_SLOTS> m_slots;
 
   time::nanoseconds m_idleDuration;
+  size_t m_nCollisions;
 };
 
 } // namespace ndnlp
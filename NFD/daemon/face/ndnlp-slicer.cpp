@@ -131,5 +131,103 @@ Slicer::slice(const Block& block)
   return pa;
 }
 
+static uint8_t*
+writeVarNumber(uint8_t* p, uint64_t number)
+{
+  if (number < 253) {
+    *p++ = static_cast<uint8_t>(number);
+  }
+  else if (number <= std::numeric_limits<uint16_t>::max()) {
+    *p++ = 253;
+    uint16_t value = htobe16(static_cast<uint16_t>(number));
+    p = std::copy_n(reinterpret_cast<const uint8_t*>(&value), sizeof(value), p);
+  }
+  else if (number <= std::numeric_limits<uint32_t>::max()) {
+    *p++ = 254;
+    uint32_t value = htobe32(static_cast<uint32_t>(number));
+    p = std::copy_n(reinterpret_cast<const uint8_t*>(&value), sizeof(value), p);
+  }
+  else {
+    *p++ = 255;
+    uint64_t value = htobe64(number);
+    p = std::copy_n(reinterpret_cast<const uint8_t*>(&value), sizeof(value), p);
+  }
+  return p;
+}
+
+/** \brief write a TLV element of \p type whose value is a 1- or 2-octet NonNegativeInteger
+ */
+static uint8_t*
+writeUint16Element(uint8_t* p, uint32_t type, uint16_t number)
+{
+  p = writeVarNumber(p, type);
+  if (number <= std::numeric_limits<uint8_t>::max()) {
+    *p++ = 1;
+    *p++ = static_cast<uint8_t>(number);
+  }
+  else {
+    *p++ = 2;
+    uint16_t value = htobe16(number);
+    p = std::copy_n(reinterpret_cast<const uint8_t*>(&value), sizeof(value), p);
+  }
+  return p;
+}
+
+bool
+Slicer::sliceInPlace(const Block& block, FragmentArray& fragments)
+{
+  BOOST_ASSERT(block.hasWire());
+  fragments.clear();
+
+  const uint8_t* networkPacket = block.wire();
+  size_t networkPacketSize = block.size();
+  if (networkPacketSize <= m_mtu) {
+    return false;
+  }
+
+  uint16_t fragCount = static_cast<uint16_t>(
+                         (networkPacketSize / m_maxPayload) +
+                         (networkPacketSize % m_maxPayload == 0 ? 0 : 1)
+                       );
+  fragments.resize(fragCount);
+  SequenceBlock seqBlock = m_seqgen.nextBlock(fragCount);
+
+  for (uint16_t fragIndex = 0; fragIndex < fragCount; ++fragIndex) {
+    size_t payloadOffset = fragIndex * m_maxPayload;
+    Fragment& fragment = fragments[fragIndex];
+    fragment.payload = networkPacket + payloadOffset;
+    fragment.payloadSize = std::min(m_maxPayload, networkPacketSize - payloadOffset);
+
+    // same fields as encodeFragment, written front to back up to NdnlpPayload TLV-VALUE
+    size_t sequenceSize = 1 + 1 + sizeof(uint64_t);
+    size_t fragIndexSize = 1 + 1 + ndn::tlv::sizeOfNonNegativeInteger(fragIndex);
+    size_t fragCountSize = 1 + 1 + ndn::tlv::sizeOfNonNegativeInteger(fragCount);
+    size_t payloadHeaderSize = 1 + ndn::tlv::sizeOfVarNumber(fragment.payloadSize);
+    size_t dataLength = sequenceSize + fragIndexSize + fragCountSize +
+                        payloadHeaderSize + fragment.payloadSize;
+
+    uint8_t* p = fragment.header;
+    p = writeVarNumber(p, tlv::NdnlpData);
+    p = writeVarNumber(p, dataLength);
+
+    p = writeVarNumber(p, tlv::NdnlpSequence);
+    p = writeVarNumber(p, sizeof(uint64_t));
+    uint64_t sequenceBE = htobe64(seqBlock[fragIndex]);
+    p = std::copy_n(reinterpret_cast<const uint8_t*>(&sequenceBE), sizeof(sequenceBE), p);
+
+    p = writeUint16Element(p, tlv::NdnlpFragIndex, fragIndex);
+    p = writeUint16Element(p, tlv::NdnlpFragCount, fragCount);
+
+    p = writeVarNumber(p, tlv::NdnlpPayload);
+    p = writeVarNumber(p, fragment.payloadSize);
+
+    fragment.headerSize = p - fragment.header;
+    BOOST_ASSERT(fragment.headerSize <= Fragment::MAX_HEADER_SIZE);
+    BOOST_VERIFY(fragment.headerSize + fragment.payloadSize <= m_mtu);
+  }
+
+  return true;
+}
+
 } // namespace ndnlp
 } // namespace nfd
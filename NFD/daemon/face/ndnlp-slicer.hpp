@@ -34,6 +34,24 @@ namespace ndnlp {
 
 typedef shared_ptr<std::vector<Block>> PacketArray;
 
+/** \brief NDNLP packet whose payload refers to a range of the sliced network layer packet
+ *
+ *  The NDNLP packet is header followed by payload, which can be sent as scatter-gather
+ *  buffers. The network layer packet must remain valid while the fragment is in use.
+ */
+struct Fragment
+{
+  /// maximum size of NdnlpData TLV-TYPE and TLV-LENGTH and all header fields
+  static const size_t MAX_HEADER_SIZE = 32;
+
+  uint8_t header[MAX_HEADER_SIZE];
+  size_t headerSize;
+  const uint8_t* payload;
+  size_t payloadSize;
+};
+
+typedef std::vector<Fragment> FragmentArray;
+
 /** \brief provides fragmentation feature at sender
  */
 class Slicer : noncopyable
@@ -52,6 +70,15 @@ public:
   PacketArray
   slice(const Block& block);
 
+  /** \brief slice a network layer packet without copying it
+   *  \param[out] fragments NDNLP packets referring to the wire encoding of \p block;
+   *                        the vector is cleared first, so that its capacity can be reused
+   *  \return false if \p block fits in the MTU, in which case it should be sent as is
+   *          without NDNLP and \p fragments is left empty
+   */
+  bool
+  sliceInPlace(const Block& block, FragmentArray& fragments);
+
 private:
   template<bool T>
   size_t
@@ -30,6 +30,8 @@
 #include "local-face.hpp"
 #include "core/global-io.hpp"
 
+#include <deque>
+
 namespace nfd {
 
 // forward declaration
@@ -41,9 +43,32 @@ class StreamFace : public FaceBase
 public:
   typedef Protocol protocol;
 
+  /** \brief default limit of bytes sent with one write operation
+   */
+  static const size_t DEFAULT_SEND_BATCH_BYTES = 131072;
+
+  /** \brief default limit of packets sent with one write operation
+   *
+   *  Boost.Asio passes at most 64 buffers to one system call.
+   */
+  static const size_t DEFAULT_SEND_BATCH_PACKETS = 64;
+
   StreamFace(const FaceUri& remoteUri, const FaceUri& localUri,
              typename protocol::socket socket, bool isOnDemand);
 
+  /** \brief set limits of a batch of queued packets sent with one write operation
+   *
+   *  At least one packet is always sent, even if it exceeds \p maxBytes.
+   */
+  void
+  setSendBatchLimits(size_t maxBytes, size_t maxPackets);
+
+  const BatchCounters&
+  getSendBatchCounters() const
+  {
+    return m_sendBatchCounters;
+  }
+
   // from FaceBase
   void
   sendInterest(const Interest& interest) DECL_OVERRIDE;
@@ -83,7 +108,13 @@ protected:
 private:
   uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
   size_t m_inputBufferSize;
-  std::queue<Block> m_sendQueue;
+
+  std::deque<Block> m_sendQueue;
+  std::vector<boost::asio::const_buffer> m_sendBuffers; ///< buffers of the write in progress
+  size_t m_nBlocksInFlight; ///< number of Blocks at the front of m_sendQueue being written
+  size_t m_maxSendBatchBytes;
+  size_t m_maxSendBatchPackets;
+  BatchCounters m_sendBatchCounters;
 
   friend struct StreamFaceSenderImpl<Protocol, FaceBase, Interest>;
   friend struct StreamFaceSenderImpl<Protocol, FaceBase, Data>;
@@ -110,6 +141,12 @@ struct StreamFaceValidator
 };
 
 
+template<class T, class U>
+const size_t StreamFace<T, U>::DEFAULT_SEND_BATCH_BYTES;
+
+template<class T, class U>
+const size_t StreamFace<T, U>::DEFAULT_SEND_BATCH_PACKETS;
+
 template<class T, class FaceBase>
 inline
 StreamFace<T, FaceBase>::StreamFace(const FaceUri& remoteUri, const FaceUri& localUri,
@@ -117,6 +154,9 @@ StreamFace<T, FaceBase>::StreamFace(const FaceUri& remoteUri, const FaceUri& loc
   : FaceBase(remoteUri, localUri)
   , m_socket(std::move(socket))
   , m_inputBufferSize(0)
+  , m_nBlocksInFlight(0)
+  , m_maxSendBatchBytes(DEFAULT_SEND_BATCH_BYTES)
+  , m_maxSendBatchPackets(DEFAULT_SEND_BATCH_PACKETS)
 {
   NFD_LOG_FACE_INFO("Creating face");
 
@@ -137,7 +177,7 @@ struct StreamFaceSenderImpl
   send(StreamFace<Protocol, FaceBase>& face, const Packet& packet)
   {
     bool wasQueueEmpty = face.m_sendQueue.empty();
-    face.m_sendQueue.push(packet.wireEncode());
+    face.m_sendQueue.push_back(packet.wireEncode());
 
     if (wasQueueEmpty)
       face.sendFromQueue();
@@ -155,9 +195,9 @@ struct StreamFaceSenderImpl<Protocol, LocalFace, Packet>
 
     if (!face.isEmptyFilteredLocalControlHeader(packet.getLocalControlHeader()))
       {
-        face.m_sendQueue.push(face.filterAndEncodeLocalControlHeader(packet));
+        face.m_sendQueue.push_back(face.filterAndEncodeLocalControlHeader(packet));
       }
-    face.m_sendQueue.push(packet.wireEncode());
+    face.m_sendQueue.push_back(packet.wireEncode());
 
     if (wasQueueEmpty)
       face.sendFromQueue();
@@ -165,6 +205,15 @@ struct StreamFaceSenderImpl<Protocol, LocalFace, Packet>
 };
 
 
+template<class T, class U>
+inline void
+StreamFace<T, U>::setSendBatchLimits(size_t maxBytes, size_t maxPackets)
+{
+  BOOST_ASSERT(maxPackets > 0);
+  m_maxSendBatchBytes = maxBytes;
+  m_maxSendBatchPackets = maxPackets;
+}
+
 template<class T, class U>
 inline void
 StreamFace<T, U>::sendInterest(const Interest& interest)
@@ -225,7 +274,25 @@ template<class T, class U>
 inline void
 StreamFace<T, U>::sendFromQueue()
 {
-  boost::asio::async_write(m_socket, boost::asio::buffer(m_sendQueue.front()),
+  BOOST_ASSERT(!m_sendQueue.empty());
+
+  // Packets queued while the previous write was in progress are sent together
+  // with one scatter-gather write, within the batch limits.
+  m_sendBuffers.clear();
+  size_t nBytes = 0;
+  for (const Block& block : m_sendQueue) {
+    if (!m_sendBuffers.empty() &&
+        (m_sendBuffers.size() >= m_maxSendBatchPackets ||
+         nBytes + block.size() > m_maxSendBatchBytes))
+      break;
+
+    m_sendBuffers.push_back(boost::asio::buffer(block.wire(), block.size()));
+    nBytes += block.size();
+  }
+  m_nBlocksInFlight = m_sendBuffers.size();
+  m_sendBatchCounters.add(m_nBlocksInFlight);
+
+  boost::asio::async_write(m_socket, m_sendBuffers,
                            bind(&StreamFace<T, U>::handleSend, this,
                                 boost::asio::placeholders::error,
                                 boost::asio::placeholders::bytes_transferred));
@@ -239,12 +306,14 @@ StreamFace<T, U>::handleSend(const boost::system::error_code& error,
   if (error)
     return processErrorCode(error);
 
-  BOOST_ASSERT(!m_sendQueue.empty());
+  BOOST_ASSERT(m_nBlocksInFlight > 0 && m_sendQueue.size() >= m_nBlocksInFlight);
 
-  NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
+  NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes in "
+                     << m_nBlocksInFlight << " packets");
   this->getMutableCounters().getNOutBytes() += nBytesSent;
 
-  m_sendQueue.pop();
+  m_sendQueue.erase(m_sendQueue.begin(), m_sendQueue.begin() + m_nBlocksInFlight);
+  m_nBlocksInFlight = 0;
   if (!m_sendQueue.empty())
     sendFromQueue();
 }
@@ -348,8 +417,9 @@ StreamFace<T, U>::deferredClose(const shared_ptr<Face>& face)
   NFD_LOG_FACE_TRACE(__func__);
 
   // clear send queue
-  std::queue<Block> emptyQueue;
+  std::deque<Block> emptyQueue;
   std::swap(emptyQueue, m_sendQueue);
+  m_nBlocksInFlight = 0;
 
   // use the non-throwing variant and ignore errors, if any
   boost::system::error_code error;
@@ -38,6 +38,7 @@ UdpChannel::UdpChannel(const udp::Endpoint& localEndpoint,
   : m_localEndpoint(localEndpoint)
   , m_socket(getGlobalIoService())
   , m_idleFaceTimeout(timeout)
+  , m_faceBatchSize(1)
 {
   setUri(FaceUri(m_localEndpoint));
 }
@@ -93,6 +94,15 @@ UdpChannel::size() const
   return m_channelFaces.size();
 }
 
+void
+UdpChannel::setFaceBatchSize(size_t batchSize)
+{
+  m_faceBatchSize = batchSize;
+  for (const auto& i : m_channelFaces) {
+    i.second->setBatchSize(m_faceBatchSize);
+  }
+}
+
 std::pair<bool, shared_ptr<UdpFace>>
 UdpChannel::createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersistency persistency)
 {
@@ -118,6 +128,7 @@ UdpChannel::createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersis
 
   auto face = make_shared<UdpFace>(FaceUri(remoteEndpoint), FaceUri(m_localEndpoint),
                                    std::move(socket), persistency, m_idleFaceTimeout);
+  face->setBatchSize(m_faceBatchSize);
 
   face->onFail.connectSingleShot([this, remoteEndpoint] (const std::string&) {
     NFD_LOG_TRACE("Erasing " << remoteEndpoint << " from channel face map");
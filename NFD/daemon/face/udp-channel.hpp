@@ -91,6 +91,17 @@ public:
   bool
   isListening() const;
 
+  /**
+   * \brief Set the number of datagrams each face of the channel receives or sends
+   *        with one system call
+   *
+   * The batch size applies to existing faces and to faces created afterwards.
+   *
+   * \see DatagramFace::setBatchSize
+   */
+  void
+  setFaceBatchSize(size_t batchSize);
+
 private:
   std::pair<bool, shared_ptr<UdpFace>>
   createFace(const udp::Endpoint& remoteEndpoint, ndn::nfd::FacePersistency persistency);
@@ -125,6 +136,8 @@ private:
    */
   time::seconds m_idleFaceTimeout;
 
+  size_t m_faceBatchSize;
+
   uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
 };
 
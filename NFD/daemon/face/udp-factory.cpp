@@ -47,6 +47,7 @@ static const boost::asio::ip::address_v6 ALL_V6_ENDPOINT(
 
 UdpFactory::UdpFactory(const std::string& defaultPort/* = "6363"*/)
   : m_defaultPort(defaultPort)
+  , m_batchSize(1)
 {
 }
 
@@ -130,6 +131,7 @@ UdpFactory::createChannel(const udp::Endpoint& endpoint,
   }
 
   channel = make_shared<UdpChannel>(endpoint, timeout);
+  channel->setFaceBatchSize(m_batchSize);
   m_channels[endpoint] = channel;
   prohibitEndpoint(endpoint);
 
@@ -227,6 +229,7 @@ UdpFactory::createMulticastFace(const udp::Endpoint& localEndpoint,
 
   face = make_shared<MulticastUdpFace>(multicastEndpoint, FaceUri(localEndpoint),
                                        std::move(receiveSocket), std::move(sendSocket));
+  face->setBatchSize(m_batchSize);
 
   face->onFail.connectSingleShot([this, localEndpoint] (const std::string& reason) {
     m_multicastFaces.erase(localEndpoint);
@@ -324,4 +327,16 @@ UdpFactory::getChannels() const
   return channels;
 }
 
+void
+UdpFactory::setBatchSize(size_t batchSize)
+{
+  m_batchSize = batchSize;
+  for (const auto& i : m_channels) {
+    i.second->setFaceBatchSize(m_batchSize);
+  }
+  for (const auto& i : m_multicastFaces) {
+    i.second->setBatchSize(m_batchSize);
+  }
+}
+
 } // namespace nfd
@@ -158,6 +158,17 @@ public:
   const MulticastFaceMap&
   getMulticastFaces() const;
 
+  /**
+   * \brief Set the number of datagrams UDP faces receive or send with one system call
+   *
+   * The batch size applies to the faces of all channels and to multicast faces,
+   * including those created afterwards.  The default is 1, i.e., no batching.
+   *
+   * \see DatagramFace::setBatchSize
+   */
+  void
+  setBatchSize(size_t batchSize);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   prohibitEndpoint(const udp::Endpoint& endpoint);
@@ -201,6 +212,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   std::string m_defaultPort;
   std::set<udp::Endpoint> m_prohibitedEndpoints;
+  size_t m_batchSize;
 };
 
 inline const UdpFactory::MulticastFaceMap&
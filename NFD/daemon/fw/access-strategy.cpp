@@ -75,7 +75,7 @@ AccessStrategy::afterReceiveNewInterest(const Face& inFace,
                                         shared_ptr<pit::Entry> pitEntry)
 {
   Name miName;
-  shared_ptr<MtInfo> mi;
+  MtInfo* mi = nullptr;
   std::tie(miName, mi) = this->findPrefixMeasurements(*pitEntry);
 
   // has measurements for Interest Name?
@@ -143,8 +143,8 @@ AccessStrategy::sendToLastNexthop(const Face& inFace, shared_ptr<pit::Entry> pit
   this->sendInterest(pitEntry, face);
 
   // schedule RTO timeout
-  shared_ptr<PitInfo> pi = pitEntry->getOrCreateStrategyInfo<PitInfo>();
-  pi->rtoTimer = scheduler::schedule(rto,
+  PitInfo& pi = pitEntry->getOrCreateStrategyInfo<PitInfo>();
+  pi.rtoTimer = scheduler::schedule(rto,
       bind(&AccessStrategy::afterRtoTimeout, this, weak_ptr<pit::Entry>(pitEntry),
            weak_ptr<fib::Entry>(fibEntry), inFace.getId(), mi.lastNexthop));
 
@@ -189,7 +189,7 @@ void
 AccessStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry,
                                       const Face& inFace, const Data& data)
 {
-  shared_ptr<PitInfo> pi = pitEntry->getStrategyInfo<PitInfo>();
+  PitInfo* pi = pitEntry->getStrategyInfo<PitInfo>();
   if (pi != nullptr) {
     pi->rtoTimer.cancel();
   }
@@ -220,13 +220,13 @@ AccessStrategy::updateMeasurements(const Face& inFace, const Data& data,
   FaceInfo& fi = m_fit[inFace.getId()];
   fi.rtt.addMeasurement(rtt);
 
-  shared_ptr<MtInfo> mi = this->addPrefixMeasurements(data);
-  if (mi->lastNexthop != inFace.getId()) {
-    mi->lastNexthop = inFace.getId();
-    mi->rtt = fi.rtt;
+  MtInfo& mi = this->addPrefixMeasurements(data);
+  if (mi.lastNexthop != inFace.getId()) {
+    mi.lastNexthop = inFace.getId();
+    mi.rtt = fi.rtt;
   }
   else {
-    mi->rtt.addMeasurement(rtt);
+    mi.rtt.addMeasurement(rtt);
   }
 }
 
@@ -236,22 +236,22 @@ AccessStrategy::MtInfo::MtInfo()
 {
 }
 
-std::tuple<Name, shared_ptr<AccessStrategy::MtInfo>>
+std::tuple<Name, AccessStrategy::MtInfo*>
 AccessStrategy::findPrefixMeasurements(const pit::Entry& pitEntry)
 {
   shared_ptr<measurements::Entry> me = this->getMeasurements().findLongestPrefixMatch(pitEntry);
   if (me == nullptr) {
-    return std::forward_as_tuple(Name(), nullptr);
+    return std::make_tuple(Name(), nullptr);
   }
 
-  shared_ptr<MtInfo> mi = me->getStrategyInfo<MtInfo>();
+  MtInfo* mi = me->getStrategyInfo<MtInfo>();
   BOOST_ASSERT(mi != nullptr);
   // XXX after runtime strategy change, it's possible that me exists but mi doesn't exist;
   // this case needs another longest prefix match until mi is found
-  return std::forward_as_tuple(me->getName(), mi);
+  return std::make_tuple(me->getName(), mi);
 }
 
-shared_ptr<AccessStrategy::MtInfo>
+AccessStrategy::MtInfo&
 AccessStrategy::addPrefixMeasurements(const Data& data)
 {
   shared_ptr<measurements::Entry> me;
@@ -31,9 +31,18 @@ namespace nfd {
 
 NFD_LOG_INIT("FaceTable");
 
+static const size_t INITIAL_N_SLOTS = 64;
+
+static bool
+isLessFaceId(const shared_ptr<Face>& face, FaceId faceId)
+{
+  return face->getId() < faceId;
+}
+
 FaceTable::FaceTable(Forwarder& forwarder)
   : m_forwarder(forwarder)
   , m_lastFaceId(FACEID_RESERVED_MAX)
+  , m_slots(INITIAL_N_SLOTS)
 {
 }
 
@@ -45,8 +54,7 @@ FaceTable::~FaceTable()
 shared_ptr<Face>
 FaceTable::get(FaceId id) const
 {
-  std::map<FaceId, shared_ptr<Face> >::const_iterator i = m_faces.find(id);
-  return (i == m_faces.end()) ? (shared_ptr<Face>()) : (i->second);
+  return m_slots[this->findSlot(id)].face;
 }
 
 size_t
@@ -58,7 +66,7 @@ FaceTable::size() const
 void
 FaceTable::add(shared_ptr<Face> face)
 {
-  if (face->getId() != INVALID_FACEID && m_faces.count(face->getId()) > 0) {
+  if (face->getId() != INVALID_FACEID && m_slots[this->findSlot(face->getId())].face != nullptr) {
     NFD_LOG_WARN("Trying to add existing face id=" << face->getId() << " to the face table");
     return;
   }
@@ -72,7 +80,7 @@ void
 FaceTable::addReserved(shared_ptr<Face> face, FaceId faceId)
 {
   BOOST_ASSERT(face->getId() == INVALID_FACEID);
-  BOOST_ASSERT(m_faces.count(face->getId()) == 0);
+  BOOST_ASSERT(m_slots[this->findSlot(faceId)].face == nullptr);
   BOOST_ASSERT(faceId <= FACEID_RESERVED_MAX);
   this->addImpl(face, faceId);
 }
@@ -81,7 +89,9 @@ void
 FaceTable::addImpl(shared_ptr<Face> face, FaceId faceId)
 {
   face->setId(faceId);
-  m_faces[faceId] = face;
+  // new FaceIds are the largest, only reserved FaceIds are inserted before the end
+  m_faces.insert(std::lower_bound(m_faces.begin(), m_faces.end(), faceId, &isLessFaceId), face);
+  this->insertSlot(face);
   NFD_LOG_INFO("Added face id=" << faceId << " remote=" << face->getRemoteUri()
                                           << " local=" << face->getLocalUri());
 
@@ -98,7 +108,10 @@ FaceTable::remove(shared_ptr<Face> face, const std::string& reason)
   this->onRemove(face);
 
   FaceId faceId = face->getId();
-  m_faces.erase(faceId);
+  FaceList::iterator it = std::lower_bound(m_faces.begin(), m_faces.end(), faceId, &isLessFaceId);
+  BOOST_ASSERT(it != m_faces.end() && *it == face);
+  m_faces.erase(it);
+  this->eraseSlot(faceId);
   face->setId(INVALID_FACEID);
 
   NFD_LOG_INFO("Removed face id=" << faceId <<
@@ -109,22 +122,73 @@ FaceTable::remove(shared_ptr<Face> face, const std::string& reason)
   m_forwarder.getFib().removeNextHopFromAllEntries(face);
 }
 
-FaceTable::ForwardRange
-FaceTable::getForwardRange() const
+size_t
+FaceTable::findSlot(FaceId faceId) const
+{
+  size_t mask = m_slots.size() - 1;
+  size_t i = static_cast<size_t>(faceId) & mask;
+  while (m_slots[i].id != faceId && m_slots[i].id != INVALID_FACEID) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+void
+FaceTable::insertSlot(const shared_ptr<Face>& face)
 {
-  return m_faces | boost::adaptors::map_values;
+  if (m_faces.size() * 2 > m_slots.size()) {
+    // m_faces already contains the new face
+    this->rehash(m_slots.size() * 2);
+    return;
+  }
+
+  Slot& slot = m_slots[this->findSlot(face->getId())];
+  BOOST_ASSERT(slot.id == INVALID_FACEID);
+  slot.id = face->getId();
+  slot.face = face;
+}
+
+void
+FaceTable::eraseSlot(FaceId faceId)
+{
+  size_t mask = m_slots.size() - 1;
+  size_t hole = this->findSlot(faceId);
+  BOOST_ASSERT(m_slots[hole].id == faceId);
+
+  // move back later entries whose probe sequence passes through the hole,
+  // so that lookups never stop at an empty slot before reaching them
+  for (size_t i = (hole + 1) & mask; m_slots[i].id != INVALID_FACEID; i = (i + 1) & mask) {
+    size_t home = static_cast<size_t>(m_slots[i].id) & mask;
+    bool isHomeAfterHole = hole < i ? (hole < home && home <= i) : (hole < home || home <= i);
+    if (!isHomeAfterHole) {
+      m_slots[hole] = std::move(m_slots[i]);
+      hole = i;
+    }
+  }
+  m_slots[hole] = Slot();
+}
+
+void
+FaceTable::rehash(size_t nSlots)
+{
+  m_slots.assign(nSlots, Slot());
+  for (const shared_ptr<Face>& face : m_faces) {
+    Slot& slot = m_slots[this->findSlot(face->getId())];
+    slot.id = face->getId();
+    slot.face = face;
+  }
 }
 
 FaceTable::const_iterator
 FaceTable::begin() const
 {
-  return this->getForwardRange().begin();
+  return m_faces.begin();
 }
 
 FaceTable::const_iterator
 FaceTable::end() const
 {
-  return this->getForwardRange().end();
+  return m_faces.end();
 }
 
 } // namespace nfd
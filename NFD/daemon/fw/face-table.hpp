@@ -27,13 +27,16 @@
 #define NFD_DAEMON_FW_FACE_TABLE_HPP
 
 #include "face/face.hpp"
-#include <boost/range/adaptor/map.hpp>
 
 namespace nfd {
 
 class Forwarder;
 
 /** \brief container of all Faces
+ *
+ *  get() takes constant time.  add() takes amortized constant time, because new FaceIds are
+ *  the largest and go to the end of the enumeration order.  remove() takes time linear in the
+ *  number of faces, to keep the enumeration order; it runs only when a face fails or closes.
  */
 class FaceTable : noncopyable
 {
@@ -58,13 +61,13 @@ public:
   size() const;
 
 public: // enumeration
-  typedef std::map<FaceId, shared_ptr<Face>> FaceMap;
-
-  typedef boost::select_second_const_range<FaceMap> ForwardRange;
+  typedef std::vector<shared_ptr<Face>> FaceList;
 
   /** \brief ForwardIterator for shared_ptr<Face>
+   *
+   *  Faces are enumerated in increasing FaceId order.
    */
-  typedef boost::range_iterator<ForwardRange>::type const_iterator;
+  typedef FaceList::const_iterator const_iterator;
 
   const_iterator
   begin() const;
@@ -92,13 +95,51 @@ private:
   void
   remove(shared_ptr<Face> face, const std::string& reason);
 
-  ForwardRange
-  getForwardRange() const;
+  /** \return position of the slot holding \p faceId,
+   *          or of the empty slot where \p faceId would be inserted
+   */
+  size_t
+  findSlot(FaceId faceId) const;
+
+  void
+  insertSlot(const shared_ptr<Face>& face);
+
+  void
+  eraseSlot(FaceId faceId);
+
+  void
+  rehash(size_t nSlots);
 
 private:
+  struct Slot
+  {
+    Slot()
+      : id(INVALID_FACEID)
+    {
+    }
+
+    FaceId id;
+    shared_ptr<Face> face;
+  };
+
   Forwarder& m_forwarder;
   FaceId m_lastFaceId;
-  FaceMap m_faces;
+
+  /** \brief all faces in increasing FaceId order
+   *
+   *  FaceStatusPublisher relies on this order to list faces by FaceId, so a removed face is
+   *  erased in place rather than swapped with the last one.
+   */
+  FaceList m_faces;
+
+  /** \brief index from FaceId to Face
+   *
+   *  FaceIds are allocated sequentially, so the low bits of FaceId select the slot and
+   *  faces added one after another occupy consecutive slots. The FaceId kept in each slot
+   *  tells apart FaceIds that share the low bits; such collisions are resolved by linear
+   *  probing. The number of slots is a power of two, at least twice the number of faces.
+   */
+  std::vector<Slot> m_slots;
 };
 
 } // namespace nfd
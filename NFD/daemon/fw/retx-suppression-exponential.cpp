@@ -81,15 +81,15 @@ RetxSuppressionExponential::decide(const Face& inFace, const Interest& interest,
   time::steady_clock::TimePoint now = time::steady_clock::now();
   time::steady_clock::Duration sinceLastOutgoing = now - lastOutgoing;
 
-  shared_ptr<PitInfo> pi = pitEntry.getOrCreateStrategyInfo<PitInfo>(m_initialInterval);
-  bool shouldSuppress = sinceLastOutgoing < pi->suppressionInterval;
+  PitInfo& pi = pitEntry.getOrCreateStrategyInfo<PitInfo>(m_initialInterval);
+  bool shouldSuppress = sinceLastOutgoing < pi.suppressionInterval;
 
   if (shouldSuppress) {
     return SUPPRESS;
   }
 
-  pi->suppressionInterval = std::min(m_maxInterval,
-      time::duration_cast<Duration>(pi->suppressionInterval * m_multiplier));
+  pi.suppressionInterval = std::min(m_maxInterval,
+      time::duration_cast<Duration>(pi.suppressionInterval * m_multiplier));
   return FORWARD;
 }
 
@@ -58,6 +58,17 @@ StatusServer::onInterest(const Interest& interest) const
   m_face->put(*data);
 }
 
+static ndn::nfd::ForwarderStatus::AllocatorStatus
+makeAllocatorStatus(const std::string& name, const MemoryPool& pool)
+{
+  ndn::nfd::ForwarderStatus::AllocatorStatus allocator;
+  allocator.name = name;
+  allocator.blockSize = pool.getBlockSize();
+  allocator.nAllocatedBlocks = pool.getNAllocatedBlocks();
+  allocator.nBlocks = pool.getNBlocks();
+  return allocator;
+}
+
 shared_ptr<ndn::nfd::ForwarderStatus>
 StatusServer::collectStatus() const
 {
@@ -75,6 +86,16 @@ StatusServer::collectStatus() const
 
   m_forwarder.getCounters().copyTo(*status);
 
+  const NameTree& nameTree = m_forwarder.getNameTree();
+  status->addAllocator(makeAllocatorStatus("NameTreeEntry", nameTree.getEntryPool()));
+  if (nameTree.getNodePool() != nullptr) {
+    status->addAllocator(makeAllocatorStatus("NameTreeNode", *nameTree.getNodePool()));
+  }
+  status->addAllocator(makeAllocatorStatus("PitEntry",
+                                           m_forwarder.getPit().getEntryPool()));
+  status->addAllocator(makeAllocatorStatus("MeasurementsEntry",
+                                           m_forwarder.getMeasurements().getEntryPool()));
+
   return status;
 }
 
@@ -30,14 +30,11 @@
 #ifndef NFD_DAEMON_TABLE_CS_INTERNAL_HPP
 #define NFD_DAEMON_TABLE_CS_INTERNAL_HPP
 
-#include "common.hpp"
+#include "cs-table.hpp"
 
 namespace nfd {
 namespace cs {
 
-class EntryImpl;
-
-typedef std::set<EntryImpl> Table;
 typedef Table::const_iterator iterator;
 
 } // namespace cs
@@ -56,7 +56,7 @@ struct EntryItComparator
   bool
   operator()(const iterator& a, const iterator& b) const
   {
-    return *a < *b;
+    return &*a < &*b;
   }
 };
 
@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cs-table.hpp"
+
+namespace nfd {
+namespace cs {
+
+TableNode::TableNode(TableNode* parent)
+  : m_parent(parent)
+{
+}
+
+TableIterator::TableIterator()
+  : m_node(nullptr)
+{
+}
+
+TableIterator::TableIterator(TableNode* node, TableNode::EntryList::const_iterator entry)
+  : m_node(node)
+  , m_entry(entry)
+{
+  BOOST_ASSERT(m_node != nullptr);
+}
+
+TableIterator&
+TableIterator::operator++()
+{
+  BOOST_ASSERT(m_node != nullptr);
+
+  ++m_entry;
+  if (m_entry != m_node->m_entries.end()) {
+    return *this;
+  }
+
+  // go to next node in depth-first order
+  TableNode* node = m_node;
+  if (!node->m_children.empty()) {
+    this->seek(node->m_children.begin()->second.get());
+    return *this;
+  }
+
+  for (; node->m_parent != nullptr; node = node->m_parent) {
+    TableNode::ChildMap::iterator next = std::next(node->m_position);
+    if (next != node->m_parent->m_children.end()) {
+      this->seek(next->second.get());
+      return *this;
+    }
+  }
+
+  m_node = nullptr;
+  return *this;
+}
+
+TableIterator
+TableIterator::operator++(int)
+{
+  TableIterator copy = *this;
+  this->operator++();
+  return copy;
+}
+
+void
+TableIterator::seek(TableNode* node)
+{
+  // A node without entries has children, so this descends to an entry.
+  while (node->m_entries.empty()) {
+    BOOST_ASSERT(!node->m_children.empty());
+    node = node->m_children.begin()->second.get();
+  }
+
+  m_node = node;
+  m_entry = node->m_entries.begin();
+}
+
+Table::Table()
+  : m_root(new TableNode(nullptr))
+  , m_size(0)
+{
+}
+
+std::pair<Table::const_iterator, bool>
+Table::insert(shared_ptr<const Data> data, bool isUnsolicited)
+{
+  TableNode* node = m_root.get();
+  for (const name::Component& component : data->getName()) {
+    TableNode::ChildMap::iterator child = node->m_children.lower_bound(component);
+    if (child == node->m_children.end() || child->first != component) {
+      unique_ptr<TableNode> newNode(new TableNode(node));
+      child = node->m_children.insert(child, std::make_pair(component, std::move(newNode)));
+      child->second->m_position = child;
+    }
+    node = child->second.get();
+  }
+
+  TableNode::EntryList::iterator pos = node->m_entries.begin();
+  if (pos != node->m_entries.end()) {
+    // Data with same Name exists; keep entries ordered by implicit digest
+    const name::Component& digest = data->getFullName().get(-1);
+    for (; pos != node->m_entries.end(); ++pos) {
+      int cmp = pos->getFullName().get(-1).compare(digest);
+      if (cmp == 0) {
+        return std::make_pair(const_iterator(node, pos), false);
+      }
+      if (cmp > 0) {
+        break;
+      }
+    }
+  }
+
+  pos = node->m_entries.insert(pos, EntryImpl(data, isUnsolicited));
+  ++m_size;
+  return std::make_pair(const_iterator(node, pos), true);
+}
+
+void
+Table::erase(const_iterator i)
+{
+  BOOST_ASSERT(i.m_node != nullptr);
+
+  TableNode* node = i.m_node;
+  node->m_entries.erase(i.m_entry);
+  --m_size;
+
+  while (node->m_parent != nullptr && node->m_entries.empty() && node->m_children.empty()) {
+    TableNode* parent = node->m_parent;
+    parent->m_children.erase(node->m_position);
+    node = parent;
+  }
+}
+
+const TableNode*
+Table::findNode(const Name& name, size_t prefixLen) const
+{
+  BOOST_ASSERT(prefixLen <= name.size());
+
+  const TableNode* node = m_root.get();
+  for (size_t i = 0; i < prefixLen; ++i) {
+    TableNode::ChildMap::const_iterator child = node->m_children.find(name[i]);
+    if (child == node->m_children.end()) {
+      return nullptr;
+    }
+    node = child->second.get();
+  }
+  return node;
+}
+
+Table::const_iterator
+Table::makeIterator(const TableNode& node, TableNode::EntryList::const_iterator entry) const
+{
+  // Nodes are owned by this Table; constness of the lookup does not extend to the iterator.
+  return const_iterator(const_cast<TableNode*>(&node), entry);
+}
+
+Table::const_iterator
+Table::begin() const
+{
+  if (m_size == 0) {
+    return this->end();
+  }
+
+  const_iterator i;
+  i.seek(m_root.get());
+  return i;
+}
+
+} // namespace cs
+} // namespace nfd
@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \file
+ *  \brief declares the name trie that stores ContentStore entries
+ */
+
+#ifndef NFD_DAEMON_TABLE_CS_TABLE_HPP
+#define NFD_DAEMON_TABLE_CS_TABLE_HPP
+
+#include "cs-entry-impl.hpp"
+
+namespace nfd {
+namespace cs {
+
+class Table;
+class TableIterator;
+
+/** \brief a node in ContentStore name trie
+ *
+ *  A node corresponds to a Data Name. It holds the entries whose Data has exactly this Name,
+ *  and child nodes keyed by the next name component.
+ *  A node without entries exists only if it has children.
+ */
+class TableNode : noncopyable
+{
+public:
+  typedef std::map<name::Component, unique_ptr<TableNode>> ChildMap;
+  typedef std::list<EntryImpl> EntryList;
+
+  /** \return entries whose Data Name equals the Name of this node, ordered by implicit digest
+   */
+  const EntryList&
+  getEntries() const
+  {
+    return m_entries;
+  }
+
+  /** \return child nodes, ordered by the next name component
+   */
+  const ChildMap&
+  getChildren() const
+  {
+    return m_children;
+  }
+
+private:
+  explicit
+  TableNode(TableNode* parent);
+
+private:
+  TableNode* m_parent;
+  ChildMap::iterator m_position; ///< position in parent's children, unused on root
+  ChildMap m_children;
+  EntryList m_entries;
+
+  friend class Table;
+  friend class TableIterator;
+};
+
+/** \brief ContentStore Table iterator
+ *
+ *  Entries are visited in depth-first order: entries of a node are visited before its children,
+ *  and children are visited in name component order.
+ *  An iterator remains valid until the entry it points to is erased.
+ */
+class TableIterator
+{
+public:
+  typedef std::forward_iterator_tag iterator_category;
+  typedef const EntryImpl value_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef const EntryImpl* pointer;
+  typedef const EntryImpl& reference;
+
+  /** \brief constructs an end iterator
+   */
+  TableIterator();
+
+  TableIterator(TableNode* node, TableNode::EntryList::const_iterator entry);
+
+  const EntryImpl&
+  operator*() const
+  {
+    BOOST_ASSERT(m_node != nullptr);
+    return *m_entry;
+  }
+
+  const EntryImpl*
+  operator->() const
+  {
+    BOOST_ASSERT(m_node != nullptr);
+    return &*m_entry;
+  }
+
+  TableIterator&
+  operator++();
+
+  TableIterator
+  operator++(int);
+
+  bool
+  operator==(const TableIterator& other) const
+  {
+    return m_node == other.m_node &&
+           (m_node == nullptr || m_entry == other.m_entry);
+  }
+
+  bool
+  operator!=(const TableIterator& other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  /** \brief moves to the first entry at or after \p node in depth-first order
+   */
+  void
+  seek(TableNode* node);
+
+private:
+  TableNode* m_node; ///< nullptr for end iterator
+  TableNode::EntryList::const_iterator m_entry;
+
+  friend class Table;
+};
+
+/** \brief ContentStore Table
+ *
+ *  Entries are indexed by a trie of Data Name components,
+ *  so that finding the entries under a prefix takes time proportional to the prefix length.
+ *  Entries with the same Name are distinguished by implicit digest.
+ */
+class Table : noncopyable
+{
+public:
+  typedef TableIterator const_iterator;
+
+  Table();
+
+  /** \return number of entries
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /** \brief inserts an entry for \p data, unless an entry with the same full Name exists
+   *  \return iterator to the new or existing entry, and whether a new entry is inserted
+   */
+  std::pair<const_iterator, bool>
+  insert(shared_ptr<const Data> data, bool isUnsolicited);
+
+  /** \brief erases an entry
+   *
+   *  Nodes that are left without entries and children are removed.
+   */
+  void
+  erase(const_iterator i);
+
+  /** \return the node for the first \p prefixLen components of \p name, or nullptr if none
+   */
+  const TableNode*
+  findNode(const Name& name, size_t prefixLen) const;
+
+  /** \return the node for \p name, or nullptr if none
+   */
+  const TableNode*
+  findNode(const Name& name) const
+  {
+    return this->findNode(name, name.size());
+  }
+
+  /** \return iterator to an entry in \p node, in constant time
+   */
+  const_iterator
+  makeIterator(const TableNode& node, TableNode::EntryList::const_iterator entry) const;
+
+  const_iterator
+  begin() const;
+
+  const_iterator
+  end() const
+  {
+    return const_iterator();
+  }
+
+private:
+  unique_ptr<TableNode> m_root;
+  size_t m_size;
+};
+
+} // namespace cs
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_CS_TABLE_HPP
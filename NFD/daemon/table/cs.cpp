@@ -26,7 +26,6 @@
 #include "cs.hpp"
 #include "cs-policy-priority-fifo.hpp"
 #include "core/logger.hpp"
-#include "core/algorithm.hpp"
 
 NFD_LOG_INIT("ContentStore");
 
@@ -95,8 +94,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
 
   bool isNewEntry = false;
   iterator it;
-  // use .insert because gcc46 does not support .emplace
-  std::tie(it, isNewEntry) = m_table.insert(EntryImpl(data.shared_from_this(), isUnsolicited));
+  std::tie(it, isNewEntry) = m_table.insert(data.shared_from_this(), isUnsolicited);
   EntryImpl& entry = const_cast<EntryImpl&>(*it);
 
   entry.updateStaleTime();
@@ -116,6 +114,49 @@ Cs::insert(const Data& data, bool isUnsolicited)
   return true;
 }
 
+/** \return whether any Data under Interest Name can satisfy the Interest
+ *  \note ChildSelector only affects which Data is preferred, and is not considered
+ */
+static bool
+isSelectorFree(const Interest& interest)
+{
+  return interest.getMinSuffixComponents() < 0 &&
+         interest.getMaxSuffixComponents() < 0 &&
+         interest.getPublisherPublicKeyLocator().empty() &&
+         interest.getExclude().empty() &&
+         !interest.getMustBeFresh();
+}
+
+/** \return whether Data in a node that is \p depth components beyond Interest Name
+ *          satisfies MinSuffixComponents
+ */
+static bool
+canSatisfyMinSuffix(const Interest& interest, size_t depth)
+{
+  // full Name of such Data has depth+1 components beyond Interest Name
+  int minSuffixComponents = interest.getMinSuffixComponents();
+  return minSuffixComponents < 0 || depth + 1 >= static_cast<size_t>(minSuffixComponents);
+}
+
+/** \return whether Data in a node that is \p depth components beyond Interest Name,
+ *          or in its descendants, may satisfy MaxSuffixComponents
+ */
+static bool
+canSatisfyMaxSuffix(const Interest& interest, size_t depth)
+{
+  int maxSuffixComponents = interest.getMaxSuffixComponents();
+  return maxSuffixComponents < 0 || depth + 1 <= static_cast<size_t>(maxSuffixComponents);
+}
+
+/** \return whether the child under \p component of the node of Interest Name is excluded
+ */
+static bool
+isExcludedChild(const Interest& interest, const name::Component& component)
+{
+  const Exclude& exclude = interest.getExclude();
+  return !exclude.empty() && exclude.isExcluded(component);
+}
+
 void
 Cs::find(const Interest& interest,
          const HitCallback& hitCallback,
@@ -128,21 +169,33 @@ Cs::find(const Interest& interest,
   bool isRightmost = interest.getChildSelector() == 1;
   NFD_LOG_DEBUG("find " << prefix << (isRightmost ? " R" : " L"));
 
-  iterator first = m_table.lower_bound(prefix);
-  iterator last = m_table.end();
-  if (prefix.size() > 0) {
-    last = m_table.lower_bound(prefix.getSuccessor());
+  // An Interest whose selectors don't restrict matching is satisfied by any Data under its Name,
+  // so the first Data visited is the match.
+  bool needsCheck = !isSelectorFree(interest);
+  bool isFullName = !prefix.empty() && prefix[-1].isImplicitSha256Digest();
+
+  iterator match = m_table.end();
+  if (isFullName && !isRightmost) {
+    match = this->findFullName(interest, needsCheck);
   }
 
-  iterator match = last;
-  if (isRightmost) {
-    match = this->findRightmost(interest, first, last);
+  if (match == m_table.end()) {
+    const TableNode* node = m_table.findNode(prefix);
+    if (node != nullptr) {
+      if (isRightmost) {
+        match = this->findRightmost(interest, *node, needsCheck);
+      }
+      else {
+        match = this->findLeftmost(interest, *node, 0, needsCheck);
+      }
+    }
   }
-  else {
-    match = this->findLeftmost(interest, first, last);
+
+  if (match == m_table.end() && isFullName && isRightmost) {
+    match = this->findFullName(interest, needsCheck);
   }
 
-  if (match == last) {
+  if (match == m_table.end()) {
     NFD_LOG_DEBUG("  no-match");
     missCallback(interest);
     return;
@@ -153,47 +206,94 @@ Cs::find(const Interest& interest,
 }
 
 iterator
-Cs::findLeftmost(const Interest& interest, iterator first, iterator last) const
+Cs::findLeftmost(const Interest& interest, const TableNode& node, size_t depth,
+                 bool needsCheck) const
 {
-  return std::find_if(first, last, bind(&cs::EntryImpl::canSatisfy, _1, interest));
+  if (needsCheck && !canSatisfyMaxSuffix(interest, depth)) {
+    return m_table.end();
+  }
+
+  const TableNode::EntryList& entries = node.getEntries();
+  if (!needsCheck) {
+    if (!entries.empty()) {
+      return m_table.makeIterator(node, entries.begin());
+    }
+  }
+  else if (canSatisfyMinSuffix(interest, depth)) {
+    for (auto entry = entries.begin(); entry != entries.end(); ++entry) {
+      if (entry->canSatisfy(interest)) {
+        return m_table.makeIterator(node, entry);
+      }
+    }
+  }
+
+  for (const auto& child : node.getChildren()) {
+    if (needsCheck && depth == 0 && isExcludedChild(interest, child.first)) {
+      continue;
+    }
+    iterator match = this->findLeftmost(interest, *child.second, depth + 1, needsCheck);
+    if (match != m_table.end()) {
+      return match;
+    }
+  }
+  return m_table.end();
 }
 
 iterator
-Cs::findRightmost(const Interest& interest, iterator first, iterator last) const
+Cs::findRightmost(const Interest& interest, const TableNode& node, bool needsCheck) const
 {
-  // Each loop visits a sub-namespace under a prefix one component longer than Interest Name.
-  // If there is a match in that sub-namespace, the leftmost match is returned;
-  // otherwise, loop continues.
-
-  size_t interestNameLength = interest.getName().size();
-  for (iterator right = last; right != first;) {
-    iterator prev = std::prev(right);
-
-    // special case: [first,prev] have exact Names
-    if (prev->getName().size() == interestNameLength) {
-      NFD_LOG_TRACE("  find-among-exact " << prev->getName());
-      iterator matchExact = this->findRightmostAmongExact(interest, first, right);
-      return matchExact == right ? last : matchExact;
+  // Each child is a sub-namespace under a prefix one component longer than Interest Name.
+  // Children are visited from the right; if there is a match in that sub-namespace,
+  // the leftmost match is returned.
+  const TableNode::ChildMap& children = node.getChildren();
+  for (auto child = children.rbegin(); child != children.rend(); ++child) {
+    if (needsCheck && isExcludedChild(interest, child->first)) {
+      continue;
     }
-
-    Name prefix = prev->getName().getPrefix(interestNameLength + 1);
-    iterator left = m_table.lower_bound(prefix);
-
-    // normal case: [left,right) are under one-component-longer prefix
-    NFD_LOG_TRACE("  find-under-prefix " << prefix);
-    iterator match = this->findLeftmost(interest, left, right);
-    if (match != right) {
+    NFD_LOG_TRACE("  find-under-prefix " << interest.getName() << "/" << child->first);
+    iterator match = this->findLeftmost(interest, *child->second, 1, needsCheck);
+    if (match != m_table.end()) {
       return match;
     }
-    right = left;
   }
-  return last;
+
+  // Data with exact Names
+  NFD_LOG_TRACE("  find-among-exact " << interest.getName());
+  const TableNode::EntryList& entries = node.getEntries();
+  if (!needsCheck) {
+    if (!entries.empty()) {
+      return m_table.makeIterator(node, std::prev(entries.end()));
+    }
+  }
+  else if (canSatisfyMinSuffix(interest, 0) && canSatisfyMaxSuffix(interest, 0)) {
+    for (auto entry = entries.rbegin(); entry != entries.rend(); ++entry) {
+      if (entry->canSatisfy(interest)) {
+        return m_table.makeIterator(node, std::prev(entry.base()));
+      }
+    }
+  }
+  return m_table.end();
 }
 
 iterator
-Cs::findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const
+Cs::findFullName(const Interest& interest, bool needsCheck) const
 {
-  return find_last_if(first, last, bind(&EntryImpl::canSatisfy, _1, interest));
+  const Name& fullName = interest.getName();
+  const TableNode* node = m_table.findNode(fullName, fullName.size() - 1);
+  if (node == nullptr) {
+    return m_table.end();
+  }
+
+  const TableNode::EntryList& entries = node->getEntries();
+  for (auto entry = entries.begin(); entry != entries.end(); ++entry) {
+    if (entry->getFullName().get(-1) == fullName[-1]) {
+      if (needsCheck && !entry->canSatisfy(interest)) {
+        break;
+      }
+      return m_table.makeIterator(*node, entry);
+    }
+  }
+  return m_table.end();
 }
 
 void
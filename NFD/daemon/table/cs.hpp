@@ -28,21 +28,21 @@
  *  \brief implements the ContentStore
  *
  *  This ContentStore implementation consists of two data structures,
- *  a Table, and a set of cleanup queues.
+ *  a Table, and a replacement policy.
  *
- *  The Table is a container (std::set) sorted by full Names of stored Data packets.
+ *  The Table is a trie of name components, where each node holds the Data packets
+ *  whose Name ends at that node.
  *  Data packets are wrapped in Entry objects.
  *  Each Entry contain the Data packet itself,
  *  and a few addition attributes such as the staleness of the Data packet.
+ *  Lookup walks the trie to the node of Interest Name, so that its cost depends on
+ *  the length of Interest Name rather than the number of stored packets.
+ *  Among the Data packets under that node, the leftmost or rightmost match is found
+ *  by a depth-first traversal; an Interest without selectors that restrict matching
+ *  takes the first Data packet visited without evaluating any selector.
  *
- *  The cleanup queues are three doubly linked lists which stores Table iterators.
- *  The three queues keep track of unsolicited, stale, and fresh Data packet, respectively.
- *  Table iterator is placed into, removed from, and moved between suitable queues
- *  whenever an Entry is added, removed, or has other attribute changes.
- *  The Table iterator of an Entry should be in exactly one queue at any moment.
- *  Within each queue, the iterators are kept in first-in-first-out order.
- *  Eviction procedure exhausts the first queue before moving onto the next queue,
- *  in the order of unsolicited, stale, and fresh queue.
+ *  The replacement policy keeps Table iterators in its cleanup index,
+ *  and decides which Entry to evict when the ContentStore is full.
  */
 
 #ifndef NFD_DAEMON_TABLE_CS_HPP
@@ -160,23 +160,29 @@ public: // enumeration
   }
 
 private: // find
-  /** \brief find leftmost match in [first,last)
-   *  \return the leftmost match, or last if not found
+  /** \brief find leftmost match in the subtree of \p node
+   *  \param depth number of components in Name of \p node beyond Interest Name
+   *  \param needsCheck whether Interest selectors must be evaluated
+   *  \return the leftmost match, or end if not found
    */
   iterator
-  findLeftmost(const Interest& interest, iterator left, iterator right) const;
+  findLeftmost(const Interest& interest, const TableNode& node, size_t depth,
+               bool needsCheck) const;
 
-  /** \brief find rightmost match in [first,last)
-   *  \return the rightmost match, or last if not found
+  /** \brief find rightmost match in the subtree of \p node
+   *  \param node the node of Interest Name
+   *  \param needsCheck whether Interest selectors must be evaluated
+   *  \return the rightmost match, or end if not found
    */
   iterator
-  findRightmost(const Interest& interest, iterator first, iterator last) const;
+  findRightmost(const Interest& interest, const TableNode& node, bool needsCheck) const;
 
-  /** \brief find rightmost match among entries with exact Names in [first,last)
-   *  \return the rightmost match, or last if not found
+  /** \brief find the Data whose full Name equals Interest Name
+   *  \pre Interest Name ends with an implicit digest
+   *  \return the match, or end if not found
    */
   iterator
-  findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const;
+  findFullName(const Interest& interest, bool needsCheck) const;
 
   void
   setPolicyImpl(unique_ptr<Policy>& policy);
@@ -27,6 +27,8 @@
 #include "core/city-hash.hpp"
 #include "core/logger.hpp"
 
+#include <limits>
+
 NFD_LOG_INIT("DeadNonceList");
 
 namespace nfd {
@@ -42,11 +44,26 @@ const double DeadNonceList::CAPACITY_UP = 1.2;
 const double DeadNonceList::CAPACITY_DOWN = 0.9;
 const size_t DeadNonceList::EVICT_LIMIT = (1 << 6);
 
+/** \return the smallest power of two that is no less than \p n
+ */
+static size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t size = 1;
+  while (size < n) {
+    size <<= 1;
+  }
+  return size;
+}
+
 DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
   : m_lifetime(lifetime)
-  , m_queue(m_index.get<0>())
-  , m_ht(m_index.get<1>())
+  , m_queueHead(0)
+  , m_queueSize(0)
   , m_capacity(INITIAL_CAPACITY)
+  , m_nMarks(0)
+  , m_minMarkCount(std::numeric_limits<size_t>::max())
+  , m_maxMarkCount(0)
   , m_markInterval(m_lifetime / EXPECTED_MARK_COUNT)
   , m_adjustCapacityInterval(m_lifetime)
 {
@@ -54,8 +71,11 @@ DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
     BOOST_THROW_EXCEPTION(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
   }
 
+  // room for INITIAL_CAPACITY entries plus what can accumulate before eviction catches up
+  this->resize(roundUpToPowerOfTwo(INITIAL_CAPACITY + EVICT_LIMIT));
+
   for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
-    m_queue.push_back(MARK);
+    this->pushBack(MARK);
   }
 
   m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
@@ -83,21 +103,21 @@ DeadNonceList::~DeadNonceList()
 size_t
 DeadNonceList::size() const
 {
-  return m_queue.size() - this->countMarks();
+  return m_queueSize - this->countMarks();
 }
 
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
-  return m_ht.find(entry) != m_ht.end();
+  return entry != MARK && this->findInHt(entry) != m_ht.size();
 }
 
 void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
   Entry entry = DeadNonceList::makeEntry(name, nonce);
-  m_queue.push_back(entry);
+  this->pushBack(entry);
 
   this->evictEntries();
 }
@@ -110,47 +130,152 @@ DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
                             static_cast<uint64_t>(nonce));
 }
 
+void
+DeadNonceList::pushBack(Entry entry)
+{
+  if (m_queueSize == m_queue.size()) {
+    this->resize(m_queue.size() * 2);
+  }
+
+  m_queue[(m_queueHead + m_queueSize) & (m_queue.size() - 1)] = entry;
+  ++m_queueSize;
+
+  if (entry == MARK) {
+    ++m_nMarks;
+  }
+  else {
+    this->insertToHt(entry);
+  }
+}
+
+void
+DeadNonceList::popFront()
+{
+  BOOST_ASSERT(m_queueSize > 0);
+  Entry entry = m_queue[m_queueHead];
+  m_queueHead = (m_queueHead + 1) & (m_queue.size() - 1);
+  --m_queueSize;
+
+  if (entry == MARK) {
+    --m_nMarks;
+  }
+  else {
+    this->eraseFromHt(entry);
+  }
+}
+
+void
+DeadNonceList::resize(size_t queueSize)
+{
+  BOOST_ASSERT((queueSize & (queueSize - 1)) == 0);
+  BOOST_ASSERT(queueSize >= m_queueSize);
+  NFD_LOG_TRACE("resize " << m_queue.size() << " => " << queueSize);
+
+  std::vector<Entry> queue(queueSize);
+  for (size_t i = 0; i < m_queueSize; ++i) {
+    queue[i] = m_queue[(m_queueHead + i) & (m_queue.size() - 1)];
+  }
+  m_queue.swap(queue);
+  m_queueHead = 0;
+
+  m_ht.assign(queueSize * 2, MARK);
+  for (size_t i = 0; i < m_queueSize; ++i) {
+    if (m_queue[i] != MARK) {
+      this->insertToHt(m_queue[i]);
+    }
+  }
+}
+
+size_t
+DeadNonceList::findInHt(Entry entry) const
+{
+  size_t mask = m_ht.size() - 1;
+  for (size_t i = entry & mask; m_ht[i] != MARK; i = (i + 1) & mask) {
+    if (m_ht[i] == entry) {
+      return i;
+    }
+  }
+  return m_ht.size();
+}
+
+void
+DeadNonceList::insertToHt(Entry entry)
+{
+  // duplicate entries occupy separate buckets, like in the queue
+  size_t mask = m_ht.size() - 1;
+  size_t i = entry & mask;
+  while (m_ht[i] != MARK) {
+    i = (i + 1) & mask;
+  }
+  m_ht[i] = entry;
+}
+
+void
+DeadNonceList::eraseFromHt(Entry entry)
+{
+  size_t i = this->findInHt(entry);
+  BOOST_ASSERT(i != m_ht.size());
+
+  // backward shift deletion: move later entries of the probe sequence into the hole,
+  // so that lookups can stop at the first empty bucket
+  size_t mask = m_ht.size() - 1;
+  for (size_t j = (i + 1) & mask; m_ht[j] != MARK; j = (j + 1) & mask) {
+    size_t home = m_ht[j] & mask;
+    // entry at j can fill the hole at i if its home bucket is not within (i, j]
+    if (((j - home) & mask) >= ((j - i) & mask)) {
+      m_ht[i] = m_ht[j];
+      i = j;
+    }
+  }
+  m_ht[i] = MARK;
+}
+
 size_t
 DeadNonceList::countMarks() const
 {
-  return m_ht.count(MARK);
+  return m_nMarks;
 }
 
 void
 DeadNonceList::mark()
 {
-  m_queue.push_back(MARK);
+  this->pushBack(MARK);
   size_t nMarks = this->countMarks();
-  m_actualMarkCounts.insert(nMarks);
+  m_minMarkCount = std::min(m_minMarkCount, nMarks);
+  m_maxMarkCount = std::max(m_maxMarkCount, nMarks);
 
   NFD_LOG_TRACE("mark nMarks=" << nMarks);
 
-  scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
+  m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
 }
 
 void
 DeadNonceList::adjustCapacity()
 {
-  std::pair<std::multiset<size_t>::iterator, std::multiset<size_t>::iterator> equalRange =
-    m_actualMarkCounts.equal_range(EXPECTED_MARK_COUNT);
-
-  if (equalRange.second == m_actualMarkCounts.begin()) {
+  if (m_minMarkCount > EXPECTED_MARK_COUNT) {
     // all counts are above expected count, adjust down
     m_capacity = std::max(MIN_CAPACITY,
                           static_cast<size_t>(m_capacity * CAPACITY_DOWN));
     NFD_LOG_TRACE("adjustCapacity DOWN capacity=" << m_capacity);
   }
-  else if (equalRange.first == m_actualMarkCounts.end()) {
+  else if (m_maxMarkCount < EXPECTED_MARK_COUNT) {
     // all counts are below expected count, adjust up
     m_capacity = std::min(MAX_CAPACITY,
                           static_cast<size_t>(m_capacity * CAPACITY_UP));
     NFD_LOG_TRACE("adjustCapacity UP capacity=" << m_capacity);
   }
 
-  m_actualMarkCounts.clear();
+  m_minMarkCount = std::numeric_limits<size_t>::max();
+  m_maxMarkCount = 0;
 
   this->evictEntries();
 
+  // release memory after the capacity has decreased substantially
+  size_t queueSize = roundUpToPowerOfTwo(std::max(m_capacity, m_queueSize) + EVICT_LIMIT);
+  if (queueSize * 4 <= m_queue.size()) {
+    this->resize(queueSize);
+  }
+
   m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
                                               bind(&DeadNonceList::adjustCapacity, this));
 }
@@ -158,14 +283,14 @@ DeadNonceList::adjustCapacity()
 void
 DeadNonceList::evictEntries()
 {
-  ssize_t nOverCapacity = m_queue.size() - m_capacity;
+  ssize_t nOverCapacity = m_queueSize - m_capacity;
   if (nOverCapacity <= 0) // not over capacity
     return;
 
   for (ssize_t nEvict = std::min<ssize_t>(nOverCapacity, EVICT_LIMIT); nEvict > 0; --nEvict) {
-    m_queue.erase(m_queue.begin());
+    this->popFront();
   }
-  BOOST_ASSERT(m_queue.size() >= m_capacity);
+  BOOST_ASSERT(m_queueSize >= m_capacity);
 }
 
 } // namespace nfd
@@ -27,9 +27,6 @@
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
 #include "common.hpp"
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
-#include <boost/multi_index/hashed_index.hpp>
 #include "core/scheduler.hpp"
 
 namespace nfd {
@@ -50,6 +47,10 @@ namespace nfd {
  *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
  *  The number of MARKs stored in the container reflects the lifetime of entries,
  *  because MARKs are inserted at fixed intervals.
+ *
+ *  Entries are kept in a ring buffer in insertion order, and indexed by an open-addressed
+ *  hashtable with linear probing. Both are flat arrays that are only reallocated when
+ *  the capacity grows or shrinks substantially, so that adding an entry does not allocate.
  */
 class DeadNonceList : noncopyable
 {
@@ -94,18 +95,32 @@ private: // Entry and Index
   static Entry
   makeEntry(const Name& name, uint32_t nonce);
 
-  typedef boost::multi_index_container<
-    Entry,
-    boost::multi_index::indexed_by<
-      boost::multi_index::sequenced<>,
-      boost::multi_index::hashed_non_unique<
-        boost::multi_index::identity<Entry>
-      >
-    >
-  > Index;
+  /** \brief appends an entry to the queue
+   */
+  void
+  pushBack(Entry entry);
+
+  /** \brief removes the oldest entry from the queue
+   */
+  void
+  popFront();
+
+  /** \brief reallocates the queue and the hashtable
+   *  \param queueSize queue capacity, must be a power of two and no less than m_queueSize
+   */
+  void
+  resize(size_t queueSize);
 
-  typedef Index::nth_index<0>::type Queue;
-  typedef Index::nth_index<1>::type Hashtable;
+  /** \return position of \p entry in the hashtable, or m_ht.size() if not found
+   */
+  size_t
+  findInHt(Entry entry) const;
+
+  void
+  insertToHt(Entry entry);
+
+  void
+  eraseFromHt(Entry entry);
 
 private: // actual lifetime estimation and capacity control
   /** \return number of MARKs in the index
@@ -140,9 +155,21 @@ public:
 
 private:
   time::nanoseconds m_lifetime;
-  Index m_index;
-  Queue& m_queue;
-  Hashtable& m_ht;
+
+  /** \brief ring buffer of entries and MARKs, oldest first
+   *
+   *  Its size is a power of two.
+   */
+  std::vector<Entry> m_queue;
+  size_t m_queueHead;
+  size_t m_queueSize;
+
+  /** \brief hashtable of entries other than MARKs
+   *
+   *  Its size is twice the size of m_queue. Since an Entry is a hash, it is used as
+   *  the bucket index directly. MARK designates an empty bucket.
+   */
+  std::vector<Entry> m_ht;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
 
@@ -185,12 +212,17 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity contr
    */
   static const size_t EXPECTED_MARK_COUNT;
 
-  /** \brief number of MARKs in the index after each MARK insertion
+  /** \brief number of MARKs in the index
+   */
+  size_t m_nMarks;
+
+  /** \brief minimum and maximum number of MARKs in the index after each MARK insertion
    *
-   *  adjustCapacity uses this to determine whether and how to adjust capcity,
-   *  and then clears this list.
+   *  adjustCapacity uses these to determine whether and how to adjust capcity,
+   *  and then resets them.
    */
-  std::multiset<size_t> m_actualMarkCounts;
+  size_t m_minMarkCount;
+  size_t m_maxMarkCount;
 
   time::nanoseconds m_markInterval;
 
@@ -35,6 +35,7 @@ using measurements::Entry;
 Measurements::Measurements(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_entryPool(make_shared<MemoryPool>())
 {
 }
 
@@ -45,7 +46,7 @@ Measurements::get(name_tree::Entry& nte)
   if (entry != nullptr)
     return entry;
 
-  entry = make_shared<Entry>(nte.getPrefix());
+  entry = std::allocate_shared<Entry>(PoolAllocator<Entry>(m_entryPool), nte.getPrefix());
   nte.setMeasurementsEntry(entry);
   ++m_nItems;
 
@@ -131,6 +131,11 @@ public:
   size_t
   size() const;
 
+  /** \return the pool that entries are allocated from
+   */
+  const MemoryPool&
+  getEntryPool() const;
+
 private:
   void
   cleanup(measurements::Entry& entry);
@@ -147,6 +152,7 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  shared_ptr<MemoryPool> m_entryPool;
 };
 
 inline time::nanoseconds
@@ -161,6 +167,12 @@ Measurements::size() const
   return m_nItems;
 }
 
+inline const MemoryPool&
+Measurements::getEntryPool() const
+{
+  return *m_entryPool;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_TABLE_MEASUREMENTS_HPP
@@ -36,17 +36,15 @@ Node::Node()
 
 Node::~Node()
 {
-  // erase the Name Tree Nodes that were created to
-  // resolve hash collisions
-  // So before erasing a single node, make sure its m_next == 0
-  // See eraseEntryIfEmpty in name-tree.cpp
-  if (m_next != 0)
-    delete m_next;
+  // Nodes are allocated from the Hashtable's MemoryPool,
+  // so the Hashtable destroys each Node of a collision chain
 }
 
 Entry::Entry(const Name& name)
   : m_hash(0)
   , m_prefix(name)
+  , m_effectiveStrategy(nullptr)
+  , m_strategyEpoch(0)
 {
 }
 
@@ -35,12 +35,15 @@
 namespace nfd {
 
 class NameTree;
+class StrategyChoice;
 
 namespace name_tree {
 
 // Forward declarations
 class Node;
 class Entry;
+class ChainedHashtable;
+class OpenAddressingHashtable;
 
 /**
  * \brief Name Tree Node Class
@@ -138,11 +141,19 @@ private:
   shared_ptr<measurements::Entry> m_measurementsEntry;
   shared_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
 
+  // effective strategy memoized by StrategyChoice,
+  // valid only if m_strategyEpoch equals StrategyChoice's current epoch
+  fw::Strategy* m_effectiveStrategy;
+  uint64_t m_strategyEpoch;
+
   // get the Name Tree Node that is associated with this Name Tree Entry
   Node* m_node;
 
   // Make private members accessible by Name Tree
   friend class nfd::NameTree;
+  friend class ChainedHashtable;
+  friend class OpenAddressingHashtable;
+  friend class nfd::StrategyChoice;
 };
 
 inline const Name&
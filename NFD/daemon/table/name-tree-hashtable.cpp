@@ -0,0 +1,625 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "name-tree-hashtable.hpp"
+#include "core/logger.hpp"
+
+#include <climits>
+
+namespace nfd {
+namespace name_tree {
+
+NFD_LOG_INIT("NameTreeHashtable");
+
+unique_ptr<Hashtable>
+Hashtable::create(HashtableLayout layout, size_t nBuckets)
+{
+  switch (layout) {
+  case HASHTABLE_OPEN_ADDRESSING:
+    return unique_ptr<Hashtable>(new OpenAddressingHashtable(nBuckets));
+  case HASHTABLE_CHAINED:
+  default:
+    return unique_ptr<Hashtable>(new ChainedHashtable(nBuckets));
+  }
+}
+
+Hashtable::Hashtable()
+  : m_nItems(0)
+{
+}
+
+Hashtable::~Hashtable()
+{
+}
+
+const MemoryPool*
+Hashtable::getNodePool() const
+{
+  return nullptr;
+}
+
+ChainedHashtable::ChainedHashtable(size_t nBuckets)
+  : m_nBuckets(nBuckets)
+  , m_minNBuckets(nBuckets)
+  , m_enlargeLoadFactor(0.5)       // more than 50% buckets loaded
+  , m_enlargeFactor(2)       // double the hash table size
+  , m_shrinkLoadFactor(0.1) // less than 10% buckets loaded
+  , m_shrinkFactor(0.5)     // reduce the number of buckets by half
+  , m_nodePool(sizeof(Node))
+{
+  m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
+                                          static_cast<double>(m_nBuckets));
+
+  m_shrinkThreshold = static_cast<size_t>(m_shrinkLoadFactor *
+                                          static_cast<double>(m_nBuckets));
+
+  // array of node pointers
+  m_buckets = new Node*[m_nBuckets];
+  // Initialize the pointer array
+  for (size_t i = 0; i < m_nBuckets; i++)
+    m_buckets[i] = 0;
+}
+
+ChainedHashtable::~ChainedHashtable()
+{
+  for (size_t i = 0; i < m_nBuckets; i++)
+    {
+      Node* node = m_buckets[i];
+      while (node != 0) {
+        Node* next = node->m_next;
+        destroyNode(node);
+        node = next;
+      }
+    }
+
+  delete [] m_buckets;
+}
+
+Node*
+ChainedHashtable::makeNode()
+{
+  return new (m_nodePool.allocate(sizeof(Node))) Node();
+}
+
+void
+ChainedHashtable::destroyNode(Node* node)
+{
+  node->~Node();
+  m_nodePool.deallocate(node);
+}
+
+const MemoryPool*
+ChainedHashtable::getNodePool() const
+{
+  return &m_nodePool;
+}
+
+size_t
+ChainedHashtable::getNBuckets() const
+{
+  return m_nBuckets;
+}
+
+shared_ptr<Entry>
+ChainedHashtable::find(const Name& name, size_t prefixLen, size_t hashValue) const
+{
+  size_t loc = hashValue % m_nBuckets;
+
+  for (Node* node = m_buckets[loc]; node != 0; node = node->m_next)
+    {
+      const shared_ptr<Entry>& entry = node->m_entry;
+      if (static_cast<bool>(entry))
+        {
+          // isPrefixOf() is used to avoid making a copy of the name
+          if (hashValue == entry->m_hash &&
+              entry->m_prefix.size() == prefixLen &&
+              entry->m_prefix.isPrefixOf(name))
+            {
+              return entry;
+            }
+        } // if entry
+    } // for node
+
+  return nullptr;
+}
+
+void
+ChainedHashtable::insert(shared_ptr<Entry> entry)
+{
+  size_t loc = entry->m_hash % m_nBuckets;
+
+  // find the last node of the bucket
+  Node* nodePrev = 0;
+  for (Node* node = m_buckets[loc]; node != 0; node = node->m_next)
+    {
+      nodePrev = node;
+    }
+
+  // create a new node, and link it from nodePrev
+  Node* node = makeNode();
+  node->m_prev = nodePrev;
+
+  if (nodePrev == 0)
+    {
+      m_buckets[loc] = node;
+    }
+  else
+    {
+      nodePrev->m_next = node;
+    }
+
+  node->m_entry = entry; // link the Entry to its Node
+  entry->m_node = node; // link the node to Entry. Used in erase.
+
+  m_nItems++;
+
+  if (m_nItems > m_enlargeThreshold)
+    {
+      resize(m_enlargeFactor * m_nBuckets);
+    }
+}
+
+void
+ChainedHashtable::erase(Entry& entry)
+{
+  // remove this Entry and its Name Tree Node
+  Node* node = entry.m_node;
+  Node* nodePrev = node->m_prev;
+
+  // configure the previous node
+  if (nodePrev != 0)
+    {
+      // link the previous node to the next node
+      nodePrev->m_next = node->m_next;
+    }
+  else
+    {
+      m_buckets[entry.m_hash % m_nBuckets] = node->m_next;
+    }
+
+  // link the previous node with the next node (skip the erased one)
+  if (node->m_next != 0)
+    {
+      node->m_next->m_prev = nodePrev;
+      node->m_next = 0;
+    }
+
+  BOOST_ASSERT(node->m_next == 0);
+
+  m_nItems--;
+  entry.m_node = 0;
+  destroyNode(node);
+
+  size_t newNBuckets = static_cast<size_t>(m_shrinkFactor *
+                                           static_cast<double>(m_nBuckets));
+
+  if (newNBuckets >= m_minNBuckets && m_nItems < m_shrinkThreshold)
+    {
+      resize(newNBuckets);
+    }
+}
+
+shared_ptr<Entry>
+ChainedHashtable::getFirstInBuckets(size_t first) const
+{
+  for (size_t i = first; i < m_nBuckets; i++)
+    {
+      if (m_buckets[i] != 0)
+        {
+          return m_buckets[i]->m_entry;
+        }
+    }
+  return nullptr;
+}
+
+shared_ptr<Entry>
+ChainedHashtable::getFirst() const
+{
+  return getFirstInBuckets(0);
+}
+
+shared_ptr<Entry>
+ChainedHashtable::getNext(const Entry& entry) const
+{
+  // process the entries in the same bucket first
+  if (entry.m_node->m_next != 0)
+    {
+      return entry.m_node->m_next->m_entry;
+    }
+
+  // process other buckets
+  return getFirstInBuckets(entry.m_hash % m_nBuckets + 1);
+}
+
+// Hash Table Resize
+void
+ChainedHashtable::resize(size_t newNBuckets)
+{
+  NFD_LOG_TRACE("resize");
+
+  Node** newBuckets = new Node*[newNBuckets];
+  size_t count = 0;
+
+  // referenced ccnx hashtb.c hashtb_rehash()
+  Node** pp = 0;
+  Node* p = 0;
+  Node* pre = 0;
+  Node* q = 0; // record p->m_next
+  size_t i;
+  uint32_t h;
+  uint32_t b;
+
+  for (i = 0; i < newNBuckets; i++)
+    {
+      newBuckets[i] = 0;
+    }
+
+  for (i = 0; i < m_nBuckets; i++)
+    {
+      for (p = m_buckets[i]; p != 0; p = q)
+        {
+          count++;
+          q = p->m_next;
+          BOOST_ASSERT(static_cast<bool>(p->m_entry));
+          h = p->m_entry->m_hash;
+          b = h % newNBuckets;
+          pre = 0;
+          for (pp = &newBuckets[b]; *pp != 0; pp = &((*pp)->m_next))
+            {
+              pre = *pp;
+              continue;
+            }
+          p->m_prev = pre;
+          p->m_next = *pp; // Actually *pp always == 0 in this case
+          *pp = p;
+        }
+    }
+
+  BOOST_ASSERT(count == m_nItems);
+
+  Node** oldBuckets = m_buckets;
+  m_buckets = newBuckets;
+  delete [] oldBuckets;
+
+  m_nBuckets = newNBuckets;
+
+  m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
+                                              static_cast<double>(m_nBuckets));
+  m_shrinkThreshold = static_cast<size_t>(m_shrinkLoadFactor *
+                                              static_cast<double>(m_nBuckets));
+}
+
+/** \brief the maximum fraction of used home slots before resizing
+ */
+static const double MAX_LOAD_FACTOR = 0.75;
+
+/** \brief the fraction of used home slots under which the slot array shrinks by half
+ */
+static const double SHRINK_LOAD_FACTOR = 0.1;
+
+/** \brief the number of old slots migrated per insertion or erasure during a resize
+ * \note This must be large enough for the migration to complete before the new slot
+ *       array fills up, see resizeIfNeeded().
+ */
+static const size_t MIGRATE_STEP = 8;
+
+/** \brief the number of slots past the home slots that are allocated at once
+ *         for probe sequences running off the end of the slot array
+ */
+static const size_t OVERFLOW_SLOTS = 16;
+
+static size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t p = 1;
+  while (p < n) {
+    p <<= 1;
+  }
+  return p;
+}
+
+/** \brief compare two entries in enumeration order, i.e., by hash value, then by address
+ */
+static bool
+isBefore(size_t hash1, const Entry* entry1, size_t hash2, const Entry* entry2)
+{
+  return hash1 < hash2 || (hash1 == hash2 && std::less<const Entry*>()(entry1, entry2));
+}
+
+OpenAddressingHashtable::Slot::Slot()
+  : hash(0)
+{
+}
+
+inline bool
+OpenAddressingHashtable::Slot::isEmpty() const
+{
+  return entry == nullptr;
+}
+
+OpenAddressingHashtable::Table::Table()
+  : nHomeSlots(0)
+  , shift(0)
+  , nEntries(0)
+{
+}
+
+OpenAddressingHashtable::Table::Table(size_t nHomeSlots)
+  : slots(nHomeSlots + OVERFLOW_SLOTS)
+  , nHomeSlots(nHomeSlots)
+  , shift(sizeof(size_t) * CHAR_BIT)
+  , nEntries(0)
+{
+  BOOST_ASSERT(nHomeSlots >= 2 && (nHomeSlots & (nHomeSlots - 1)) == 0);
+  for (size_t n = nHomeSlots; n > 1; n >>= 1) {
+    --shift;
+  }
+}
+
+inline size_t
+OpenAddressingHashtable::Table::getHome(size_t hashValue) const
+{
+  return hashValue >> shift;
+}
+
+OpenAddressingHashtable::OpenAddressingHashtable(size_t nBuckets)
+  : m_minNSlots(roundUpToPowerOfTwo(std::max<size_t>(nBuckets, 2)))
+  , m_table(m_minNSlots)
+  , m_migratePos(0)
+{
+}
+
+size_t
+OpenAddressingHashtable::getNBuckets() const
+{
+  return m_table.nHomeSlots;
+}
+
+const OpenAddressingHashtable::Slot*
+OpenAddressingHashtable::findSlot(const Table& table, size_t begin, const Name& name,
+                                  size_t prefixLen, size_t hashValue)
+{
+  for (size_t i = std::max(table.getHome(hashValue), begin); i < table.slots.size(); ++i) {
+    const Slot& slot = table.slots[i];
+    // the probe sequence is sorted by hash value
+    if (slot.isEmpty() || slot.hash > hashValue) {
+      return nullptr;
+    }
+    if (slot.hash == hashValue) {
+      // isPrefixOf() is used to avoid making a copy of the name
+      const Name& entryPrefix = slot.entry->m_prefix;
+      if (entryPrefix.size() == prefixLen && entryPrefix.isPrefixOf(name)) {
+        return &slot;
+      }
+    }
+  }
+  return nullptr;
+}
+
+OpenAddressingHashtable::Slot*
+OpenAddressingHashtable::findSlot(Table& table, size_t begin, const Entry& entry)
+{
+  for (size_t i = std::max(table.getHome(entry.m_hash), begin); i < table.slots.size(); ++i) {
+    Slot& slot = table.slots[i];
+    if (slot.isEmpty() || slot.hash > entry.m_hash) {
+      return nullptr;
+    }
+    if (slot.entry.get() == &entry) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+void
+OpenAddressingHashtable::insertSlot(Table& table, size_t hashValue, shared_ptr<Entry> entry)
+{
+  // find the position of the entry in the sorted probe sequence
+  size_t pos = table.getHome(hashValue);
+  while (pos < table.slots.size() && !table.slots[pos].isEmpty() &&
+         isBefore(table.slots[pos].hash, table.slots[pos].entry.get(), hashValue, entry.get())) {
+    ++pos;
+  }
+
+  // shift the rest of the probe sequence forward by one slot
+  size_t end = pos;
+  while (end < table.slots.size() && !table.slots[end].isEmpty()) {
+    ++end;
+  }
+  if (end == table.slots.size()) {
+    // grow the capacity geometrically, so that repeated overflows are amortized
+    size_t nSlots = table.slots.size() + OVERFLOW_SLOTS;
+    if (nSlots > table.slots.capacity()) {
+      table.slots.reserve(std::max(nSlots, table.slots.capacity() * 2));
+    }
+    table.slots.resize(nSlots);
+  }
+  std::move_backward(table.slots.begin() + pos, table.slots.begin() + end,
+                     table.slots.begin() + end + 1);
+
+  table.slots[pos].hash = hashValue;
+  table.slots[pos].entry = std::move(entry);
+  ++table.nEntries;
+}
+
+void
+OpenAddressingHashtable::eraseSlot(Table& table, size_t pos)
+{
+  // shift the rest of the probe sequence back by one slot, except for entries
+  // that are already in their home slot
+  size_t hole = pos;
+  for (size_t i = pos + 1; i < table.slots.size(); ++i) {
+    Slot& slot = table.slots[i];
+    if (slot.isEmpty() || table.getHome(slot.hash) > hole) {
+      break;
+    }
+    table.slots[hole] = std::move(slot);
+    hole = i;
+  }
+
+  table.slots[hole].hash = 0;
+  table.slots[hole].entry.reset();
+  --table.nEntries;
+}
+
+shared_ptr<Entry>
+OpenAddressingHashtable::find(const Name& name, size_t prefixLen, size_t hashValue) const
+{
+  const Slot* slot = findSlot(m_table, 0, name, prefixLen, hashValue);
+  if (slot == nullptr) {
+    slot = findSlot(m_oldTable, m_migratePos, name, prefixLen, hashValue);
+  }
+  return slot == nullptr ? nullptr : slot->entry;
+}
+
+void
+OpenAddressingHashtable::insert(shared_ptr<Entry> entry)
+{
+  migrate(MIGRATE_STEP);
+  resizeIfNeeded();
+
+  size_t hashValue = entry->m_hash;
+  insertSlot(m_table, hashValue, std::move(entry));
+  m_nItems++;
+}
+
+void
+OpenAddressingHashtable::erase(Entry& entry)
+{
+  Table* table = &m_table;
+  Slot* slot = findSlot(m_table, 0, entry);
+  if (slot == nullptr) {
+    table = &m_oldTable;
+    slot = findSlot(m_oldTable, m_migratePos, entry);
+  }
+  BOOST_ASSERT(slot != nullptr);
+
+  eraseSlot(*table, slot - &table->slots.front());
+  m_nItems--;
+
+  migrate(MIGRATE_STEP);
+  resizeIfNeeded();
+}
+
+const OpenAddressingHashtable::Slot*
+OpenAddressingHashtable::findNextSlot(const Table& table, size_t begin,
+                                      size_t hashValue, const Entry* entry)
+{
+  // The slot array is sorted, and an entry is never stored before its home slot,
+  // so that every entry that comes after (hashValue, entry) is stored after
+  // the home slot of hashValue.
+  for (size_t i = std::max(table.getHome(hashValue), begin); i < table.slots.size(); ++i) {
+    const Slot& slot = table.slots[i];
+    if (!slot.isEmpty() && isBefore(hashValue, entry, slot.hash, slot.entry.get())) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+shared_ptr<Entry>
+OpenAddressingHashtable::getFirstOf(const Slot* slot1, const Slot* slot2)
+{
+  if (slot1 == nullptr || slot2 == nullptr) {
+    const Slot* slot = slot1 == nullptr ? slot2 : slot1;
+    return slot == nullptr ? nullptr : slot->entry;
+  }
+  return isBefore(slot1->hash, slot1->entry.get(), slot2->hash, slot2->entry.get()) ?
+         slot1->entry : slot2->entry;
+}
+
+shared_ptr<Entry>
+OpenAddressingHashtable::getFirst() const
+{
+  // (0, nullptr) comes before every entry
+  return getFirstOf(findNextSlot(m_oldTable, m_migratePos, 0, nullptr),
+                    findNextSlot(m_table, 0, 0, nullptr));
+}
+
+shared_ptr<Entry>
+OpenAddressingHashtable::getNext(const Entry& entry) const
+{
+  return getFirstOf(findNextSlot(m_oldTable, m_migratePos, entry.m_hash, &entry),
+                    findNextSlot(m_table, 0, entry.m_hash, &entry));
+}
+
+void
+OpenAddressingHashtable::startResize(size_t nSlots)
+{
+  NFD_LOG_TRACE("startResize " << m_table.nHomeSlots << " -> " << nSlots);
+  BOOST_ASSERT(!isResizing());
+
+  m_oldTable = std::move(m_table);
+  m_table = Table(nSlots);
+  m_migratePos = 0;
+}
+
+void
+OpenAddressingHashtable::migrate(size_t nSlots)
+{
+  if (!isResizing()) {
+    return;
+  }
+
+  size_t end = std::min(m_migratePos + nSlots, m_oldTable.slots.size());
+  for (; m_migratePos < end; ++m_migratePos) {
+    Slot& slot = m_oldTable.slots[m_migratePos];
+    if (!slot.isEmpty()) {
+      // entries after this slot are still found, because lookups in the old slot array
+      // start at m_migratePos
+      insertSlot(m_table, slot.hash, std::move(slot.entry));
+      slot.entry.reset();
+      --m_oldTable.nEntries;
+    }
+  }
+
+  if (m_oldTable.nEntries == 0) {
+    NFD_LOG_TRACE("resize completed");
+    m_oldTable = Table();
+    m_migratePos = 0;
+  }
+}
+
+void
+OpenAddressingHashtable::resizeIfNeeded()
+{
+  size_t nSlots = m_table.nHomeSlots;
+  size_t nUsed = m_table.nEntries;
+
+  if (static_cast<double>(nUsed + 1) > MAX_LOAD_FACTOR * static_cast<double>(nSlots)) {
+    // Migration has not kept up with insertions: complete it before starting another resize.
+    migrate(m_oldTable.slots.size());
+    startResize(nSlots * 2);
+    return;
+  }
+
+  if (!isResizing() && nSlots / 2 >= m_minNSlots &&
+      static_cast<double>(m_nItems) < SHRINK_LOAD_FACTOR * static_cast<double>(nSlots)) {
+    startResize(nSlots / 2);
+  }
+}
+
+} // namespace name_tree
+} // namespace nfd
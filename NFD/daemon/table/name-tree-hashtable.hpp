@@ -0,0 +1,338 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_NAME_TREE_HASHTABLE_HPP
+#define NFD_DAEMON_TABLE_NAME_TREE_HASHTABLE_HPP
+
+#include "name-tree-entry.hpp"
+#include "core/memory-pool.hpp"
+
+namespace nfd {
+namespace name_tree {
+
+/**
+ * \brief Layout of the hash table that indexes Name Tree Entries
+ */
+enum HashtableLayout {
+  /**
+   * \brief An array of buckets; colliding entries are chained in linked lists of Nodes.
+   * The table is rehashed at once when it is resized.
+   */
+  HASHTABLE_CHAINED,
+  /**
+   * \brief A flat array of slots, each storing an entry's hash value next to the entry
+   * pointer, with linear probing. The table is rehashed incrementally when it is resized.
+   */
+  HASHTABLE_OPEN_ADDRESSING
+};
+
+/**
+ * \brief The hash table used by Name Tree
+ * \details Each entry is identified by its prefix and the hash value of that prefix.
+ * A prefix is given as a name and the number of its leading components, so that
+ * a lookup does not need to make a copy of the prefix.
+ */
+class Hashtable : noncopyable
+{
+public:
+  static unique_ptr<Hashtable>
+  create(HashtableLayout layout, size_t nBuckets);
+
+  virtual
+  ~Hashtable();
+
+  /**
+   * \brief Get the number of entries stored in the table
+   */
+  size_t
+  size() const;
+
+  /**
+   * \brief Get the number of buckets (or slots) in the table
+   */
+  virtual size_t
+  getNBuckets() const = 0;
+
+  /**
+   * \brief Find the entry of a name prefix
+   * \param name a name
+   * \param prefixLen the number of leading components of \p name that make up the prefix
+   * \param hashValue the hash value of the prefix
+   * \return the entry, or nullptr if the prefix is not in the table
+   */
+  virtual shared_ptr<Entry>
+  find(const Name& name, size_t prefixLen, size_t hashValue) const = 0;
+
+  /**
+   * \brief Add an entry to the table
+   * \pre the entry's prefix is not in the table, and the entry's hash value is set
+   */
+  virtual void
+  insert(shared_ptr<Entry> entry) = 0;
+
+  /**
+   * \brief Remove an entry from the table
+   * \pre the entry is in the table
+   */
+  virtual void
+  erase(Entry& entry) = 0;
+
+  /**
+   * \brief Get the first entry in enumeration order
+   * \return the entry, or nullptr if the table is empty
+   */
+  virtual shared_ptr<Entry>
+  getFirst() const = 0;
+
+  /**
+   * \brief Get the entry after \p entry in enumeration order
+   * \return the entry, or nullptr if \p entry is the last one
+   */
+  virtual shared_ptr<Entry>
+  getNext(const Entry& entry) const = 0;
+
+  /**
+   * \brief Get the pool that Nodes are allocated from
+   * \return the pool, or nullptr if the layout does not use Nodes
+   */
+  virtual const MemoryPool*
+  getNodePool() const;
+
+protected:
+  Hashtable();
+
+protected:
+  size_t m_nItems;
+};
+
+inline size_t
+Hashtable::size() const
+{
+  return m_nItems;
+}
+
+/**
+ * \brief A hash table that resolves collisions by chaining
+ */
+class ChainedHashtable : public Hashtable
+{
+public:
+  explicit
+  ChainedHashtable(size_t nBuckets);
+
+  virtual
+  ~ChainedHashtable();
+
+  virtual size_t
+  getNBuckets() const DECL_OVERRIDE;
+
+  virtual shared_ptr<Entry>
+  find(const Name& name, size_t prefixLen, size_t hashValue) const DECL_OVERRIDE;
+
+  virtual void
+  insert(shared_ptr<Entry> entry) DECL_OVERRIDE;
+
+  virtual void
+  erase(Entry& entry) DECL_OVERRIDE;
+
+  virtual shared_ptr<Entry>
+  getFirst() const DECL_OVERRIDE;
+
+  virtual shared_ptr<Entry>
+  getNext(const Entry& entry) const DECL_OVERRIDE;
+
+  virtual const MemoryPool*
+  getNodePool() const DECL_OVERRIDE;
+
+private:
+  Node*
+  makeNode();
+
+  void
+  destroyNode(Node* node);
+
+  /**
+   * \brief Resize the hash table size when its load factor reaches a threshold.
+   * \param newNBuckets The number of buckets for the new hash table.
+   */
+  void
+  resize(size_t newNBuckets);
+
+  shared_ptr<Entry>
+  getFirstInBuckets(size_t first) const;
+
+private:
+  size_t m_nBuckets; // Number of hash buckets
+  size_t m_minNBuckets; // Minimum number of hash buckets
+  double m_enlargeLoadFactor;
+  size_t m_enlargeThreshold;
+  int m_enlargeFactor;
+  double m_shrinkLoadFactor;
+  size_t m_shrinkThreshold;
+  double m_shrinkFactor;
+  Node** m_buckets; // Name Tree Buckets in the NPHT
+  MemoryPool m_nodePool;
+};
+
+/**
+ * \brief An open-addressed hash table with ordered linear probing and incremental resize
+ * \details Each slot stores an entry's hash value next to the entry pointer, so that
+ * a probe compares hash values within a contiguous array, and only dereferences the
+ * entry pointer to compare the prefix when the hash values are equal.
+ *
+ * The home slot of an entry is given by the high-order bits of its hash value, and
+ * each probe sequence is kept sorted, so that the whole slot array is sorted by hash
+ * value. Probing does not wrap around; slots are appended past the end of the array
+ * when needed. Erasing an entry shifts the rest of its probe sequence back by one slot.
+ *
+ * When the table needs to grow or shrink, a new slot array is allocated, and entries
+ * are migrated from the old array a few slots at a time during subsequent insertions
+ * and erasures. Until the migration completes, lookups probe both arrays.
+ *
+ * Entries are enumerated in the order of their hash values, merging both arrays during
+ * a migration. This order does not depend on the slot array size, so that insertions,
+ * erasures, and migration do not cause an enumeration to skip or revisit other entries.
+ */
+class OpenAddressingHashtable : public Hashtable
+{
+public:
+  /**
+   * \param nBuckets the minimum number of slots, rounded up to a power of two
+   */
+  explicit
+  OpenAddressingHashtable(size_t nBuckets);
+
+  virtual size_t
+  getNBuckets() const DECL_OVERRIDE;
+
+  virtual shared_ptr<Entry>
+  find(const Name& name, size_t prefixLen, size_t hashValue) const DECL_OVERRIDE;
+
+  virtual void
+  insert(shared_ptr<Entry> entry) DECL_OVERRIDE;
+
+  virtual void
+  erase(Entry& entry) DECL_OVERRIDE;
+
+  virtual shared_ptr<Entry>
+  getFirst() const DECL_OVERRIDE;
+
+  /**
+   * \note \p entry does not need to be in the table anymore, so that an enumeration
+   *       can continue after erasing the current entry.
+   */
+  virtual shared_ptr<Entry>
+  getNext(const Entry& entry) const DECL_OVERRIDE;
+
+  /**
+   * \return whether entries are being migrated to a resized slot array
+   */
+  bool
+  isResizing() const;
+
+private:
+  struct Slot
+  {
+    Slot();
+
+    bool
+    isEmpty() const;
+
+    size_t hash;
+    shared_ptr<Entry> entry;
+  };
+
+  struct Table
+  {
+    Table();
+
+    explicit
+    Table(size_t nHomeSlots);
+
+    size_t
+    getHome(size_t hashValue) const;
+
+    std::vector<Slot> slots;
+    size_t nHomeSlots; // power of two, slots past nHomeSlots only hold displaced entries
+    size_t shift; // home slot index is hashValue >> shift
+    size_t nEntries;
+  };
+
+  static const Slot*
+  findSlot(const Table& table, size_t begin, const Name& name, size_t prefixLen,
+           size_t hashValue);
+
+  static Slot*
+  findSlot(Table& table, size_t begin, const Entry& entry);
+
+  static void
+  insertSlot(Table& table, size_t hashValue, shared_ptr<Entry> entry);
+
+  static void
+  eraseSlot(Table& table, size_t pos);
+
+  /** \brief find the first entry after \p hashValue and \p entry in enumeration order
+   *  \param begin the first slot of \p table that may hold an entry
+   */
+  static const Slot*
+  findNextSlot(const Table& table, size_t begin, size_t hashValue, const Entry* entry);
+
+  /** \brief choose the slot of two candidates that comes first in enumeration order
+   */
+  static shared_ptr<Entry>
+  getFirstOf(const Slot* slot1, const Slot* slot2);
+
+  /** \brief start migrating entries to a new slot array of \p nSlots slots
+   */
+  void
+  startResize(size_t nSlots);
+
+  /** \brief migrate up to \p nSlots slots of the old slot array
+   */
+  void
+  migrate(size_t nSlots);
+
+  /** \brief start a resize if the load of the current slot array calls for one
+   */
+  void
+  resizeIfNeeded();
+
+private:
+  size_t m_minNSlots;
+  Table m_table; // current slot array, receives all insertions
+  Table m_oldTable; // slot array being migrated, empty unless resizing
+  size_t m_migratePos; // next slot of m_oldTable to migrate, all slots before it are empty
+};
+
+inline bool
+OpenAddressingHashtable::isResizing() const
+{
+  return !m_oldTable.slots.empty();
+}
+
+} // namespace name_tree
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_NAME_TREE_HASHTABLE_HPP
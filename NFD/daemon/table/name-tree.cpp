@@ -111,91 +111,54 @@ computeHashSet(const Name& prefix)
   return hashValueSet;
 }
 
-} // namespace name_tree
+HashSetTag::HashSetTag(const Name& name)
+  : m_nameWire(name.wireEncode())
+  , m_hashSet(computeHashSet(name))
+{
+}
 
-NameTree::NameTree(size_t nBuckets)
-  : m_nItems(0)
-  , m_nBuckets(nBuckets)
-  , m_minNBuckets(nBuckets)
-  , m_enlargeLoadFactor(0.5)       // more than 50% buckets loaded
-  , m_enlargeFactor(2)       // double the hash table size
-  , m_shrinkLoadFactor(0.1) // less than 10% buckets loaded
-  , m_shrinkFactor(0.5)     // reduce the number of buckets by half
-  , m_endIterator(FULL_ENUMERATE_TYPE, *this, m_end)
+bool
+HashSetTag::isValidFor(const Name& name) const
 {
-  m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
-                                          static_cast<double>(m_nBuckets));
+  // a Name shares its wire buffer with its copies, and gets a new one once modified
+  return name.wireEncode().wire() == m_nameWire.wire();
+}
 
-  m_shrinkThreshold = static_cast<size_t>(m_shrinkLoadFactor *
-                                          static_cast<double>(m_nBuckets));
+} // namespace name_tree
 
-  // array of node pointers
-  m_buckets = new name_tree::Node*[m_nBuckets];
-  // Initialize the pointer array
-  for (size_t i = 0; i < m_nBuckets; i++)
-    m_buckets[i] = 0;
+NameTree::NameTree(size_t nBuckets, name_tree::HashtableLayout layout)
+  : m_entryPool(make_shared<MemoryPool>())
+  , m_table(name_tree::Hashtable::create(layout, nBuckets))
+  , m_endIterator(FULL_ENUMERATE_TYPE, *this, m_end)
+{
 }
 
 NameTree::~NameTree()
 {
-  for (size_t i = 0; i < m_nBuckets; i++)
-    {
-      if (m_buckets[i] != 0) {
-        delete m_buckets[i];
-      }
-    }
-
-  delete [] m_buckets;
 }
 
 // insert() is a private function, and called by only lookup()
 std::pair<shared_ptr<name_tree::Entry>, bool>
-NameTree::insert(const Name& prefix)
+NameTree::insert(const Name& name, size_t prefixLen, size_t hashValue)
 {
-  NFD_LOG_TRACE("insert " << prefix);
-
-  size_t hashValue = name_tree::computeHash(prefix);
-  size_t loc = hashValue % m_nBuckets;
-
-  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue << "  location = " << loc);
+  NFD_LOG_TRACE("insert " << name << " prefixLen = " << prefixLen <<
+                " hash value = " << hashValue);
 
   // Check if this Name has been stored
-  name_tree::Node* node = m_buckets[loc];
-  name_tree::Node* nodePrev = node;  // initialize nodePrev to node
-
-  for (node = m_buckets[loc]; node != 0; node = node->m_next)
+  shared_ptr<name_tree::Entry> entry = m_table->find(name, prefixLen, hashValue);
+  if (static_cast<bool>(entry))
     {
-      if (static_cast<bool>(node->m_entry))
-        {
-          if (prefix == node->m_entry->m_prefix)
-            {
-              return std::make_pair(node->m_entry, false); // false: old entry
-            }
-        }
-      nodePrev = node;
+      return std::make_pair(entry, false); // false: old entry
     }
 
-  NFD_LOG_TRACE("Did not find " << prefix << ", need to insert it to the table");
-
-  // If no bucket is empty occupied, we need to create a new node, and it is
-  // linked from nodePrev
-  node = new name_tree::Node();
-  node->m_prev = nodePrev;
-
-  if (nodePrev == 0)
-    {
-      m_buckets[loc] = node;
-    }
-  else
-    {
-      nodePrev->m_next = node;
-    }
+  NFD_LOG_TRACE("Did not find " << name << " prefixLen = " << prefixLen <<
+                ", need to insert it to the table");
 
   // Create a new Entry
-  shared_ptr<name_tree::Entry> entry(make_shared<name_tree::Entry>(prefix));
+  entry = std::allocate_shared<name_tree::Entry>(PoolAllocator<name_tree::Entry>(m_entryPool),
+                                                 name.getPrefix(prefixLen));
   entry->setHash(hashValue);
-  node->m_entry = entry; // link the Entry to its Node
-  entry->m_node = node; // link the node to Entry. Used in eraseEntryIfEmpty.
+  m_table->insert(entry);
 
   return std::make_pair(entry, true); // true: new entry
 }
@@ -203,23 +166,27 @@ NameTree::insert(const Name& prefix)
 // Name Prefix Lookup. Create Name Tree Entry if not found
 shared_ptr<name_tree::Entry>
 NameTree::lookup(const Name& prefix)
+{
+  return lookup(prefix, name_tree::computeHashSet(prefix));
+}
+
+shared_ptr<name_tree::Entry>
+NameTree::lookup(const Name& prefix, const std::vector<size_t>& hashSet)
 {
   NFD_LOG_TRACE("lookup " << prefix);
+  BOOST_ASSERT(hashSet.size() == prefix.size() + 1);
 
   shared_ptr<name_tree::Entry> entry;
   shared_ptr<name_tree::Entry> parent;
 
   for (size_t i = 0; i <= prefix.size(); i++)
     {
-      Name temp = prefix.getPrefix(i);
-
       // insert() will create the entry if it does not exist.
-      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(temp);
+      std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(prefix, i, hashSet[i]);
       entry = ret.first;
 
       if (ret.second == true)
         {
-          m_nItems++; // Increase the counter
           entry->m_parent = parent;
 
           if (static_cast<bool>(parent))
@@ -228,11 +195,6 @@ NameTree::lookup(const Name& prefix)
             }
         }
 
-      if (m_nItems > m_enlargeThreshold)
-        {
-          resize(m_enlargeFactor * m_nBuckets);
-        }
-
       parent = entry;
     }
   return entry;
@@ -242,71 +204,43 @@ NameTree::lookup(const Name& prefix)
 shared_ptr<name_tree::Entry>
 NameTree::findExactMatch(const Name& prefix) const
 {
-  NFD_LOG_TRACE("findExactMatch " << prefix);
-
-  size_t hashValue = name_tree::computeHash(prefix);
-  size_t loc = hashValue % m_nBuckets;
-
-  NFD_LOG_TRACE("Name " << prefix << " hash value = " << hashValue <<
-                "  location = " << loc);
-
-  shared_ptr<name_tree::Entry> entry;
-  name_tree::Node* node = 0;
+  return findExactMatch(prefix, name_tree::computeHash(prefix));
+}
 
-  for (node = m_buckets[loc]; node != 0; node = node->m_next)
-    {
-      entry = node->m_entry;
-      if (static_cast<bool>(entry))
-        {
-          if (hashValue == entry->getHash() && prefix == entry->getPrefix())
-            {
-              return entry;
-            }
-        } // if entry
-    } // for node
+shared_ptr<name_tree::Entry>
+NameTree::findExactMatch(const Name& prefix, size_t hashValue) const
+{
+  NFD_LOG_TRACE("findExactMatch " << prefix << " hash value = " << hashValue);
 
-  // if not found, the default value of entry (null pointer) will be returned
-  entry.reset();
-  return entry;
+  // if not found, a null pointer will be returned
+  return m_table->find(prefix, prefix.size(), hashValue);
 }
 
 // Longest Prefix Match
 shared_ptr<name_tree::Entry>
 NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::EntrySelector& entrySelector) const
 {
-  NFD_LOG_TRACE("findLongestPrefixMatch " << prefix);
-
-  shared_ptr<name_tree::Entry> entry;
-  std::vector<size_t> hashValueSet = name_tree::computeHashSet(prefix);
+  return findLongestPrefixMatch(prefix, name_tree::computeHashSet(prefix), entrySelector);
+}
 
-  size_t hashValue = 0;
-  size_t loc = 0;
+shared_ptr<name_tree::Entry>
+NameTree::findLongestPrefixMatch(const Name& prefix, const std::vector<size_t>& hashValueSet,
+                                 const name_tree::EntrySelector& entrySelector) const
+{
+  NFD_LOG_TRACE("findLongestPrefixMatch " << prefix);
+  BOOST_ASSERT(hashValueSet.size() == prefix.size() + 1);
 
   for (int i = static_cast<int>(prefix.size()); i >= 0; i--)
     {
-      hashValue = hashValueSet[i];
-      loc = hashValue % m_nBuckets;
-
-      name_tree::Node* node = 0;
-      for (node = m_buckets[loc]; node != 0; node = node->m_next)
+      shared_ptr<name_tree::Entry> entry = m_table->find(prefix, i, hashValueSet[i]);
+      if (static_cast<bool>(entry) && entrySelector(*entry))
         {
-          entry = node->m_entry;
-          if (static_cast<bool>(entry))
-            {
-              // isPrefixOf() is used to avoid making a copy of the name
-              if (hashValue == entry->getHash() &&
-                  entry->getPrefix().isPrefixOf(prefix) &&
-                  entrySelector(*entry))
-                {
-                  return entry;
-                }
-            } // if entry
-        } // for node
+          return entry;
+        }
     }
 
-  // if not found, the default value of entry (null pointer) will be returned
-  entry.reset();
-  return entry;
+  // if not found, a null pointer will be returned
+  return shared_ptr<name_tree::Entry>();
 }
 
 shared_ptr<name_tree::Entry>
@@ -357,44 +291,12 @@ NameTree::eraseEntryIfEmpty(shared_ptr<name_tree::Entry> entry)
           BOOST_VERIFY(isFound == true);
         }
 
-      // remove this Entry and its Name Tree Node
-      name_tree::Node* node = entry->m_node;
-      name_tree::Node* nodePrev = node->m_prev;
-
-      // configure the previous node
-      if (nodePrev != 0)
-        {
-          // link the previous node to the next node
-          nodePrev->m_next = node->m_next;
-        }
-      else
-        {
-          m_buckets[entry->getHash() % m_nBuckets] = node->m_next;
-        }
-
-      // link the previous node with the next node (skip the erased one)
-      if (node->m_next != 0)
-        {
-          node->m_next->m_prev = nodePrev;
-          node->m_next = 0;
-        }
-
-      BOOST_ASSERT(node->m_next == 0);
-
-      m_nItems--;
-      delete node;
+      // remove this Entry from the hash table
+      m_table->erase(*entry);
 
       if (static_cast<bool>(parent))
         eraseEntryIfEmpty(parent);
 
-      size_t newNBuckets = static_cast<size_t>(m_shrinkFactor *
-                                     static_cast<double>(m_nBuckets));
-
-      if (newNBuckets >= m_minNBuckets && m_nItems < m_shrinkThreshold)
-        {
-          resize(newNBuckets);
-        }
-
       return true;
 
     } // if this entry is empty
@@ -408,12 +310,11 @@ NameTree::fullEnumerate(const name_tree::EntrySelector& entrySelector) const
   NFD_LOG_TRACE("fullEnumerate");
 
   // find the first eligible entry
-  for (size_t i = 0; i < m_nBuckets; i++) {
-    for (name_tree::Node* node = m_buckets[i]; node != 0; node = node->m_next) {
-      if (static_cast<bool>(node->m_entry) && entrySelector(*node->m_entry)) {
-        const_iterator it(FULL_ENUMERATE_TYPE, *this, node->m_entry, entrySelector);
-        return {it, end()};
-      }
+  for (shared_ptr<name_tree::Entry> entry = m_table->getFirst();
+       static_cast<bool>(entry); entry = m_table->getNext(*entry)) {
+    if (entrySelector(*entry)) {
+      const_iterator it(FULL_ENUMERATE_TYPE, *this, entry, entrySelector);
+      return {it, end()};
     }
   }
 
@@ -453,6 +354,14 @@ NameTree::partialEnumerate(const Name& prefix,
 boost::iterator_range<NameTree::const_iterator>
 NameTree::findAllMatches(const Name& prefix,
                          const name_tree::EntrySelector& entrySelector) const
+{
+  return findAllMatches(prefix, name_tree::computeHashSet(prefix), entrySelector);
+}
+
+boost::iterator_range<NameTree::const_iterator>
+NameTree::findAllMatches(const Name& prefix,
+                         const std::vector<size_t>& hashSet,
+                         const name_tree::EntrySelector& entrySelector) const
 {
   NFD_LOG_TRACE("NameTree::findAllMatches" << prefix);
 
@@ -462,7 +371,7 @@ NameTree::findAllMatches(const Name& prefix,
   // For trie-like design, it could be more efficient by walking down the
   // trie from the root node.
 
-  shared_ptr<name_tree::Entry> entry = findLongestPrefixMatch(prefix, entrySelector);
+  shared_ptr<name_tree::Entry> entry = findLongestPrefixMatch(prefix, hashSet, entrySelector);
 
   if (static_cast<bool>(entry)) {
     const_iterator begin(FIND_ALL_MATCHES_TYPE, *this, entry, entrySelector);
@@ -472,115 +381,46 @@ NameTree::findAllMatches(const Name& prefix,
   return {end(), end()};
 }
 
-// Hash Table Resize
-void
-NameTree::resize(size_t newNBuckets)
-{
-  NFD_LOG_TRACE("resize");
-
-  name_tree::Node** newBuckets = new name_tree::Node*[newNBuckets];
-  size_t count = 0;
-
-  // referenced ccnx hashtb.c hashtb_rehash()
-  name_tree::Node** pp = 0;
-  name_tree::Node* p = 0;
-  name_tree::Node* pre = 0;
-  name_tree::Node* q = 0; // record p->m_next
-  size_t i;
-  uint32_t h;
-  uint32_t b;
-
-  for (i = 0; i < newNBuckets; i++)
-    {
-      newBuckets[i] = 0;
-    }
-
-  for (i = 0; i < m_nBuckets; i++)
-    {
-      for (p = m_buckets[i]; p != 0; p = q)
-        {
-          count++;
-          q = p->m_next;
-          BOOST_ASSERT(static_cast<bool>(p->m_entry));
-          h = p->m_entry->m_hash;
-          b = h % newNBuckets;
-          pre = 0;
-          for (pp = &newBuckets[b]; *pp != 0; pp = &((*pp)->m_next))
-            {
-              pre = *pp;
-              continue;
-            }
-          p->m_prev = pre;
-          p->m_next = *pp; // Actually *pp always == 0 in this case
-          *pp = p;
-        }
-    }
-
-  BOOST_ASSERT(count == m_nItems);
-
-  name_tree::Node** oldBuckets = m_buckets;
-  m_buckets = newBuckets;
-  delete [] oldBuckets;
-
-  m_nBuckets = newNBuckets;
-
-  m_enlargeThreshold = static_cast<size_t>(m_enlargeLoadFactor *
-                                              static_cast<double>(m_nBuckets));
-  m_shrinkThreshold = static_cast<size_t>(m_shrinkLoadFactor *
-                                              static_cast<double>(m_nBuckets));
-}
-
 // For debugging
 void
 NameTree::dump(std::ostream& output) const
 {
   NFD_LOG_TRACE("dump()");
 
-  name_tree::Node* node = 0;
-  shared_ptr<name_tree::Entry> entry;
-
   using std::endl;
 
-  for (size_t i = 0; i < m_nBuckets; i++)
+  for (shared_ptr<name_tree::Entry> entry = m_table->getFirst();
+       static_cast<bool>(entry); entry = m_table->getNext(*entry))
     {
-      for (node = m_buckets[i]; node != 0; node = node->m_next)
-        {
-          entry = node->m_entry;
-
-          // if the Entry exist, dump its information
-          if (static_cast<bool>(entry))
-            {
-              output << "Bucket" << i << "\t" << entry->m_prefix.toUri() << endl;
-              output << "\t\tHash " << entry->m_hash << endl;
+      // dump the information of the Entry and its home bucket
+      size_t i = entry->m_hash % m_table->getNBuckets();
+      output << "Bucket" << i << "\t" << entry->m_prefix.toUri() << endl;
+      output << "\t\tHash " << entry->m_hash << endl;
 
-              if (static_cast<bool>(entry->m_parent))
-                {
-                  output << "\t\tparent->" << entry->m_parent->m_prefix.toUri();
-                }
-              else
-                {
-                  output << "\t\tROOT";
-                }
-              output << endl;
-
-              if (entry->m_children.size() != 0)
-                {
-                  output << "\t\tchildren = " << entry->m_children.size() << endl;
-
-                  for (size_t j = 0; j < entry->m_children.size(); j++)
-                    {
-                      output << "\t\t\tChild " << j << " " <<
-                        entry->m_children[j]->getPrefix() << endl;
-                    }
-                }
+      if (static_cast<bool>(entry->m_parent))
+        {
+          output << "\t\tparent->" << entry->m_parent->m_prefix.toUri();
+        }
+      else
+        {
+          output << "\t\tROOT";
+        }
+      output << endl;
 
-            } // if (static_cast<bool>(entry))
+      if (entry->m_children.size() != 0)
+        {
+          output << "\t\tchildren = " << entry->m_children.size() << endl;
 
-        } // for node
-    } // for int i
+          for (size_t j = 0; j < entry->m_children.size(); j++)
+            {
+              output << "\t\t\tChild " << j << " " <<
+                entry->m_children[j]->getPrefix() << endl;
+            }
+        }
+    } // for entry
 
-  output << "Bucket count = " << m_nBuckets << endl;
-  output << "Stored item = " << m_nItems << endl;
+  output << "Bucket count = " << m_table->getNBuckets() << endl;
+  output << "Stored item = " << m_table->size() << endl;
   output << "--------------------------\n";
 }
 
@@ -614,35 +454,17 @@ NameTree::const_iterator::operator++()
 
   if (m_type == FULL_ENUMERATE_TYPE) // fullEnumerate
     {
-      // process the entries in the same bucket first
-      while (m_entry->m_node->m_next != 0)
+      // process the entries in hash table order
+      for (m_entry = m_nameTree->m_table->getNext(*m_entry);
+           static_cast<bool>(m_entry);
+           m_entry = m_nameTree->m_table->getNext(*m_entry))
         {
-          m_entry = m_entry->m_node->m_next->m_entry;
           if ((*m_entrySelector)(*m_entry))
             {
               return *this;
             }
         }
 
-      // process other buckets
-
-      for (int newLocation = m_entry->m_hash % m_nameTree->m_nBuckets + 1;
-           newLocation < static_cast<int>(m_nameTree->m_nBuckets);
-           ++newLocation)
-        {
-          // process each bucket
-          name_tree::Node* node = m_nameTree->m_buckets[newLocation];
-          while (node != 0)
-            {
-              m_entry = node->m_entry;
-              if ((*m_entrySelector)(*m_entry))
-                {
-                  return *this;
-                }
-              node = node->m_next;
-            }
-        }
-
       // Reach the end()
       m_entry = m_nameTree->m_end;
       return *this;
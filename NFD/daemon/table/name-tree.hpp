@@ -28,6 +28,7 @@
 
 #include "common.hpp"
 #include "name-tree-entry.hpp"
+#include "name-tree-hashtable.hpp"
 
 namespace nfd {
 namespace name_tree {
@@ -45,6 +46,64 @@ computeHash(const Name& prefix);
 std::vector<size_t>
 computeHashSet(const Name& prefix);
 
+/**
+ * \brief a packet tag that carries the hash values of the packet's Name prefixes
+ * \details A packet's Name may be looked up in the Name Tree several times while the packet
+ * goes through the forwarding pipelines. Attaching this tag to the packet allows all
+ * those lookups to share the result of a single computeHashSet call.
+ */
+class HashSetTag : public ndn::Tag
+{
+public:
+  static size_t
+  getTypeId()
+  {
+    return 0x9f21d24c; // md5("NameTreeHashSetTag")[0:8]
+  }
+
+  explicit
+  HashSetTag(const Name& name);
+
+  /**
+   * \return whether the hash values were computed from the wire encoding of \p name
+   * \note A Name modified after this tag was created has a new wire encoding,
+   *       so that the tag no longer applies to it.
+   */
+  bool
+  isValidFor(const Name& name) const;
+
+  const std::vector<size_t>&
+  getHashSet() const;
+
+private:
+  Block m_nameWire;
+  std::vector<size_t> m_hashSet;
+};
+
+/**
+ * \brief Get the hash values of the packet's Name prefixes
+ * \tparam Packet Interest or Data
+ * \details The hash values are computed on first use and cached in a HashSetTag
+ * attached to the packet.
+ */
+template<typename Packet>
+shared_ptr<HashSetTag>
+getHashSetTag(const Packet& packet)
+{
+  shared_ptr<HashSetTag> tag = packet.template getTag<HashSetTag>();
+  if (tag == nullptr || !tag->isValidFor(packet.getName())) {
+    tag = make_shared<HashSetTag>(packet.getName());
+    packet.setTag(tag);
+  }
+  return tag;
+}
+
+inline const std::vector<size_t>&
+HashSetTag::getHashSet() const
+{
+  return m_hashSet;
+}
+
 /// a predicate to accept or reject an Entry in find operations
 typedef function<bool (const Entry& entry)> EntrySelector;
 
@@ -81,8 +140,13 @@ class NameTree : noncopyable
 public:
   class const_iterator;
 
+  /**
+   * \param nBuckets The initial number of buckets in the hash table.
+   * \param layout The layout of the hash table.
+   */
   explicit
-  NameTree(size_t nBuckets = 1024);
+  NameTree(size_t nBuckets = 1024,
+           name_tree::HashtableLayout layout = name_tree::HASHTABLE_CHAINED);
 
   ~NameTree();
 
@@ -95,12 +159,25 @@ public: // information
 
   /**
    * \brief Get the number of buckets in the Name Tree (NPHT)
-   * \details The number of buckets is the one that used to create the hash
-   * table, i.e., m_nBuckets.
+   * \details With HASHTABLE_OPEN_ADDRESSING layout, this is the number of slots
+   * in the slot array that receives insertions.
    */
   size_t
   getNBuckets() const;
 
+  /**
+   * \brief Get the pool that Name Tree Entries are allocated from
+   */
+  const MemoryPool&
+  getEntryPool() const;
+
+  /**
+   * \brief Get the pool that hash table Nodes are allocated from
+   * \return the pool, or nullptr if the hash table layout does not use Nodes
+   */
+  const MemoryPool*
+  getNodePool() const;
+
   /**
    * \brief Dump all the information stored in the Name Tree for debugging.
    */
@@ -121,6 +198,17 @@ public: // mutation
   shared_ptr<name_tree::Entry>
   lookup(const Name& prefix);
 
+  /**
+   * \brief Look for the Name Tree Entry that contains this name prefix,
+   * using precomputed hash values.
+   * \param prefix The querying name prefix.
+   * \param hashSet The hash values of all prefixes of \p prefix, as returned by
+   * name_tree::computeHashSet(prefix).
+   * \sa lookup(const Name&)
+   */
+  shared_ptr<name_tree::Entry>
+  lookup(const Name& prefix, const std::vector<size_t>& hashSet);
+
   /**
    * \brief Delete a Name Tree Entry if this entry is empty.
    * \param entry The entry to be deleted if empty.
@@ -134,19 +222,19 @@ public: // mutation
 
 public: // shortcut access
   /// get NameTree entry from attached FIB entry
-  shared_ptr<name_tree::Entry>
+  const shared_ptr<name_tree::Entry>&
   get(const fib::Entry& fibEntry) const;
 
   /// get NameTree entry from attached PIT entry
-  shared_ptr<name_tree::Entry>
+  const shared_ptr<name_tree::Entry>&
   get(const pit::Entry& pitEntry) const;
 
   /// get NameTree entry from attached Measurements entry
-  shared_ptr<name_tree::Entry>
+  const shared_ptr<name_tree::Entry>&
   get(const measurements::Entry& measurementsEntry) const;
 
   /// get NameTree entry from attached StrategyChoice entry
-  shared_ptr<name_tree::Entry>
+  const shared_ptr<name_tree::Entry>&
   get(const strategy_choice::Entry& strategyChoiceEntry) const;
 
 public: // matching
@@ -158,6 +246,13 @@ public: // matching
   shared_ptr<name_tree::Entry>
   findExactMatch(const Name& prefix) const;
 
+  /**
+   * \brief Exact match lookup for the given name prefix, using a precomputed hash value.
+   * \param hashValue The hash value of \p prefix, as returned by name_tree::computeHash(prefix).
+   */
+  shared_ptr<name_tree::Entry>
+  findExactMatch(const Name& prefix, size_t hashValue) const;
+
   /**
    * \brief Longest prefix matching for the given name
    * \details Starts from the full name string, reduce the number of name component
@@ -168,6 +263,17 @@ public: // matching
                          const name_tree::EntrySelector& entrySelector =
                          name_tree::AnyEntry()) const;
 
+  /**
+   * \brief Longest prefix matching for the given name, using precomputed hash values.
+   * \param hashSet The hash values of all prefixes of \p prefix, as returned by
+   * name_tree::computeHashSet(prefix).
+   */
+  shared_ptr<name_tree::Entry>
+  findLongestPrefixMatch(const Name& prefix,
+                         const std::vector<size_t>& hashSet,
+                         const name_tree::EntrySelector& entrySelector =
+                         name_tree::AnyEntry()) const;
+
   shared_ptr<name_tree::Entry>
   findLongestPrefixMatch(shared_ptr<name_tree::Entry> entry,
                          const name_tree::EntrySelector& entrySelector =
@@ -191,6 +297,16 @@ public: // matching
   findAllMatches(const Name& prefix,
                  const name_tree::EntrySelector& entrySelector = name_tree::AnyEntry()) const;
 
+  /** \brief Enumerate all the name prefixes that satisfy the prefix and entrySelector,
+   *         using precomputed hash values
+   *  \param hashSet The hash values of all prefixes of \p prefix, as returned by
+   *         name_tree::computeHashSet(prefix).
+   */
+  boost::iterator_range<const_iterator>
+  findAllMatches(const Name& prefix,
+                 const std::vector<size_t>& hashSet,
+                 const name_tree::EntrySelector& entrySelector = name_tree::AnyEntry()) const;
+
 public: // enumeration
   /** \brief Enumerate all entries, optionally filtered by an EntrySelector.
    *  \return an unspecified type that have .begin() and .end() methods
@@ -292,27 +408,8 @@ public: // enumeration
   };
 
 private:
-  /**
-   * \brief Resize the hash table size when its load factor reaches a threshold.
-   * \details As we are currently using a hand-written hash table implementation
-   * for the Name Tree, the hash table resize() function should be kept in the
-   * name-tree.hpp file.
-   * \param newNBuckets The number of buckets for the new hash table.
-   */
-  void
-  resize(size_t newNBuckets);
-
-private:
-  size_t                        m_nItems;  // Number of items being stored
-  size_t                        m_nBuckets; // Number of hash buckets
-  size_t                        m_minNBuckets; // Minimum number of hash buckets
-  double                        m_enlargeLoadFactor;
-  size_t                        m_enlargeThreshold;
-  int                           m_enlargeFactor;
-  double                        m_shrinkLoadFactor;
-  size_t                        m_shrinkThreshold;
-  double                        m_shrinkFactor;
-  name_tree::Node**             m_buckets; // Name Tree Buckets in the NPHT
+  shared_ptr<MemoryPool> m_entryPool;
+  unique_ptr<name_tree::Hashtable> m_table; // Name Prefix Hash Table (NPHT)
   shared_ptr<name_tree::Entry>  m_end;
   const_iterator                m_endIterator;
 
@@ -320,12 +417,15 @@ private:
    * \brief Create a Name Tree Entry if it does not exist, or return the existing
    * Name Tree Entry address.
    * \details Called by lookup() only.
+   * \param name The name being looked up.
+   * \param prefixLen The number of components of \p name that make up the prefix to insert.
+   * \param hashValue The hash value of that prefix.
    * \return The first item is the Name Tree Entry address, the second item is
    * a bool value indicates whether this is an old entry (false) or a new
    * entry (true).
    */
   std::pair<shared_ptr<name_tree::Entry>, bool>
-  insert(const Name& prefix);
+  insert(const Name& name, size_t prefixLen, size_t hashValue);
 };
 
 inline NameTree::const_iterator::~const_iterator()
@@ -335,34 +435,46 @@ inline NameTree::const_iterator::~const_iterator()
 inline size_t
 NameTree::size() const
 {
-  return m_nItems;
+  return m_table->size();
 }
 
 inline size_t
 NameTree::getNBuckets() const
 {
-  return m_nBuckets;
+  return m_table->getNBuckets();
 }
 
-inline shared_ptr<name_tree::Entry>
+inline const MemoryPool&
+NameTree::getEntryPool() const
+{
+  return *m_entryPool;
+}
+
+inline const MemoryPool*
+NameTree::getNodePool() const
+{
+  return m_table->getNodePool();
+}
+
+inline const shared_ptr<name_tree::Entry>&
 NameTree::get(const fib::Entry& fibEntry) const
 {
   return fibEntry.m_nameTreeEntry;
 }
 
-inline shared_ptr<name_tree::Entry>
+inline const shared_ptr<name_tree::Entry>&
 NameTree::get(const pit::Entry& pitEntry) const
 {
   return pitEntry.m_nameTreeEntry;
 }
 
-inline shared_ptr<name_tree::Entry>
+inline const shared_ptr<name_tree::Entry>&
 NameTree::get(const measurements::Entry& measurementsEntry) const
 {
   return measurementsEntry.m_nameTreeEntry;
 }
 
-inline shared_ptr<name_tree::Entry>
+inline const shared_ptr<name_tree::Entry>&
 NameTree::get(const strategy_choice::Entry& strategyChoiceEntry) const
 {
   return strategyChoiceEntry.m_nameTreeEntry;
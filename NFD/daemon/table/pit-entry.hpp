@@ -29,6 +29,7 @@
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
 #include "core/scheduler.hpp"
+#include "core/small-vector.hpp"
 
 namespace nfd {
 
@@ -41,12 +42,24 @@ class Entry;
 namespace pit {
 
 /** \brief represents an unordered collection of InRecords
+ *
+ *  Most PIT entries have a single InRecord, which is stored inside the entry.
+ *  New records are appended. Iterators are invalidated when a record is inserted or deleted.
+ *
+ *  Records are found by comparing the Face pointer kept in each record, not by FaceId:
+ *  faces outside the FaceTable all have INVALID_FACEID, and a face loses its FaceId
+ *  when it is removed while its records may remain. The pointer is stored inline
+ *  like a FaceId would be, so the lookup scans the same contiguous memory.
  */
-typedef std::list< InRecord>  InRecordCollection;
+typedef SmallVector<InRecord, 1> InRecordCollection;
 
 /** \brief represents an unordered collection of OutRecords
+ *
+ *  Most PIT entries have a single OutRecord, which is stored inside the entry.
+ *  New records are appended. Iterators are invalidated when a record is inserted or deleted.
+ *  Records are found by Face pointer, as in InRecordCollection.
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef SmallVector<OutRecord, 1> OutRecordCollection;
 
 /** \brief indicates where duplicate Nonces are found
  */
@@ -43,7 +43,7 @@ public:
   explicit
   FaceRecord(shared_ptr<Face> face);
 
-  shared_ptr<Face>
+  const shared_ptr<Face>&
   getFace() const;
 
   uint32_t
@@ -70,7 +70,7 @@ private:
   time::steady_clock::TimePoint m_expiry;
 };
 
-inline shared_ptr<Face>
+inline const shared_ptr<Face>&
 FaceRecord::getFace() const
 {
   return m_face;
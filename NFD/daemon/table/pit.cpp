@@ -54,6 +54,7 @@ BOOST_CONCEPT_ASSERT((boost::DefaultConstructible<Pit::const_iterator>));
 Pit::Pit(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_entryPool(make_shared<MemoryPool>())
 {
 }
 
@@ -66,7 +67,9 @@ Pit::insert(const Interest& interest)
 {
   // first lookup() the Interest Name in the NameTree, which will creates all
   // the intermedia nodes, starting from the shortest prefix.
-  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(interest.getName());
+  shared_ptr<name_tree::HashSetTag> hashSetTag = name_tree::getHashSetTag(interest);
+  shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.lookup(interest.getName(),
+                                                                 hashSetTag->getHashSet());
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
   const std::vector<shared_ptr<pit::Entry>>& pitEntries = nameTreeEntry->getPitEntries();
@@ -81,7 +84,8 @@ Pit::insert(const Interest& interest)
     return { *it, false };
   }
 
-  shared_ptr<pit::Entry> entry = make_shared<pit::Entry>(interest);
+  shared_ptr<pit::Entry> entry = std::allocate_shared<pit::Entry>(
+                                   PoolAllocator<pit::Entry>(m_entryPool), interest);
   nameTreeEntry->insertPitEntry(entry);
   m_nItems++;
   return { entry, true };
@@ -90,7 +94,8 @@ Pit::insert(const Interest& interest)
 pit::DataMatchResult
 Pit::findAllDataMatches(const Data& data) const
 {
-  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(),
+  shared_ptr<name_tree::HashSetTag> hashSetTag = name_tree::getHashSetTag(data);
+  auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), hashSetTag->getHashSet(),
     [] (const name_tree::Entry& entry) { return entry.hasPitEntries(); });
 
   pit::DataMatchResult matches;
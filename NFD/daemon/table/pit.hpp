@@ -58,6 +58,11 @@ public:
   size_t
   size() const;
 
+  /** \return the pool that entries are allocated from
+   */
+  const MemoryPool&
+  getEntryPool() const;
+
   /** \brief inserts a PIT entry for Interest
    *
    *  If an entry for exact same name and selectors exists, that entry is returned.
@@ -137,6 +142,7 @@ public: // enumeration
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  shared_ptr<MemoryPool> m_entryPool;
 };
 
 inline size_t
@@ -145,6 +151,12 @@ Pit::size() const
   return m_nItems;
 }
 
+inline const MemoryPool&
+Pit::getEntryPool() const
+{
+  return *m_entryPool;
+}
+
 inline Pit::const_iterator
 Pit::end() const
 {
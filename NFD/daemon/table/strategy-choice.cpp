@@ -39,6 +39,7 @@ NFD_LOG_INIT("StrategyChoice");
 StrategyChoice::StrategyChoice(NameTree& nameTree, shared_ptr<Strategy> defaultStrategy)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_epoch(1)
 {
   this->setDefaultStrategy(defaultStrategy);
 }
@@ -118,6 +119,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   this->changeStrategy(*entry, *oldStrategy, *strategy);
   entry->setStrategy(*strategy);
+  ++m_epoch;
   return true;
 }
 
@@ -144,6 +146,7 @@ StrategyChoice::erase(const Name& prefix)
   nte->setStrategyChoiceEntry(shared_ptr<Entry>());
   m_nameTree.eraseEntryIfEmpty(nte);
   --m_nItems;
+  ++m_epoch;
 }
 
 std::pair<bool, Name>
@@ -165,47 +168,52 @@ StrategyChoice::get(const Name& prefix) const
 Strategy&
 StrategyChoice::findEffectiveStrategy(const Name& prefix) const
 {
-  shared_ptr<name_tree::Entry> nte = m_nameTree.findLongestPrefixMatch(prefix,
-    [] (const name_tree::Entry& entry) {
-      return static_cast<bool>(entry.getStrategyChoiceEntry());
-    });
+  // any existing entry will do: its memoized strategy covers every name below it
+  // that has no NameTree entry of its own
+  shared_ptr<name_tree::Entry> nte = m_nameTree.findLongestPrefixMatch(prefix);
 
   BOOST_ASSERT(static_cast<bool>(nte));
-  return nte->getStrategyChoiceEntry()->getStrategy();
+  return this->findEffectiveStrategy(*nte);
 }
 
 Strategy&
-StrategyChoice::findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const
+StrategyChoice::findEffectiveStrategy(name_tree::Entry& nte) const
 {
-  shared_ptr<strategy_choice::Entry> entry = nte->getStrategyChoiceEntry();
-  if (static_cast<bool>(entry))
-    return entry->getStrategy();
+  if (nte.m_strategyEpoch == m_epoch) {
+    return *nte.m_effectiveStrategy;
+  }
 
-  nte = m_nameTree.findLongestPrefixMatch(nte,
-    [] (const name_tree::Entry& entry) {
-      return static_cast<bool>(entry.getStrategyChoiceEntry());
-    });
+  Strategy* strategy = nullptr;
+  if (static_cast<bool>(nte.m_strategyChoiceEntry)) {
+    strategy = &nte.m_strategyChoiceEntry->getStrategy();
+  }
+  else {
+    // root entry always has a StrategyChoice entry, so a parent exists here
+    BOOST_ASSERT(static_cast<bool>(nte.m_parent));
+    strategy = &this->findEffectiveStrategy(*nte.m_parent);
+  }
 
-  BOOST_ASSERT(static_cast<bool>(nte));
-  return nte->getStrategyChoiceEntry()->getStrategy();
+  nte.m_effectiveStrategy = strategy;
+  nte.m_strategyEpoch = m_epoch;
+  return *strategy;
 }
 
 Strategy&
 StrategyChoice::findEffectiveStrategy(const pit::Entry& pitEntry) const
 {
-  shared_ptr<name_tree::Entry> nte = m_nameTree.get(pitEntry);
+  const shared_ptr<name_tree::Entry>& nte = m_nameTree.get(pitEntry);
 
   BOOST_ASSERT(static_cast<bool>(nte));
-  return this->findEffectiveStrategy(nte);
+  return this->findEffectiveStrategy(*nte);
 }
 
 Strategy&
 StrategyChoice::findEffectiveStrategy(const measurements::Entry& measurementsEntry) const
 {
-  shared_ptr<name_tree::Entry> nte = m_nameTree.get(measurementsEntry);
+  const shared_ptr<name_tree::Entry>& nte = m_nameTree.get(measurementsEntry);
 
   BOOST_ASSERT(static_cast<bool>(nte));
-  return this->findEffectiveStrategy(nte);
+  return this->findEffectiveStrategy(*nte);
 }
 
 void
@@ -158,13 +158,23 @@ private:
                  fw::Strategy& oldStrategy,
                  fw::Strategy& newStrategy);
 
+  /** \brief get effective strategy for a NameTree entry
+   *
+   *  The result is memoized on \p nte and on every ancestor visited while computing it,
+   *  and stays valid until the next insert or erase bumps the epoch.
+   */
   fw::Strategy&
-  findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const;
+  findEffectiveStrategy(name_tree::Entry& nte) const;
 
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
 
+  /** \brief incremented whenever a change may alter the effective strategy of some prefix,
+   *         which invalidates all memoized effective strategies at once
+   */
+  uint64_t m_epoch;
+
   typedef std::map<Name, shared_ptr<fw::Strategy> > StrategyInstanceTable;
   StrategyInstanceTable m_strategyInstances;
 };
@@ -27,10 +27,122 @@
 
 namespace nfd {
 
+const size_t StrategyInfoHost::N_SLOTS;
+const size_t StrategyInfoHost::SLOT_SIZE;
+
+StrategyInfoHost::StrategyInfoHost(StrategyInfoHost&& other)
+{
+  for (size_t i = 0; i < N_SLOTS; ++i) {
+    moveSlot(other.m_slots[i], m_slots[i]);
+  }
+  m_overflow = std::move(other.m_overflow);
+}
+
+StrategyInfoHost&
+StrategyInfoHost::operator=(StrategyInfoHost&& other)
+{
+  if (this != &other) {
+    this->clearStrategyInfo();
+    for (size_t i = 0; i < N_SLOTS; ++i) {
+      moveSlot(other.m_slots[i], m_slots[i]);
+    }
+    m_overflow = std::move(other.m_overflow);
+  }
+  return *this;
+}
+
+StrategyInfoHost::~StrategyInfoHost()
+{
+  this->clearStrategyInfo();
+}
+
+void
+StrategyInfoHost::destroy(Slot& slot)
+{
+  if (slot.item == nullptr) {
+    return;
+  }
+
+  if (slot.relocate != nullptr) {
+    slot.item->~StrategyInfo();
+  }
+  else {
+    delete slot.item;
+  }
+  slot.item = nullptr;
+  slot.relocate = nullptr;
+}
+
+void
+StrategyInfoHost::moveSlot(Slot& from, Slot& to)
+{
+  BOOST_ASSERT(to.item == nullptr);
+  if (from.item == nullptr) {
+    return;
+  }
+
+  to.typeId = from.typeId;
+  if (from.relocate != nullptr) {
+    from.relocate(from, to);
+    from.item = nullptr;
+    from.relocate = nullptr;
+  }
+  else {
+    to.item = from.item;
+    to.relocate = nullptr;
+    from.item = nullptr;
+  }
+}
+
+StrategyInfoHost::Slot*
+StrategyInfoHost::findFreeSlot()
+{
+  for (Slot& slot : m_slots) {
+    if (slot.item == nullptr) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+fw::StrategyInfo&
+StrategyInfoHost::insertOverflow(int typeId, unique_ptr<fw::StrategyInfo> item)
+{
+  if (m_overflow == nullptr) {
+    m_overflow.reset(new std::vector<OverflowItem>);
+  }
+  m_overflow->push_back({typeId, std::move(item)});
+  return *m_overflow->back().item;
+}
+
+bool
+StrategyInfoHost::erase(int typeId)
+{
+  for (Slot& slot : m_slots) {
+    if (slot.typeId == typeId && slot.item != nullptr) {
+      destroy(slot);
+      return true;
+    }
+  }
+
+  if (m_overflow != nullptr) {
+    for (auto it = m_overflow->begin(); it != m_overflow->end(); ++it) {
+      if (it->typeId == typeId) {
+        m_overflow->erase(it);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 void
 StrategyInfoHost::clearStrategyInfo()
 {
-  m_items.clear();
+  for (Slot& slot : m_slots) {
+    destroy(slot);
+  }
+  m_overflow.reset();
 }
 
 } // namespace nfd
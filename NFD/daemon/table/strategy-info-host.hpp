@@ -28,28 +28,40 @@
 
 #include "fw/strategy-info.hpp"
 
+#include <array>
+#include <vector>
+
 namespace nfd {
 
 /** \brief base class for an entity onto which StrategyInfo objects may be placed
+ *
+ *  Items are kept in a few slots inside the host, keyed by StrategyInfo type id.
+ *  An item that fits in SLOT_SIZE is constructed in place in its slot, and is
+ *  move-constructed into the new slot when the host is moved; a larger item is
+ *  allocated on the heap and owned by the slot. Lookup compares the type ids of the slots.
+ *  When all slots are taken, further items go to an overflow list on the heap.
  */
 class StrategyInfoHost
 {
 public:
+  StrategyInfoHost() = default;
+
+  StrategyInfoHost(StrategyInfoHost&& other);
+
+  StrategyInfoHost&
+  operator=(StrategyInfoHost&& other);
+
+  ~StrategyInfoHost();
+
   /** \brief get a StrategyInfo item
    *  \tparam T type of StrategyInfo, must be a subclass of from nfd::fw::StrategyInfo
    *  \retval nullptr if no StrategyInfo of type T is stored
+   *  \note The pointer is valid until the item is erased or the host is destroyed.
    */
   template<typename T>
-  shared_ptr<T>
+  T*
   getStrategyInfo() const;
 
-  /** \brief set a StrategyInfo item
-   *  \tparam T type of StrategyInfo, must be a subclass of from nfd::fw::StrategyInfo
-   */
-  template<typename T>
-  void
-  setStrategyInfo(shared_ptr<T> strategyInfo);
-
   /** \brief get or create a StrategyInfo item
    *  \tparam T type of StrategyInfo, must be a subclass of from nfd::fw::StrategyInfo
    *
@@ -57,61 +69,193 @@ public:
    *  otherwise, the existing item is returned.
    */
   template<typename T, typename ...A>
-  shared_ptr<T>
+  T&
   getOrCreateStrategyInfo(A&&... args);
 
+  /** \brief erase a StrategyInfo item
+   *  \tparam T type of StrategyInfo, must be a subclass of from nfd::fw::StrategyInfo
+   *  \return whether an item was erased
+   */
+  template<typename T>
+  bool
+  eraseStrategyInfo();
+
   /** \brief clear all StrategyInfo items
    */
   void
   clearStrategyInfo();
 
+public:
+  /** \brief number of StrategyInfo items stored inside a host
+   *
+   *  A host carries items of one strategy, and of the helpers it uses,
+   *  because items are cleared when the effective strategy changes.
+   *  Items beyond this number are allocated in the overflow list.
+   */
+  static const size_t N_SLOTS = 3;
+
+  /** \brief size of the storage inside each slot
+   *
+   *  This fits the StrategyInfo types on PIT entries and face records.
+   *  A larger type, or one that is not move-constructible, is allocated on the heap.
+   */
+  static const size_t SLOT_SIZE = 64;
+
 private:
-  std::map<int, shared_ptr<fw::StrategyInfo>> m_items;
+  struct Slot;
+
+  /** \brief moves an item of type T from the storage of \p from into the storage of \p to
+   */
+  template<typename T>
+  static void
+  relocateItem(Slot& from, Slot& to);
+
+  template<typename T, typename ...A>
+  static T*
+  construct(Slot& slot, std::true_type isInline, A&&... args);
+
+  template<typename T, typename ...A>
+  static T*
+  construct(Slot& slot, std::false_type isInline, A&&... args);
+
+  static void
+  destroy(Slot& slot);
+
+  static void
+  moveSlot(Slot& from, Slot& to);
+
+  fw::StrategyInfo*
+  find(int typeId) const;
+
+  /** \return a free slot, or nullptr if all slots are taken
+   */
+  Slot*
+  findFreeSlot();
+
+  fw::StrategyInfo&
+  insertOverflow(int typeId, unique_ptr<fw::StrategyInfo> item);
+
+  bool
+  erase(int typeId);
+
+private:
+  struct Slot
+  {
+    Slot()
+      : typeId(0)
+      , item(nullptr)
+      , relocate(nullptr)
+    {
+    }
+
+    int typeId;
+    fw::StrategyInfo* item; ///< nullptr if the slot is free
+    void (*relocate)(Slot& from, Slot& to); ///< nullptr if the item is on the heap
+    typename std::aligned_storage<SLOT_SIZE>::type storage;
+  };
+
+  struct OverflowItem
+  {
+    int typeId;
+    unique_ptr<fw::StrategyInfo> item;
+  };
+
+  std::array<Slot, N_SLOTS> m_slots;
+  unique_ptr<std::vector<OverflowItem>> m_overflow; ///< nullptr until all slots are taken
 };
 
 
+inline fw::StrategyInfo*
+StrategyInfoHost::find(int typeId) const
+{
+  for (const Slot& slot : m_slots) {
+    if (slot.typeId == typeId && slot.item != nullptr) {
+      return slot.item;
+    }
+  }
+  if (m_overflow != nullptr) {
+    for (const OverflowItem& overflowItem : *m_overflow) {
+      if (overflowItem.typeId == typeId) {
+        return overflowItem.item.get();
+      }
+    }
+  }
+  return nullptr;
+}
+
+template<typename T>
+void
+StrategyInfoHost::relocateItem(Slot& from, Slot& to)
+{
+  T* item = static_cast<T*>(from.item);
+  to.item = new (&to.storage) T(std::move(*item));
+  to.relocate = from.relocate;
+  item->~T();
+}
+
+template<typename T, typename ...A>
+T*
+StrategyInfoHost::construct(Slot& slot, std::true_type, A&&... args)
+{
+  T* item = new (&slot.storage) T(std::forward<A>(args)...);
+  slot.relocate = &StrategyInfoHost::relocateItem<T>;
+  return item;
+}
+
+template<typename T, typename ...A>
+T*
+StrategyInfoHost::construct(Slot& slot, std::false_type, A&&... args)
+{
+  T* item = new T(std::forward<A>(args)...);
+  slot.relocate = nullptr;
+  return item;
+}
+
 template<typename T>
-shared_ptr<T>
+T*
 StrategyInfoHost::getStrategyInfo() const
 {
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
-  auto it = m_items.find(T::getTypeId());
-  if (it == m_items.end()) {
-    return nullptr;
-  }
-  return static_pointer_cast<T, fw::StrategyInfo>(it->second);
+  return static_cast<T*>(this->find(T::getTypeId()));
 }
 
-template<typename T>
-void
-StrategyInfoHost::setStrategyInfo(shared_ptr<T> item)
+template<typename T, typename ...A>
+T&
+StrategyInfoHost::getOrCreateStrategyInfo(A&&... args)
 {
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
-  if (item == nullptr) {
-    m_items.erase(T::getTypeId());
+  T* item = this->getStrategyInfo<T>();
+  if (item != nullptr) {
+    return *item;
   }
-  else {
-    m_items[T::getTypeId()] = item;
+
+  Slot* slot = this->findFreeSlot();
+  if (slot == nullptr) {
+    unique_ptr<fw::StrategyInfo> overflowItem(new T(std::forward<A>(args)...));
+    return static_cast<T&>(this->insertOverflow(T::getTypeId(), std::move(overflowItem)));
   }
+
+  typedef std::integral_constant<bool, sizeof(T) <= sizeof(Slot::storage) &&
+                                       alignof(T) <= alignof(decltype(Slot::storage)) &&
+                                       std::is_move_constructible<T>::value> IsInline;
+  item = construct<T>(*slot, IsInline(), std::forward<A>(args)...);
+  slot->typeId = T::getTypeId();
+  slot->item = item;
+  return *item;
 }
 
-template<typename T, typename ...A>
-shared_ptr<T>
-StrategyInfoHost::getOrCreateStrategyInfo(A&&... args)
+template<typename T>
+bool
+StrategyInfoHost::eraseStrategyInfo()
 {
   static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                 "T must inherit from StrategyInfo");
 
-  shared_ptr<T> item = this->getStrategyInfo<T>();
-  if (!static_cast<bool>(item)) {
-    item = make_shared<T>(std::forward<A>(args)...);
-    this->setStrategyInfo(item);
-  }
-  return item;
+  return this->erase(T::getTypeId());
 }
 
 } // namespace nfd
@@ -30,13 +30,6 @@
 #include <boost/thread.hpp>
 
 namespace nfd {
-
-namespace scheduler {
-// defined in scheduler.cpp
-Scheduler&
-getGlobalScheduler();
-} // namespace scheduler
-
 namespace tests {
 
 using scheduler::EventId;
@@ -157,8 +157,8 @@ BOOST_AUTO_TEST_CASE(SendPacket)
   face->sendInterest(*interest2);
   face->sendData    (*data2    );
 
+  // packets that fit in one frame are sent without NDNLP header
   BOOST_CHECK_EQUAL(face->getCounters().getNOutBytes(),
-                    14 * 4 + // 4 NDNLP headers
                     interest1->wireEncode().size() +
                     data1->wireEncode().size() +
                     interest2->wireEncode().size() +
@@ -280,6 +280,23 @@ BOOST_AUTO_TEST_CASE(ProcessIncomingPacket)
   BOOST_CHECK_EQUAL(face->getCounters().getNInBytes(), 56);
   BOOST_CHECK_EQUAL(recInterests.size(), 1);
   BOOST_CHECK_EQUAL(recDatas.size(), 0);
+
+  // valid frame and valid NDN (interest) packet without NDNLP header
+  static const pcap_pkthdr header7{{}, ethernet::HDR_LEN + ethernet::MIN_DATA_LEN};
+  static const uint8_t packet7[ethernet::HDR_LEN + ethernet::MIN_DATA_LEN]{
+    0x01, 0x00, 0x5e, 0x00, 0x17, 0xaa, // destination address
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x02, // source address
+    0x86, 0x24,                         // NDN ethertype
+    tlv::Interest, 0x16,                // NDN TLV type and length
+    0x07, 0x0e, 0x08, 0x07, 0x65, 0x78, // payload
+    0x61, 0x6d, 0x70, 0x6c, 0x65, 0x08,
+    0x03, 0x66, 0x6f, 0x6f, 0x0a, 0x04,
+    0x03, 0xef, 0xe9, 0x7d
+  };
+  face->processIncomingPacket(&header7, packet7);
+  BOOST_CHECK_EQUAL(face->getCounters().getNInBytes(), 80);
+  BOOST_CHECK_EQUAL(recInterests.size(), 2);
+  BOOST_CHECK_EQUAL(recDatas.size(), 0);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -617,6 +617,76 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(IdleClose, A, EndToEndAddresses)
   BOOST_CHECK_EQUAL(history2->failures.size(), 0); // face2 is outgoing face and never closed
 }
 
+#ifdef __linux__
+// send and receive several datagrams with one system call
+BOOST_AUTO_TEST_CASE_TEMPLATE(BatchedEndToEnd, A, EndToEndAddresses)
+{
+  LimitedIo limitedIo;
+  UdpFactory factory;
+  factory.setBatchSize(8);
+
+  boost::asio::ip::address ipAddress = boost::asio::ip::address::from_string(A::getLocalIp());
+  udp::Endpoint endpoint1(ipAddress, boost::lexical_cast<uint16_t>(A::getPort1()));
+  udp::Endpoint endpoint2(ipAddress, boost::lexical_cast<uint16_t>(A::getPort2()));
+
+  // face1 (on channel1) and face2 (on channel2) are connected to each other
+  shared_ptr<UdpChannel> channel1 = factory.createChannel(endpoint1);
+  shared_ptr<UdpChannel> channel2 = factory.createChannel(endpoint2);
+  shared_ptr<UdpFace> face1;
+  shared_ptr<UdpFace> face2;
+  channel1->connect(endpoint2, ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                    [&] (shared_ptr<Face> newFace) {
+                      face1 = static_pointer_cast<UdpFace>(newFace);
+                    },
+                    [] (const std::string& reason) { BOOST_ERROR(reason); });
+  channel2->connect(endpoint1, ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                    [&] (shared_ptr<Face> newFace) {
+                      face2 = static_pointer_cast<UdpFace>(newFace);
+                    },
+                    [] (const std::string& reason) { BOOST_ERROR(reason); });
+  BOOST_REQUIRE(face1 != nullptr);
+  BOOST_REQUIRE(face2 != nullptr);
+  BOOST_CHECK_EQUAL(face1->getBatchSize(), 8);
+  FaceHistory history2(*face2, limitedIo);
+
+  // packets sent while processing one event are sent together
+  size_t nBytesSent = 0;
+  for (int i = 0; i < 20; ++i) {
+    shared_ptr<Interest> interest = makeInterest(Name("/batch").appendNumber(i));
+    face1->sendInterest(*interest);
+    nBytesSent += interest->wireEncode().size();
+  }
+
+  BOOST_CHECK_EQUAL(limitedIo.run(20, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_REQUIRE_EQUAL(history2.receivedInterests.size(), 20);
+  for (int i = 0; i < 20; ++i) {
+    BOOST_CHECK_EQUAL(history2.receivedInterests[i].getName(), Name("/batch").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(face1->getCounters().getNOutBytes(), nBytesSent);
+  BOOST_CHECK_EQUAL(face2->getCounters().getNInBytes(), nBytesSent);
+
+  const BatchCounters& sendBatches = face1->getSendBatchCounters();
+  BOOST_CHECK_EQUAL(sendBatches.getNBatches(), 3); // 8 + 8 + 4
+  BOOST_CHECK_EQUAL(sendBatches.getNPackets(), 20);
+  BOOST_CHECK_EQUAL(sendBatches.getMaxBatchSize(), 8);
+
+  // the receive operation started before batching was enabled takes the first datagram
+  const BatchCounters& receiveBatches = face2->getReceiveBatchCounters();
+  BOOST_CHECK_EQUAL(receiveBatches.getNPackets(), 19);
+  BOOST_CHECK_LE(receiveBatches.getMaxBatchSize(), 8);
+  BOOST_CHECK_GE(receiveBatches.getNBatches(), 3);
+
+  // disabling batching falls back to one datagram per system call
+  factory.setBatchSize(1);
+  BOOST_CHECK_EQUAL(face1->getBatchSize(), 1);
+  shared_ptr<Data> data = makeData("/D");
+  face1->sendData(*data);
+  BOOST_CHECK_EQUAL(limitedIo.run(1, time::seconds(1)), LimitedIo::EXCEED_OPS);
+  BOOST_CHECK_EQUAL(history2.receivedData.size(), 1);
+  BOOST_CHECK_EQUAL(sendBatches.getNPackets(), 20);
+}
+#endif // __linux__
+
 class FakeNetworkInterfaceFixture : public BaseFixture
 {
 public:
@@ -331,6 +331,56 @@ BOOST_FIXTURE_TEST_CASE(MultipleAccepts, EndToEndFixture)
   BOOST_CHECK_EQUAL(face2_receivedDatas    [0].getName(), data1->getName());
 }
 
+BOOST_AUTO_TEST_CASE(SendBatching)
+{
+  UnixStreamFace::protocol::socket faceSocket(g_io);
+  UnixStreamFace::protocol::socket peer(g_io);
+  boost::asio::local::connect_pair(faceSocket, peer);
+
+  FaceUri remoteUri = FaceUri::fromFd(faceSocket.native_handle());
+  auto face = make_shared<UnixStreamFace>(remoteUri, FaceUri("unix:///send-batching"),
+                                          std::move(faceSocket));
+  face->setSendBatchLimits(std::numeric_limits<size_t>::max(), 4);
+
+  // the first Interest is written right away, the rest are queued behind it
+  std::vector<shared_ptr<Interest>> interests;
+  size_t nBytesSent = 0;
+  for (int i = 0; i < 20; ++i) {
+    interests.push_back(makeInterest(Name("ndn:/batch").appendNumber(i)));
+    face->sendInterest(*interests.back());
+    nBytesSent += interests.back()->wireEncode().size();
+  }
+
+  for (int i = 0; i < 100 && face->getCounters().getNOutBytes() < nBytesSent; ++i) {
+    g_io.poll();
+    g_io.reset();
+  }
+  BOOST_CHECK_EQUAL(face->getCounters().getNOutBytes(), nBytesSent);
+
+  std::vector<uint8_t> received(nBytesSent);
+  boost::asio::read(peer, boost::asio::buffer(received));
+  size_t offset = 0;
+  for (const auto& interest : interests) {
+    bool isOk = false;
+    Block block;
+    std::tie(isOk, block) = Block::fromBuffer(received.data() + offset, received.size() - offset);
+    BOOST_REQUIRE(isOk);
+    BOOST_CHECK_EQUAL(Interest(block).getName(), interest->getName());
+    offset += block.size();
+  }
+
+  const BatchCounters& counters = face->getSendBatchCounters();
+  BOOST_CHECK_EQUAL(counters.getNPackets(), 20);
+  BOOST_CHECK_EQUAL(counters.getNBatches(), 6); // 1 + 4 + 4 + 4 + 4 + 3
+  BOOST_CHECK_EQUAL(counters.getMaxBatchSize(), 4);
+  BOOST_CHECK_EQUAL(counters.getNBatchesInBucket(0), 1);
+  BOOST_CHECK_EQUAL(counters.getNBatchesInBucket(1), 1);
+  BOOST_CHECK_EQUAL(counters.getNBatchesInBucket(2), 4);
+
+  face->close();
+  g_io.poll();
+}
+
 BOOST_FIXTURE_TEST_CASE(UnixStreamFaceLocalControlHeader, EndToEndFixture)
 {
   UnixStreamFactory factory;
@@ -53,19 +53,22 @@ Producer::GetTypeId(void)
          "Postfix that is added to the output data (e.g., for adding producer-uniqueness)",
          StringValue("/"), MakeNameAccessor(&Producer::m_postfix), MakeNameChecker())
       .AddAttribute("PayloadSize", "Virtual payload size for Content packets", UintegerValue(1024),
-                    MakeUintegerAccessor(&Producer::m_virtualPayloadSize),
+                    MakeUintegerAccessor(&Producer::SetPayloadSize, &Producer::GetPayloadSize),
                     MakeUintegerChecker<uint32_t>())
       .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
-                    TimeValue(Seconds(0)), MakeTimeAccessor(&Producer::m_freshness),
+                    TimeValue(Seconds(0)),
+                    MakeTimeAccessor(&Producer::SetFreshness, &Producer::GetFreshness),
                     MakeTimeChecker())
       .AddAttribute(
          "Signature",
          "Fake signature, 0 valid signature (default), other values application-specific",
-         UintegerValue(0), MakeUintegerAccessor(&Producer::m_signature),
+         UintegerValue(0), MakeUintegerAccessor(&Producer::SetSignature, &Producer::GetSignature),
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker());
+                    NameValue(),
+                    MakeNameAccessor(&Producer::SetKeyLocator, &Producer::GetKeyLocator),
+                    MakeNameChecker());
   return tid;
 }
 
@@ -82,6 +85,8 @@ Producer::StartApplication()
   App::StartApplication();
 
   FibHelper::AddRoute(GetNode(), m_prefix, m_face, 0);
+
+  MakeDataTemplate();
 }
 
 void
@@ -102,12 +107,28 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   if (!m_active)
     return;
 
-  Name dataName(interest->getName());
-  // dataName.append(m_postfix);
-  // dataName.appendVersion();
+  if (m_dataTemplate == nullptr) {
+    MakeDataTemplate();
+  }
+
+  auto data = make_shared<Data>(*m_dataTemplate);
+  data->setName(interest->getName());
+  // data->getName().append(m_postfix);
+  // data->getName().appendVersion();
+
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
+
+  // to create real wire encoding
+  data->wireEncode();
+
+  m_transmittedDatas(data, this, m_face);
+  m_face->onReceiveData(*data);
+}
 
+void
+Producer::MakeDataTemplate()
+{
   auto data = make_shared<Data>();
-  data->setName(dataName);
   data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
 
   data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
@@ -124,13 +145,63 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
 
   data->setSignature(signature);
 
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
+  // cache wire encodings of the elements, which are shared by copies of the template
+  data->getMetaInfo().wireEncode();
+  data->getContent();
 
-  // to create real wire encoding
-  data->wireEncode();
+  m_dataTemplate = data;
+}
 
-  m_transmittedDatas(data, this, m_face);
-  m_face->onReceiveData(*data);
+void
+Producer::SetPayloadSize(uint32_t payloadSize)
+{
+  m_virtualPayloadSize = payloadSize;
+  m_dataTemplate.reset();
+}
+
+uint32_t
+Producer::GetPayloadSize() const
+{
+  return m_virtualPayloadSize;
+}
+
+void
+Producer::SetFreshness(Time freshness)
+{
+  m_freshness = freshness;
+  m_dataTemplate.reset();
+}
+
+Time
+Producer::GetFreshness() const
+{
+  return m_freshness;
+}
+
+void
+Producer::SetSignature(uint32_t signature)
+{
+  m_signature = signature;
+  m_dataTemplate.reset();
+}
+
+uint32_t
+Producer::GetSignature() const
+{
+  return m_signature;
+}
+
+void
+Producer::SetKeyLocator(const Name& keyLocator)
+{
+  m_keyLocator = keyLocator;
+  m_dataTemplate.reset();
+}
+
+Name
+Producer::GetKeyLocator() const
+{
+  return m_keyLocator;
 }
 
 } // namespace ndn
@@ -59,6 +59,44 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+private:
+  /**
+   * @brief Prepare the Data packet that replies are copied from
+   *
+   * MetaInfo, Content and Signature of the template are encoded once, so that a reply only
+   * needs its Name set before the final encoding
+   */
+  void
+  MakeDataTemplate();
+
+  /**
+   * The setters below discard the Data template, so that changes made with Config::Set
+   * while the application is running take effect on the next reply
+   */
+  void
+  SetPayloadSize(uint32_t payloadSize);
+
+  uint32_t
+  GetPayloadSize() const;
+
+  void
+  SetFreshness(Time freshness);
+
+  Time
+  GetFreshness() const;
+
+  void
+  SetSignature(uint32_t signature);
+
+  uint32_t
+  GetSignature() const;
+
+  void
+  SetKeyLocator(const Name& keyLocator);
+
+  Name
+  GetKeyLocator() const;
+
 private:
   Name m_prefix;
   Name m_postfix;
@@ -67,6 +105,8 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  shared_ptr<const Data> m_dataTemplate;
 };
 
 } // namespace ndn
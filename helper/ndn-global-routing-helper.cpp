@@ -46,23 +46,256 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
 
-#include <boost/lexical_cast.hpp>
-#include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/thread/thread.hpp>
 
+#include <atomic>
+#include <queue>
 #include <unordered_map>
 
-#include "boost-graph-ndn-global-routing-helper.hpp"
-
-#include <math.h>
-
 NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingHelper");
 
 namespace ns3 {
 namespace ndn {
 
+static GlobalValue g_nRoutingThreads("NdnGlobalRoutingThreads",
+                                     "Number of threads used by ndn::GlobalRoutingHelper "
+                                     "to calculate routes",
+                                     UintegerValue(1), MakeUintegerChecker<uint32_t>(1));
+
+namespace {
+
+/**
+ * @brief Read-only snapshot of GlobalRouter graph, used to calculate routes
+ *
+ * Vertices are GlobalRouters of nodes followed by those of channels.  Route calculation refers to
+ * vertices and faces by index only, so that it can run outside of the main thread (reference
+ * counting of ns3::Ptr is not thread-safe).
+ */
+class RoutingGraph {
+public:
+  static const size_t NO_FACE;
+
+  struct Route {
+    size_t destination; ///< index of destination vertex, which has local prefixes
+    size_t face;        ///< index of first hop face
+    uint32_t metric;
+  };
+
+  RoutingGraph();
+
+  size_t
+  getVertexIndex(Ptr<GlobalRouter> gr) const
+  {
+    return m_vertexIndex.at(PeekPointer(gr));
+  }
+
+  Ptr<GlobalRouter>
+  getVertex(size_t index) const
+  {
+    return m_vertices[index];
+  }
+
+  /**
+   * @return index of the face, or NO_FACE if the face is not an edge of the graph
+   */
+  size_t
+  findFace(const shared_ptr<Face>& face) const
+  {
+    auto i = m_faceIndex.find(face.get());
+    return i == m_faceIndex.end() ? NO_FACE : i->second;
+  }
+
+  const shared_ptr<Face>&
+  getFace(size_t index) const
+  {
+    return m_faces[index];
+  }
+
+  /**
+   * @brief Calculate shortest paths from source to every vertex that has local prefixes
+   * @param source index of source vertex
+   * @param onlyFace if not NO_FACE, only paths starting with this face of source are considered
+   * @note This method is safe to call from multiple threads
+   */
+  std::vector<Route>
+  calculate(size_t source, size_t onlyFace) const;
+
+private:
+  struct Edge {
+    size_t target;
+    size_t face; ///< NO_FACE on edges of a channel
+    uint32_t metric;
+  };
+
+  std::vector<Ptr<GlobalRouter>> m_vertices;
+  std::unordered_map<const GlobalRouter*, size_t> m_vertexIndex;
+  std::vector<bool> m_hasLocalPrefixes;
+  std::vector<std::vector<Edge>> m_edges;
+  std::vector<shared_ptr<Face>> m_faces;
+  std::unordered_map<const Face*, size_t> m_faceIndex;
+};
+
+const size_t RoutingGraph::NO_FACE = std::numeric_limits<size_t>::max();
+
+RoutingGraph::RoutingGraph()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr != 0)
+      m_vertices.push_back(gr);
+  }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr != 0)
+      m_vertices.push_back(gr);
+  }
+
+  for (size_t i = 0; i < m_vertices.size(); ++i) {
+    m_vertexIndex[PeekPointer(m_vertices[i])] = i;
+    m_hasLocalPrefixes.push_back(!m_vertices[i]->GetLocalPrefixes().empty());
+  }
+
+  m_edges.resize(m_vertices.size());
+  for (size_t i = 0; i < m_vertices.size(); ++i) {
+    for (const auto& incidency : m_vertices[i]->GetIncidencies()) {
+      Edge edge;
+      edge.target = getVertexIndex(std::get<2>(incidency));
+      edge.face = NO_FACE;
+      edge.metric = 0;
+
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      if (face != nullptr) {
+        auto inserted = m_faceIndex.insert(std::make_pair(face.get(), m_faces.size()));
+        if (inserted.second) {
+          m_faces.push_back(face);
+        }
+        edge.face = inserted.first->second;
+        edge.metric = static_cast<uint16_t>(face->getMetric());
+      }
+      m_edges[i].push_back(edge);
+    }
+  }
+}
+
+std::vector<RoutingGraph::Route>
+RoutingGraph::calculate(size_t source, size_t onlyFace) const
+{
+  // a path is usable only if its metric is below this value
+  const uint32_t METRIC_INF = std::numeric_limits<uint16_t>::max();
+
+  std::vector<uint32_t> metrics(m_vertices.size(), METRIC_INF);
+  std::vector<size_t> firstHops(m_vertices.size(), NO_FACE);
+
+  // ties are broken by vertex index, so that routes don't depend on thread scheduling
+  typedef std::pair<uint32_t, size_t> QueueItem;
+  std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> queue;
+
+  metrics[source] = 0;
+  queue.push(QueueItem(0, source));
+  while (!queue.empty()) {
+    uint32_t metric = queue.top().first;
+    size_t vertex = queue.top().second;
+    queue.pop();
+    if (metric > metrics[vertex]) {
+      continue; // already visited with smaller metric
+    }
+
+    for (const Edge& edge : m_edges[vertex]) {
+      if (vertex == source && onlyFace != NO_FACE && edge.face != onlyFace) {
+        continue;
+      }
+
+      uint32_t newMetric = metric + edge.metric;
+      if (newMetric < metrics[edge.target]) {
+        metrics[edge.target] = newMetric;
+        firstHops[edge.target] = vertex == source ? edge.face : firstHops[vertex];
+        queue.push(QueueItem(newMetric, edge.target));
+      }
+    }
+  }
+
+  std::vector<Route> routes;
+  for (size_t i = 0; i < m_vertices.size(); ++i) {
+    if (i == source || !m_hasLocalPrefixes[i] || firstHops[i] == NO_FACE)
+      continue;
+
+    Route route;
+    route.destination = i;
+    route.face = firstHops[i];
+    route.metric = metrics[i];
+    routes.push_back(route);
+  }
+  return routes;
+}
+
+struct RouteJob {
+  Ptr<Node> node;
+  size_t source;
+  size_t onlyFace;
+};
+
+/**
+ * @brief Calculate routes of every job and install them into FIBs
+ *
+ * Route calculation runs in NdnGlobalRoutingThreads threads.  Routes are installed on the calling
+ * thread in the order of jobs, so that FIB contents don't depend on the number of threads.
+ * Jobs are processed in batches to bound the memory used by routes not yet installed.
+ */
+void
+calculateAndInstallRoutes(const RoutingGraph& graph, const std::vector<RouteJob>& jobs)
+{
+  UintegerValue nThreadsValue;
+  g_nRoutingThreads.GetValue(nThreadsValue);
+  const size_t nThreads = std::max<size_t>(nThreadsValue.Get(), 1);
+  const size_t batchSize = nThreads * 16;
+
+  std::vector<std::vector<RoutingGraph::Route>> results;
+  for (size_t begin = 0; begin < jobs.size(); begin += batchSize) {
+    size_t end = std::min(begin + batchSize, jobs.size());
+    results.assign(end - begin, std::vector<RoutingGraph::Route>());
+
+    std::atomic<size_t> next(begin);
+    auto work = [&] {
+      for (size_t i = next++; i < end; i = next++) {
+        results[i - begin] = graph.calculate(jobs[i].source, jobs[i].onlyFace);
+      }
+    };
+
+    if (nThreads == 1) {
+      work();
+    }
+    else {
+      boost::thread_group threads;
+      for (size_t i = 1; i < nThreads; ++i) {
+        threads.create_thread(work);
+      }
+      work();
+      threads.join_all();
+    }
+
+    for (size_t i = begin; i < end; ++i) {
+      NS_LOG_DEBUG("Reachability from Node: " << jobs[i].node->GetId() << " ("
+                                              << Names::FindName(jobs[i].node) << ")");
+      for (const auto& route : results[i - begin]) {
+        const shared_ptr<Face>& face = graph.getFace(route.face);
+        for (const auto& prefix : graph.getVertex(route.destination)->GetLocalPrefixes()) {
+          NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face " << *face
+                       << " with distance " << route.metric);
+
+          FibHelper::AddRoute(jobs[i].node, *prefix, face, route.metric);
+        }
+      }
+    }
+  }
+}
+
+} // namespace
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -217,21 +450,9 @@ GlobalRoutingHelper::AddOriginsForAll()
 void
 GlobalRoutingHelper::CalculateRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
-
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  RoutingGraph graph;
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
-
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
+  std::vector<RouteJob> jobs;
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
     if (source == 0) {
@@ -239,64 +460,23 @@ GlobalRoutingHelper::CalculateRoutes()
       continue;
     }
 
-    boost::DistancesMap distances;
-
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
-
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
-        }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-                         << " with distance " << std::get<1>(dist.second) << " with delay "
-                         << std::get<2>(dist.second));
-
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
-        }
-      }
-    }
+    RouteJob job;
+    job.node = *node;
+    job.source = graph.getVertexIndex(source);
+    job.onlyFace = RoutingGraph::NO_FACE;
+    jobs.push_back(job);
   }
+
+  calculateAndInstallRoutes(graph, jobs);
 }
 
 void
 GlobalRoutingHelper::CalculateAllPossibleRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  RoutingGraph graph;
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
-
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
-
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
+  // For every face of a node, calculate routes whose first hop is this face
+  std::vector<RouteJob> jobs;
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
     if (source == 0) {
@@ -304,86 +484,29 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes()
       continue;
     }
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
-
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
-
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
+    Ptr<L3Protocol> l3 = (*node)->GetObject<L3Protocol>();
     NS_ASSERT(l3 != 0);
 
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& i : l3->getForwarder()->getFaceTable()) {
-      shared_ptr<Face> nfdFace = std::dynamic_pointer_cast<Face>(i);
-      faceIds.push_back(nfdFace->getId());
-      originalMetrics[nfdFace->getId()] = nfdFace->getMetric();
-      nfdFace->setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
-    }
-
-    for (auto& faceId : faceIds) {
-      shared_ptr<Face> k = l3->getForwarder()->getFaceTable().get(faceId);
-      shared_ptr<NetDeviceFace> face = std::dynamic_pointer_cast<NetDeviceFace>(k);
+    for (const auto& i : l3->getForwarder()->getFaceTable()) {
+      shared_ptr<NetDeviceFace> face = std::dynamic_pointer_cast<NetDeviceFace>(i);
       if (face == 0) {
         NS_LOG_DEBUG("Skipping non-netdevice face");
         continue;
       }
 
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
-
-      boost::DistancesMap distances;
-
-      NS_LOG_DEBUG("-----------");
-
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
-
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-      for (const auto& dist : distances) {
-        if (dist.first == source)
-          continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
-            }
-          }
-        }
+      RouteJob job;
+      job.node = *node;
+      job.source = graph.getVertexIndex(source);
+      job.onlyFace = graph.findFace(face);
+      if (job.onlyFace == RoutingGraph::NO_FACE) {
+        NS_LOG_DEBUG("Skipping face that is not connected to another GlobalRouter");
+        continue;
       }
-
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
-    }
-
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
+      jobs.push_back(job);
     }
   }
+
+  calculateAndInstallRoutes(graph, jobs);
 }
 
 } // namespace ndn
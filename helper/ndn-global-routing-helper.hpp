@@ -96,6 +96,10 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * Shortest path trees are calculated in parallel by the number of threads set in
+   * `NdnGlobalRoutingThreads` global value (default 1), e.g., `--NdnGlobalRoutingThreads=8` on
+   * the command line.  Installed routes do not depend on the number of threads.
    */
   static void
   CalculateRoutes();
@@ -103,7 +107,8 @@ public:
   /**
    * @brief Calculate all possible next-hop independent alternative routes
    *
-   * Refer to the implementation for more details.
+   * For every face of every node, a shortest path tree is calculated using only this face as the
+   * first hop.  Like CalculateRoutes, calculation uses `NdnGlobalRoutingThreads` threads.
    *
    * Note that this method is highly experimental and should be used with caution (very time
    *consuming).
@@ -0,0 +1,248 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-partition-helper.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+NS_LOG_COMPONENT_DEFINE("ndn.PartitionHelper");
+
+namespace ns3 {
+namespace ndn {
+
+PartitionHelper::PartitionHelper()
+  : m_slack(0.1)
+  , m_lookahead(Time::Max())
+{
+}
+
+bool
+PartitionHelper::IsMpiSupported()
+{
+#ifdef NS3_MPI
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint32_t
+PartitionHelper::GetLocalSystemId()
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled()) {
+    return MpiInterface::GetSystemId();
+  }
+#endif
+  return 0;
+}
+
+uint32_t
+PartitionHelper::GetNSystems()
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled()) {
+    return MpiInterface::GetSize();
+  }
+#endif
+  return 1;
+}
+
+bool
+PartitionHelper::IsLocal(Ptr<Node> node)
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled()) {
+    return node->GetSystemId() == MpiInterface::GetSystemId();
+  }
+#endif
+  return true;
+}
+
+std::string
+PartitionHelper::GetPartitionFileName(const std::string& file)
+{
+  if (file == "-" || GetNSystems() <= 1) {
+    return file;
+  }
+
+  std::string suffix = "-" + std::to_string(GetLocalSystemId());
+
+  size_t dot = file.rfind('.');
+  size_t slash = file.rfind('/');
+  if (dot == std::string::npos || dot == 0 ||
+      (slash != std::string::npos && dot <= slash + 1)) {
+    return file + suffix;
+  }
+  return file.substr(0, dot) + suffix + file.substr(dot);
+}
+
+void
+PartitionHelper::EnableLogFile(const std::string& file)
+{
+  // the stream is never destroyed: std::clog may be used until the very end of the process
+  static std::ofstream* logFile = nullptr;
+
+  if (logFile == nullptr) {
+    logFile = new std::ofstream();
+  }
+  else {
+    logFile->close();
+  }
+
+  std::string fileName = GetPartitionFileName(file);
+  logFile->open(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!logFile->is_open()) {
+    NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Logging not redirected");
+    return;
+  }
+  std::clog.rdbuf(logFile->rdbuf());
+}
+
+void
+PartitionHelper::AddNode(const std::string& name)
+{
+  getNodeIndex(name);
+}
+
+void
+PartitionHelper::AddLink(const std::string& node1, const std::string& node2, Time delay)
+{
+  uint32_t index1 = getNodeIndex(node1);
+  uint32_t index2 = getNodeIndex(node2);
+  m_links.push_back(LinkInfo{index1, index2, delay});
+}
+
+void
+PartitionHelper::SetSlack(double slack)
+{
+  NS_ASSERT(slack >= 0);
+  m_slack = slack;
+}
+
+void
+PartitionHelper::Partition(uint32_t nPartitions)
+{
+  NS_LOG_FUNCTION(this << nPartitions);
+  NS_ASSERT(nPartitions > 0);
+
+  uint32_t nNodes = m_nodeIndex.size();
+  uint32_t maxSize = std::max<uint32_t>(1, std::ceil(static_cast<double>(nNodes) / nPartitions *
+                                                     (1 + m_slack)));
+
+  m_parent.resize(nNodes);
+  std::iota(m_parent.begin(), m_parent.end(), 0);
+  std::vector<uint32_t> clusterSize(nNodes, 1);
+
+  std::vector<const LinkInfo*> links;
+  for (const LinkInfo& link : m_links) {
+    links.push_back(&link);
+  }
+  std::stable_sort(links.begin(), links.end(), [] (const LinkInfo* a, const LinkInfo* b) {
+      return a->delay < b->delay;
+    });
+
+  for (const LinkInfo* link : links) {
+    uint32_t cluster1 = findCluster(link->node1);
+    uint32_t cluster2 = findCluster(link->node2);
+    if (cluster1 == cluster2 || clusterSize[cluster1] + clusterSize[cluster2] > maxSize) {
+      continue;
+    }
+    m_parent[cluster2] = cluster1;
+    clusterSize[cluster1] += clusterSize[cluster2];
+  }
+
+  std::vector<uint32_t> clusters;
+  for (uint32_t node = 0; node < nNodes; ++node) {
+    if (findCluster(node) == node) {
+      clusters.push_back(node);
+    }
+  }
+  std::stable_sort(clusters.begin(), clusters.end(), [&clusterSize] (uint32_t a, uint32_t b) {
+      return clusterSize[a] > clusterSize[b];
+    });
+
+  std::vector<uint32_t> load(nPartitions, 0);
+  std::vector<uint32_t> clusterSystemId(nNodes, 0);
+  for (uint32_t cluster : clusters) {
+    uint32_t systemId = std::min_element(load.begin(), load.end()) - load.begin();
+    clusterSystemId[cluster] = systemId;
+    load[systemId] += clusterSize[cluster];
+  }
+
+  m_systemIds.resize(nNodes);
+  for (uint32_t node = 0; node < nNodes; ++node) {
+    m_systemIds[node] = clusterSystemId[findCluster(node)];
+  }
+
+  m_lookahead = Time::Max();
+  for (const LinkInfo& link : m_links) {
+    if (m_systemIds[link.node1] != m_systemIds[link.node2]) {
+      m_lookahead = std::min(m_lookahead, link.delay);
+    }
+  }
+
+  NS_LOG_INFO(nNodes << " nodes placed into " << nPartitions << " partitions, lookahead "
+              << m_lookahead);
+}
+
+uint32_t
+PartitionHelper::GetSystemId(const std::string& name) const
+{
+  auto it = m_nodeIndex.find(name);
+  NS_ASSERT_MSG(it != m_nodeIndex.end(), name << " node not found");
+  NS_ASSERT_MSG(it->second < m_systemIds.size(), "Partition() has not been called");
+  return m_systemIds[it->second];
+}
+
+Time
+PartitionHelper::GetLookahead() const
+{
+  return m_lookahead;
+}
+
+uint32_t
+PartitionHelper::getNodeIndex(const std::string& name)
+{
+  return m_nodeIndex.insert(std::make_pair(name, m_nodeIndex.size())).first->second;
+}
+
+uint32_t
+PartitionHelper::findCluster(uint32_t node)
+{
+  while (m_parent[node] != node) {
+    m_parent[node] = m_parent[m_parent[node]];
+    node = m_parent[node];
+  }
+  return node;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PARTITION_HELPER_H
+#define NDN_PARTITION_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to run NDN scenarios on the distributed (MPI) simulator
+ *
+ * With the distributed simulator each partition (logical process) runs in its own process, so
+ * every NDN stack, KeyChain and tracer list in a process belongs to exactly one partition.
+ * What still needs care is which nodes a partition acts upon and where its output goes.  The
+ * static methods of this helper answer that; without NS3_MPI (or when MPI is not enabled) they
+ * describe a single partition that owns every node.
+ *
+ * An instance of the helper assigns nodes of a topology to partitions.  Partitions can only run
+ * ahead of each other by the smallest delay among links that cross partitions (lookahead), so
+ * low-delay links are kept inside a partition, while keeping partitions balanced in the number
+ * of nodes.
+ */
+class PartitionHelper {
+public:
+  PartitionHelper();
+
+  /**
+   * @brief Check whether ndnSIM is compiled with the distributed simulator (NS3_MPI)
+   *
+   * If false, the static methods below always describe a single partition, even when the
+   * scenario enables MpiInterface.
+   */
+  static bool
+  IsMpiSupported();
+
+  /**
+   * @brief Get SystemId of the partition this process is simulating
+   */
+  static uint32_t
+  GetLocalSystemId();
+
+  /**
+   * @brief Get number of partitions in the simulation
+   */
+  static uint32_t
+  GetNSystems();
+
+  /**
+   * @brief Check whether @p node is simulated by this process
+   */
+  static bool
+  IsLocal(Ptr<Node> node);
+
+  /**
+   * @brief Get name of the output file for the local partition
+   *
+   * When simulation runs in several partitions, "-<SystemId>" is inserted before the file
+   * extension (e.g., "rate-trace.txt" becomes "rate-trace-1.txt"), so that partitions do not
+   * overwrite each other's output.  "-" (standard output) is returned unchanged.
+   */
+  static std::string
+  GetPartitionFileName(const std::string& file);
+
+  /**
+   * @brief Redirect ns-3 and NFD logging (std::clog) of the local partition into a file
+   *
+   * The name of the file is adjusted using GetPartitionFileName.
+   */
+  static void
+  EnableLogFile(const std::string& file);
+
+public:
+  /**
+   * @brief Add node to the topology to be partitioned
+   */
+  void
+  AddNode(const std::string& name);
+
+  /**
+   * @brief Add link with propagation @p delay between two nodes
+   *
+   * Nodes are added to the topology if not already present.
+   */
+  void
+  AddLink(const std::string& node1, const std::string& node2, Time delay);
+
+  /**
+   * @brief Set how many more nodes than the average a partition is allowed to have
+   * @param slack fraction of the average partition size (default 0.1)
+   */
+  void
+  SetSlack(double slack);
+
+  /**
+   * @brief Assign nodes to @p nPartitions partitions
+   *
+   * Links are processed in the order of increasing delay and their ends are merged into one
+   * cluster, unless the cluster would grow beyond the allowed partition size.  Clusters are then
+   * placed, largest first, into the least loaded partition.
+   */
+  void
+  Partition(uint32_t nPartitions);
+
+  /**
+   * @brief Get partition assigned to the node by the last call to Partition
+   */
+  uint32_t
+  GetSystemId(const std::string& name) const;
+
+  /**
+   * @brief Get lookahead of the last partitioning, i.e., the smallest delay of links between
+   *        partitions
+   *
+   * Time::Max() is returned if no link crosses partitions.
+   */
+  Time
+  GetLookahead() const;
+
+private:
+  uint32_t
+  getNodeIndex(const std::string& name);
+
+  uint32_t
+  findCluster(uint32_t node);
+
+private:
+  struct LinkInfo
+  {
+    uint32_t node1;
+    uint32_t node2;
+    Time delay;
+  };
+
+  std::map<std::string, uint32_t> m_nodeIndex;
+  std::vector<LinkInfo> m_links;
+  double m_slack;
+
+  std::vector<uint32_t> m_parent; ///< union-find forest of clusters
+  std::vector<uint32_t> m_systemIds;
+  Time m_lookahead;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PARTITION_HELPER_H
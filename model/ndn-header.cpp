@@ -19,11 +19,7 @@
 
 #include "ndn-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
-
-namespace io = boost::iostreams;
+#include <ndn-cxx/encoding/tlv.hpp>
 
 namespace ns3 {
 namespace ndn {
@@ -70,6 +66,7 @@ PacketHeader<Pkt>::PacketHeader()
 template<class Pkt>
 PacketHeader<Pkt>::PacketHeader(const Pkt& packet)
   : m_packet(packet.shared_from_this())
+  , m_wire(packet.wireEncode())
 {
 }
 
@@ -77,51 +74,68 @@ template<class Pkt>
 uint32_t
 PacketHeader<Pkt>::GetSerializedSize(void) const
 {
-  return m_packet->wireEncode().size();
+  return m_wire.size();
 }
 
 template<class Pkt>
 void
 PacketHeader<Pkt>::Serialize(ns3::Buffer::Iterator start) const
 {
-  start.Write(m_packet->wireEncode().wire(), m_packet->wireEncode().size());
+  start.Write(m_wire.wire(), m_wire.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+/** \brief reads TLV-TYPE or TLV-LENGTH from ns-3 buffer
+ *  \throw ::ndn::tlv::Error the buffer ends before the number
+ */
+static uint64_t
+readVarNumber(ns3::Buffer::Iterator& i)
+{
+  if (i.IsEnd()) {
+    throw ::ndn::tlv::Error("Insufficient data during TLV processing");
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  uint8_t firstOctet = i.ReadU8();
+  if (firstOctet < 253) {
+    return firstOctet;
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  uint32_t size = firstOctet == 253 ? 2 : (firstOctet == 254 ? 4 : 8);
+  if (i.GetRemainingSize() < size) {
+    throw ::ndn::tlv::Error("Insufficient data during TLV processing");
+  }
+
+  switch (size) {
+  case 2:
+    return i.ReadNtohU16();
+  case 4:
+    return i.ReadNtohU32();
+  default:
+    return i.ReadNtohU64();
+  }
+}
 
 template<class Pkt>
 uint32_t
 PacketHeader<Pkt>::Deserialize(ns3::Buffer::Iterator start)
 {
+  // Read TLV-TYPE and TLV-LENGTH to find the TLV size,
+  // then copy the whole TLV into a Buffer that backs the decoded packet.
+  ns3::Buffer::Iterator i = start;
+  readVarNumber(i);
+  uint64_t length = readVarNumber(i);
+  if (length > i.GetRemainingSize()) {
+    throw ::ndn::tlv::Error("TLV length exceeds ns3::Buffer size");
+  }
+  uint32_t size = start.GetRemainingSize() - i.GetRemainingSize() + length;
+
+  auto buffer = make_shared< ::ndn::Buffer>(size);
+  start.Read(buffer->buf(), size);
+  m_wire = Block(buffer);
+
   auto packet = make_shared<Pkt>();
-  io::stream<Ns3BufferIteratorSource> is(start);
-  packet->wireDecode(::ndn::Block::fromStream(is));
+  packet->wireDecode(m_wire);
   m_packet = packet;
-  return packet->wireEncode().size();
+  return size;
 }
 
 template<>
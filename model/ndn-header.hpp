@@ -57,6 +57,7 @@ public:
 
 private:
   shared_ptr<const Pkt> m_packet;
+  Block m_wire; ///< wire encoding of m_packet
 };
 
 } // namespace ndn
@@ -119,15 +119,14 @@ NetDeviceFace::receiveFromNetDevice(Ptr<NetDevice> device, Ptr<const Packet> p,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  Ptr<Packet> packet = p->Copy();
   try {
     uint32_t type = Convert::getPacketType(p);
     if (type == ::ndn::tlv::Interest) {
-      shared_ptr<const Interest> i = Convert::FromPacket<Interest>(packet);
+      shared_ptr<const Interest> i = Convert::FromPacket<Interest>(p);
       this->emitSignal(onReceiveInterest, *i);
     }
     else if (type == ::ndn::tlv::Data) {
-      shared_ptr<const Data> d = Convert::FromPacket<Data>(packet);
+      shared_ptr<const Data> d = Convert::FromPacket<Data>(p);
       this->emitSignal(onReceiveData, *d);
     }
     else {
@@ -31,22 +31,23 @@ namespace ndn {
 
 template<class T>
 std::shared_ptr<const T>
-Convert::FromPacket(Ptr<Packet> packet)
+Convert::FromPacket(Ptr<const Packet> packet)
 {
+  // the header is only peeked, so that a received packet is tagged without being copied
   PacketHeader<T> header;
-  packet->RemoveHeader(header);
+  uint32_t headerSize = packet->PeekHeader(header);
 
   auto pkt = header.getPacket();
-  pkt->setTag(make_shared<Ns3PacketTag>(packet));
+  pkt->setTag(make_shared<Ns3PacketTag>(packet, headerSize));
 
   return pkt;
 }
 
 template std::shared_ptr<const Interest>
-Convert::FromPacket<Interest>(Ptr<Packet> packet);
+Convert::FromPacket<Interest>(Ptr<const Packet> packet);
 
 template std::shared_ptr<const Data>
-Convert::FromPacket<Data>(Ptr<Packet> packet);
+Convert::FromPacket<Data>(Ptr<const Packet> packet);
 
 template<class T>
 Ptr<Packet>
@@ -58,7 +59,10 @@ Convert::ToPacket(const T& pkt)
 
   auto tag = pkt.template getTag<Ns3PacketTag>();
   if (tag != nullptr) {
-    packet = tag->getPacket()->Copy();
+    // keep the ns-3 tags of the received packet, but replace its NDN header
+    Ptr<const Packet> received = tag->getPacket();
+    packet = received->CreateFragment(tag->getHeaderSize(),
+                                      received->GetSize() - tag->getHeaderSize());
   }
   else {
     packet = Create<Packet>();
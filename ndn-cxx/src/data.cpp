@@ -21,6 +21,7 @@
 
 #include "data.hpp"
 #include "encoding/block-helpers.hpp"
+#include "encoding/block-view.hpp"
 #include "util/crypto.hpp"
 
 namespace ndn {
@@ -136,7 +137,6 @@ Data::wireDecode(const Block& wire)
 {
   m_fullName.clear();
   m_wire = wire;
-  m_wire.parse();
 
   // Data ::= DATA-TLV TLV-LENGTH
   //            Name
@@ -144,26 +144,56 @@ Data::wireDecode(const Block& wire)
   //            Content
   //            Signature
 
+  // elements are located in a single walk over m_wire without parsing it into sub blocks
+  BlockView name, metaInfo, content, signatureInfo, signatureValue;
+  for (const BlockView& element : BlockView(m_wire)) {
+    BlockView* field = nullptr;
+    switch (element.type()) {
+      case tlv::Name:
+        field = &name;
+        break;
+      case tlv::MetaInfo:
+        field = &metaInfo;
+        break;
+      case tlv::Content:
+        field = &content;
+        break;
+      case tlv::SignatureInfo:
+        field = &signatureInfo;
+        break;
+      case tlv::SignatureValue:
+        field = &signatureValue;
+        break;
+      default:
+        break;
+    }
+    if (field != nullptr && field->empty()) {
+      *field = element;
+    }
+  }
+
+  if (name.empty() || metaInfo.empty() || content.empty() || signatureInfo.empty())
+    BOOST_THROW_EXCEPTION(Error("Required element is missing when decoding Data"));
+
   // Name
-  m_name.wireDecode(m_wire.get(tlv::Name));
+  m_name.wireDecode(Block(m_wire, name));
 
   // MetaInfo
-  m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
+  m_metaInfo.wireDecode(Block(m_wire, metaInfo));
 
   // Content
-  m_content = m_wire.get(tlv::Content);
+  m_content = Block(m_wire, content);
 
   ///////////////
   // Signature //
   ///////////////
 
   // SignatureInfo
-  m_signature.setInfo(m_wire.get(tlv::SignatureInfo));
+  m_signature.setInfo(Block(m_wire, signatureInfo));
 
   // SignatureValue
-  Block::element_const_iterator val = m_wire.find(tlv::SignatureValue);
-  if (val != m_wire.elements_end())
-    m_signature.setValue(*val);
+  if (!signatureValue.empty())
+    m_signature.setValue(Block(m_wire, signatureValue));
 }
 
 Data&
@@ -28,6 +28,7 @@
 #include "registered-prefix.hpp"
 #include "pending-interest.hpp"
 #include "container-with-on-empty-signal.hpp"
+#include "name-indexed-table.hpp"
 
 #include "../util/scheduler.hpp"
 #include "../util/config-file.hpp"
@@ -40,6 +41,8 @@
 #include "../management/nfd-controller.hpp"
 #include "../management/nfd-command-options.hpp"
 
+#include <deque>
+
 #include <ns3/ptr.h>
 #include <ns3/node.h>
 #include <ns3/node-list.h>
@@ -52,8 +55,8 @@ namespace ndn {
 class Face::Impl : noncopyable
 {
 public:
-  typedef ContainerWithOnEmptySignal<shared_ptr<PendingInterest>> PendingInterestTable;
-  typedef std::list<shared_ptr<InterestFilterRecord> > InterestFilterTable;
+  typedef NameIndexedTable<PendingInterest, PendingInterestId> PendingInterestTable;
+  typedef NameIndexedTable<InterestFilterRecord, InterestFilterId> InterestFilterTable;
   typedef ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>> RegisteredPrefixTable;
 
   class NfdFace : public ::nfd::LocalFace
@@ -62,6 +65,7 @@ public:
     NfdFace(Impl& face, const ::nfd::FaceUri& localUri, const ::nfd::FaceUri& remoteUri)
       : ::nfd::LocalFace(localUri, remoteUri)
       , m_appFaceImpl(face)
+      , m_hasDeliveryEvent(false)
     {
     }
 
@@ -73,10 +77,7 @@ public:
     sendInterest(const Interest& interest)
     {
       NS_LOG_DEBUG("<< Interest " << interest);
-      shared_ptr<const Interest> interestPtr = interest.shared_from_this();
-      m_appFaceImpl.m_scheduler.scheduleEvent(time::seconds(0), [this, interestPtr] {
-          m_appFaceImpl.processInterestFilters(*interestPtr);
-        });
+      enqueue({interest.shared_from_this(), nullptr});
     }
 
     /**
@@ -86,10 +87,7 @@ public:
     sendData(const Data& data)
     {
       NS_LOG_DEBUG("<< Data " << data.getName());
-      shared_ptr<const Data> dataPtr = data.shared_from_this();
-      m_appFaceImpl.m_scheduler.scheduleEvent(time::seconds(0), [this, dataPtr] {
-          m_appFaceImpl.satisfyPendingInterests(*dataPtr);
-        });
+      enqueue({nullptr, data.shared_from_this()});
     }
 
     /** \brief Close the face
@@ -103,9 +101,61 @@ public:
       this->fail("close");
     }
 
+  private:
+    /**
+     * @brief Packet waiting to be delivered to the application, either Interest or Data
+     */
+    struct Delivery
+    {
+      shared_ptr<const Interest> interest;
+      shared_ptr<const Data> data;
+    };
+
+    /**
+     * @brief Queue a packet towards application
+     *
+     * Packets are not handed to the application from within the forwarder, as the application
+     * may send packets in response.  Instead, one scheduler event delivers all packets queued
+     * before it fires, so a burst of packets costs a single event.
+     */
+    void
+    enqueue(Delivery&& delivery)
+    {
+      m_deliveryQueue.push_back(std::move(delivery));
+
+      if (!m_hasDeliveryEvent) {
+        m_hasDeliveryEvent = true;
+        m_appFaceImpl.m_scheduler.scheduleEvent(time::seconds(0), bind(&NfdFace::deliver, this));
+      }
+    }
+
+    void
+    deliver()
+    {
+      m_hasDeliveryEvent = false;
+
+      // packets queued while this batch is being delivered are left for the next event
+      shared_ptr< ::nfd::Face> self = shared_from_this();
+      for (size_t nPackets = m_deliveryQueue.size(); nPackets > 0 && !m_deliveryQueue.empty();
+           --nPackets) {
+        Delivery delivery = std::move(m_deliveryQueue.front());
+        m_deliveryQueue.pop_front();
+
+        if (delivery.interest != nullptr) {
+          m_appFaceImpl.processInterestFilters(*delivery.interest);
+        }
+        else {
+          m_appFaceImpl.satisfyPendingInterests(*delivery.data);
+        }
+      }
+    }
+
   private:
     friend class Impl;
     Impl& m_appFaceImpl;
+
+    std::deque<Delivery> m_deliveryQueue;
+    bool m_hasDeliveryEvent;
   };
 
   ////////////////////////////////////////////////////////////////////////
@@ -125,32 +175,52 @@ public:
     node->GetObject<ns3::ndn::L3Protocol>()->addFace(m_nfdFace);
   }
 
+  ~Impl()
+  {
+    // the face may outlive Impl in the forwarder, which must not deliver what is left in the queue
+    m_nfdFace->m_deliveryQueue.clear();
+  }
+
   /////////////////////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////////////////////
 
   void
   satisfyPendingInterests(const Data& data)
   {
-    for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
-      if ((*entry)->getInterest().matchesData(data)) {
-        shared_ptr<PendingInterest> matchedEntry = *entry;
+    // only Interests whose Name is a prefix of Data full Name can match
+    std::vector<shared_ptr<PendingInterest>> matches;
+    auto collectMatch = [&data, &matches] (const shared_ptr<PendingInterest>& entry) {
+      if (entry->getInterest().matchesData(data)) {
+        matches.push_back(entry);
+      }
+    };
 
-        entry = m_pendingInterestTable.erase(entry);
+    if (m_pendingInterestTable.forEachPrefixOf(data.getName(), collectMatch)) {
+      // implicit digest is computed only when there are Interests longer than Data Name
+      m_pendingInterestTable.forEachExact(data.getFullName(), collectMatch);
+    }
 
-        matchedEntry->invokeDataCallback(data);
-      }
-      else
-        ++entry;
+    for (const auto& entry : matches) {
+      m_pendingInterestTable.erase(getPendingInterestId(*entry));
+    }
+    for (const auto& entry : matches) {
+      entry->invokeDataCallback(data);
     }
   }
 
   void
   processInterestFilters(const Interest& interest)
   {
-    for (const auto& filter : m_interestFilterTable) {
-      if (filter->doesMatch(interest.getName())) {
-        filter->invokeInterestCallback(interest);
-      }
+    std::vector<shared_ptr<InterestFilterRecord>> matches;
+    m_interestFilterTable.forEachPrefixOf(interest.getName(),
+      [&interest, &matches] (const shared_ptr<InterestFilterRecord>& filter) {
+        if (filter->doesMatch(interest.getName())) {
+          matches.push_back(filter);
+        }
+      });
+
+    for (const auto& filter : matches) {
+      filter->invokeInterestCallback(interest);
     }
   }
 
@@ -161,11 +231,10 @@ public:
   asyncExpressInterest(const shared_ptr<const Interest>& interest,
                        const OnData& onData, const OnTimeout& onTimeout)
   {
-    auto entry =
-      m_pendingInterestTable.insert(make_shared<PendingInterest>(interest,
-                                                                 onData, onTimeout,
-                                                                 ref(m_scheduler))).first;
-    (*entry)->setDeleter([this, entry] { m_pendingInterestTable.erase(entry); });
+    auto entry = make_shared<PendingInterest>(interest, onData, onTimeout, ref(m_scheduler));
+    const PendingInterestId* id = getPendingInterestId(*entry);
+    entry->setDeleter([this, id] { m_pendingInterestTable.erase(id); });
+    m_pendingInterestTable.insert(interest->getName(), id, entry);
 
     m_nfdFace->emitSignal(onReceiveInterest, *interest);
   }
@@ -173,7 +242,7 @@ public:
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
-    m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    m_pendingInterestTable.erase(pendingInterestId);
   }
 
   void
@@ -188,19 +257,13 @@ public:
   void
   asyncSetInterestFilter(const shared_ptr<InterestFilterRecord>& interestFilterRecord)
   {
-    m_interestFilterTable.push_back(interestFilterRecord);
+    addInterestFilter(interestFilterRecord);
   }
 
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end())
-      {
-        m_interestFilterTable.erase(i);
-      }
+    m_interestFilterTable.erase(interestFilterId);
   }
 
   /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -239,7 +302,7 @@ public:
 
     if (static_cast<bool>(registeredPrefix->getFilter())) {
       // it was a combined operation
-      m_interestFilterTable.push_back(registeredPrefix->getFilter());
+      addInterestFilter(registeredPrefix->getFilter());
     }
 
     if (static_cast<bool>(onSuccess)) {
@@ -263,7 +326,7 @@ public:
 
       if (filter != nullptr) {
         // it was a combined operation
-        m_interestFilterTable.remove(filter);
+        m_interestFilterTable.erase(reinterpret_cast<const InterestFilterId*>(filter.get()));
       }
 
       ControlParameters params;
@@ -293,6 +356,23 @@ public:
     }
   }
 
+private:
+  /**
+   * @brief PendingInterestId returned by Face::expressInterest for @p entry
+   */
+  static const PendingInterestId*
+  getPendingInterestId(const PendingInterest& entry)
+  {
+    return reinterpret_cast<const PendingInterestId*>(&entry.getInterest());
+  }
+
+  void
+  addInterestFilter(const shared_ptr<InterestFilterRecord>& filter)
+  {
+    m_interestFilterTable.insert(filter->getFilter().getPrefix(),
+                                 reinterpret_cast<const InterestFilterId*>(filter.get()), filter);
+  }
+
 private:
   Face& m_face;
   util::Scheduler m_scheduler;
@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_NAME_INDEXED_TABLE_HPP
+#define NDN_DETAIL_NAME_INDEXED_TABLE_HPP
+
+#include "../common.hpp"
+#include "../name.hpp"
+
+#include <list>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
+
+namespace ndn {
+
+/**
+ * @brief A table of records indexed by Name and by an opaque id
+ *
+ * Records are kept in a trie keyed by hashed name components, so that the records whose Name
+ * is a prefix of a given Name are found with one hash lookup per component, no matter how many
+ * records the table has.  The id of a record locates its trie node directly, so that removing
+ * a record does not scan the table.
+ *
+ * @tparam T type of records, which are held by shared_ptr
+ * @tparam Id opaque id type; every record in the table has a distinct id
+ */
+template<class T, class Id>
+class NameIndexedTable : noncopyable
+{
+public:
+  typedef shared_ptr<T> value_type;
+
+  NameIndexedTable()
+    : m_root(new Node(nullptr, nullptr))
+  {
+  }
+
+  size_t
+  size() const
+  {
+    return m_records.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_records.empty();
+  }
+
+  /**
+   * @brief Add a record under @p name
+   * @return false if a record with the same @p id is already in the table, in which case
+   *         nothing is added
+   */
+  bool
+  insert(const Name& name, const Id* id, const value_type& record)
+  {
+    if (m_records.count(id) > 0) {
+      return false;
+    }
+
+    Node* node = m_root.get();
+    for (const name::Component& component : name) {
+      auto child = node->children.emplace(component, nullptr);
+      if (child.second) {
+        child.first->second.reset(new Node(node, &child.first->first));
+      }
+      node = child.first->second.get();
+    }
+
+    node->records.push_back(record);
+    m_records.emplace(id, Position{node, std::prev(node->records.end())});
+    return true;
+  }
+
+  /**
+   * @brief Remove the record with @p id
+   * @return whether a record was removed
+   */
+  bool
+  erase(const Id* id)
+  {
+    auto it = m_records.find(id);
+    if (it == m_records.end()) {
+      return false;
+    }
+
+    Position position = it->second;
+    m_records.erase(it);
+
+    // the record is released after the table is updated, in case its destruction calls back
+    value_type record = std::move(*position.record);
+    position.node->records.erase(position.record);
+    this->prune(position.node);
+    return true;
+  }
+
+  void
+  clear()
+  {
+    m_records.clear();
+    m_root.reset(new Node(nullptr, nullptr));
+  }
+
+  /**
+   * @brief Invoke @p visit on every record whose Name is a prefix of @p name
+   *
+   * Records are visited from shorter to longer Names, and in insertion order under the same Name.
+   * @p visit must not modify the table.
+   *
+   * @return whether the table has records whose Name is longer than @p name and starts with it
+   */
+  template<class Visitor>
+  bool
+  forEachPrefixOf(const Name& name, const Visitor& visit) const
+  {
+    const Node* node = m_root.get();
+    for (size_t i = 0; ; ++i) {
+      for (const value_type& record : node->records) {
+        visit(record);
+      }
+
+      if (i == name.size()) {
+        return !node->children.empty();
+      }
+
+      auto child = node->children.find(name[i]);
+      if (child == node->children.end()) {
+        return false;
+      }
+      node = child->second.get();
+    }
+  }
+
+  /**
+   * @brief Invoke @p visit on every record whose Name equals @p name, in insertion order
+   *
+   * @p visit must not modify the table.
+   */
+  template<class Visitor>
+  void
+  forEachExact(const Name& name, const Visitor& visit) const
+  {
+    const Node* node = m_root.get();
+    for (const name::Component& component : name) {
+      auto child = node->children.find(component);
+      if (child == node->children.end()) {
+        return;
+      }
+      node = child->second.get();
+    }
+
+    for (const value_type& record : node->records) {
+      visit(record);
+    }
+  }
+
+private:
+  /**
+   * @brief Hashes the value of a name component, consistently with name::Component::equals
+   */
+  struct ComponentHash
+  {
+    size_t
+    operator()(const name::Component& component) const
+    {
+      return boost::hash_range(component.value_begin(), component.value_end());
+    }
+  };
+
+  struct Node;
+  typedef std::unordered_map<name::Component, unique_ptr<Node>, ComponentHash> ChildMap;
+
+  struct Node : noncopyable
+  {
+    Node(Node* parent, const name::Component* component)
+      : parent(parent)
+      , component(component)
+    {
+    }
+
+    Node* parent;
+    const name::Component* component; ///< key in parent's children, unused on root
+    ChildMap children;
+    std::list<value_type> records;
+  };
+
+  struct Position
+  {
+    Node* node;
+    typename std::list<value_type>::iterator record;
+  };
+
+  /**
+   * @brief Remove @p node and its ancestors that are left without records and children
+   */
+  void
+  prune(Node* node)
+  {
+    while (node->parent != nullptr && node->records.empty() && node->children.empty()) {
+      Node* parent = node->parent;
+      // iterators of ChildMap are invalidated by rehashing, but its keys are not moved
+      parent->children.erase(parent->children.find(*node->component)); // destroys node
+      node = parent;
+    }
+  }
+
+private:
+  unique_ptr<Node> m_root;
+  std::unordered_map<const Id*, Position> m_records;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_NAME_INDEXED_TABLE_HPP
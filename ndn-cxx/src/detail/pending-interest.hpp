@@ -117,29 +117,6 @@ private:
 
 class PendingInterestId;
 
-/**
- * @brief Functor to match pending interests against PendingInterestId
- */
-class MatchPendingInterestId
-{
-public:
-  explicit
-  MatchPendingInterestId(const PendingInterestId* pendingInterestId)
-    : m_id(pendingInterestId)
-  {
-  }
-
-  bool
-  operator()(const shared_ptr<const PendingInterest>& pendingInterest) const
-  {
-    return (reinterpret_cast<const PendingInterestId*>(
-              &pendingInterest->getInterest()) == m_id);
-  }
-private:
-  const PendingInterestId* m_id;
-};
-
-
 } // namespace ndn
 
 #endif // NDN_DETAIL_PENDING_INTEREST_HPP
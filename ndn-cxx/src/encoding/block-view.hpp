@@ -0,0 +1,339 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BLOCK_VIEW_HPP
+#define NDN_ENCODING_BLOCK_VIEW_HPP
+
+#include "block.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ndn {
+
+/** @brief Non-owning view of a TLV element within a wire buffer
+ *
+ *  Unlike Block, BlockView neither shares ownership of the buffer nor materializes its sub
+ *  elements: they are parsed one at a time while iterating, without any allocation.  A view
+ *  is valid only as long as the underlying buffer is alive.
+ */
+class BlockView
+{
+public:
+  class Error : public tlv::Error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : tlv::Error(what)
+    {
+    }
+  };
+
+  class const_iterator;
+
+  /** @brief Create an empty view
+   */
+  BlockView();
+
+  /** @brief Parse Type and Length of the TLV element at the beginning of [begin, end)
+   *
+   *  The element may be shorter than the range; BlockView::wire() + BlockView::size()
+   *  points past its last octet.
+   *
+   *  @throw tlv::Error the range does not start with a complete TLV element
+   */
+  BlockView(const uint8_t* begin, const uint8_t* end);
+
+  /** @brief View the wire encoding of a Block
+   *  @pre block.hasWire()
+   */
+  explicit
+  BlockView(const Block& block);
+
+public: // wire format
+  bool
+  empty() const;
+
+  const uint8_t*
+  wire() const;
+
+  size_t
+  size() const;
+
+public: // type and value
+  uint32_t
+  type() const;
+
+  const uint8_t*
+  value() const;
+
+  size_t
+  value_size() const;
+
+public: // sub elements
+  /** @brief Get iterator to the first sub element
+   *  @note Sub elements are parsed while iterating, so dereferencing or incrementing an
+   *        iterator throws tlv::Error if the value is not a sequence of TLV elements
+   */
+  const_iterator
+  begin() const;
+
+  const_iterator
+  end() const;
+
+  /** @brief Get the first sub element of the requested type
+   *  @return iterator to the sub element, or end() if there is none
+   */
+  const_iterator
+  find(uint32_t type) const;
+
+  /** @brief Get the first sub element of the requested type
+   *  @throw Error there is no sub element of the requested type
+   */
+  BlockView
+  get(uint32_t type) const;
+
+  /** @brief Count sub elements
+   */
+  size_t
+  elements_size() const;
+
+private:
+  const uint8_t* m_begin;
+  const uint8_t* m_valueBegin;
+  const uint8_t* m_end;
+  uint32_t m_type;
+};
+
+/** @brief Forward iterator over sub elements of a BlockView
+ */
+class BlockView::const_iterator : public std::iterator<std::forward_iterator_tag,
+                                                       const BlockView>
+{
+public:
+  const_iterator();
+
+  /** @brief Create iterator at the element beginning at @p position
+   *  @param position start of the element, or @p end
+   *  @param end end of the value of the parent element
+   */
+  const_iterator(const uint8_t* position, const uint8_t* end);
+
+  reference
+  operator*() const;
+
+  pointer
+  operator->() const;
+
+  const_iterator&
+  operator++();
+
+  const_iterator
+  operator++(int);
+
+  bool
+  operator==(const const_iterator& other) const;
+
+  bool
+  operator!=(const const_iterator& other) const;
+
+private:
+  const uint8_t* m_position;
+  const uint8_t* m_end;
+  BlockView m_element; ///< element at m_position, unless m_position == m_end
+};
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+BlockView::BlockView()
+  : m_begin(nullptr)
+  , m_valueBegin(nullptr)
+  , m_end(nullptr)
+  , m_type(std::numeric_limits<uint32_t>::max())
+{
+}
+
+inline
+BlockView::BlockView(const uint8_t* begin, const uint8_t* end)
+  : m_begin(begin)
+  , m_valueBegin(begin)
+{
+  uint64_t length = 0;
+  if (!tlv::readType(m_valueBegin, end, m_type) || !tlv::readVarNumber(m_valueBegin, end, length)) {
+    BOOST_THROW_EXCEPTION(tlv::Error("Insufficient data during TLV processing"));
+  }
+  if (length > static_cast<uint64_t>(end - m_valueBegin)) {
+    BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
+  }
+  m_end = m_valueBegin + length;
+}
+
+inline
+BlockView::BlockView(const Block& block)
+  : m_begin(block.wire())
+  , m_valueBegin(block.value())
+  , m_end(block.wire() + block.size())
+  , m_type(block.type())
+{
+  BOOST_ASSERT(block.hasWire());
+}
+
+inline bool
+BlockView::empty() const
+{
+  return m_begin == nullptr;
+}
+
+inline const uint8_t*
+BlockView::wire() const
+{
+  return m_begin;
+}
+
+inline size_t
+BlockView::size() const
+{
+  return m_end - m_begin;
+}
+
+inline uint32_t
+BlockView::type() const
+{
+  return m_type;
+}
+
+inline const uint8_t*
+BlockView::value() const
+{
+  return m_valueBegin;
+}
+
+inline size_t
+BlockView::value_size() const
+{
+  return m_end - m_valueBegin;
+}
+
+inline BlockView::const_iterator
+BlockView::begin() const
+{
+  return const_iterator(m_valueBegin, m_end);
+}
+
+inline BlockView::const_iterator
+BlockView::end() const
+{
+  return const_iterator(m_end, m_end);
+}
+
+inline BlockView::const_iterator
+BlockView::find(uint32_t type) const
+{
+  const_iterator it = this->begin();
+  const_iterator last = this->end();
+  while (it != last && it->type() != type) {
+    ++it;
+  }
+  return it;
+}
+
+inline BlockView
+BlockView::get(uint32_t type) const
+{
+  const_iterator it = this->find(type);
+  if (it == this->end()) {
+    BOOST_THROW_EXCEPTION(Error("(BlockView::get) Requested a non-existed type [" +
+                                boost::lexical_cast<std::string>(type) + "] from Block"));
+  }
+  return *it;
+}
+
+inline size_t
+BlockView::elements_size() const
+{
+  return std::distance(this->begin(), this->end());
+}
+
+inline
+BlockView::const_iterator::const_iterator()
+  : m_position(nullptr)
+  , m_end(nullptr)
+{
+}
+
+inline
+BlockView::const_iterator::const_iterator(const uint8_t* position, const uint8_t* end)
+  : m_position(position)
+  , m_end(end)
+{
+  if (m_position != m_end) {
+    m_element = BlockView(m_position, m_end);
+  }
+}
+
+inline BlockView::const_iterator::reference
+BlockView::const_iterator::operator*() const
+{
+  return m_element;
+}
+
+inline BlockView::const_iterator::pointer
+BlockView::const_iterator::operator->() const
+{
+  return &m_element;
+}
+
+inline BlockView::const_iterator&
+BlockView::const_iterator::operator++()
+{
+  m_position = m_element.m_end;
+  if (m_position != m_end) {
+    m_element = BlockView(m_position, m_end);
+  }
+  return *this;
+}
+
+inline BlockView::const_iterator
+BlockView::const_iterator::operator++(int)
+{
+  const_iterator copy(*this);
+  ++*this;
+  return copy;
+}
+
+inline bool
+BlockView::const_iterator::operator==(const const_iterator& other) const
+{
+  return m_position == other.m_position;
+}
+
+inline bool
+BlockView::const_iterator::operator!=(const const_iterator& other) const
+{
+  return m_position != other.m_position;
+}
+
+} // namespace ndn
+
+#endif // NDN_ENCODING_BLOCK_VIEW_HPP
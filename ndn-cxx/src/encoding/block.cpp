@@ -23,6 +23,7 @@
 
 #include "block.hpp"
 #include "block-helpers.hpp"
+#include "block-view.hpp"
 
 #include "tlv.hpp"
 #include "encoding-buffer.hpp"
@@ -144,6 +145,20 @@ Block::Block(const Block& block,
   }
 }
 
+Block::Block(const Block& block, const BlockView& element)
+  : m_buffer(block.m_buffer)
+  , m_type(element.type())
+  , m_size(element.size())
+{
+  const uint8_t* base = m_buffer->get();
+  BOOST_ASSERT(base <= element.wire() && element.wire() + element.size() <= base + m_buffer->size());
+
+  m_begin = m_buffer->begin() + (element.wire() - base);
+  m_end = m_begin + element.size();
+  m_value_begin = m_buffer->begin() + (element.value() - base);
+  m_value_end = m_end;
+}
+
 Block::Block(const uint8_t* buffer, size_t maxlength)
 {
   const uint8_t*  tmp_begin = buffer;
@@ -324,31 +339,26 @@ Block::parse() const
   if (!m_subBlocks.empty() || value_size() == 0)
     return;
 
-  Buffer::const_iterator begin = value_begin();
-  Buffer::const_iterator end = value_end();
-
-  while (begin != end)
-    {
-      Buffer::const_iterator element_begin = begin;
-
-      uint32_t type = tlv::readType(begin, end);
-      uint64_t length = tlv::readVarNumber(begin, end);
-
-      if (length > static_cast<uint64_t>(end - begin))
-        {
-          m_subBlocks.clear();
-          BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
-        }
-      Buffer::const_iterator element_end = begin + length;
-
-      m_subBlocks.push_back(Block(m_buffer,
-                                  type,
-                                  element_begin, element_end,
-                                  begin, element_end));
-
-      begin = element_end;
-      // don't do recursive parsing, just the top level
-    }
+  const uint8_t* begin = value();
+  const uint8_t* end = begin + value_size();
+
+  // the first pass validates the elements and counts them, so that the container
+  // is allocated once and no partially parsed state is left behind on error
+  BlockView::const_iterator first(begin, end);
+  BlockView::const_iterator last(end, end);
+  m_subBlocks.reserve(std::distance(first, last));
+
+  for (BlockView::const_iterator element = first; element != last; ++element) {
+    Buffer::const_iterator element_begin = m_value_begin + (element->wire() - begin);
+    Buffer::const_iterator element_end = element_begin + element->size();
+
+    m_subBlocks.push_back(Block(m_buffer,
+                                element->type(),
+                                element_begin, element_end,
+                                element_begin + (element->value() - element->wire()),
+                                element_end));
+    // don't do recursive parsing, just the top level
+  }
 }
 
 void
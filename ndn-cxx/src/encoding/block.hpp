@@ -38,6 +38,8 @@ class const_buffer;
 
 namespace ndn {
 
+class BlockView;
+
 /** @brief Class representing a wire element of NDN-TLV packet format
  */
 class Block
@@ -90,6 +92,14 @@ public: // constructor, creation, assignment
         const Buffer::const_iterator& begin, const Buffer::const_iterator& end,
         bool verifyLength = true);
 
+  /** @brief Create a Block from an element within the underlying buffer of another block,
+   *         reusing the buffer (no parsing)
+   *
+   *  @param block block whose buffer holds the element
+   *  @param element view of the element, e.g., a sub element of BlockView(block)
+   */
+  Block(const Block& block, const BlockView& element);
+
   /** @brief Create a Block from the raw buffer with Type-Length parsing
    */
   Block(const uint8_t* buffer, size_t maxlength);
@@ -78,6 +78,13 @@ enum {
   NInBytes      = 148,
   NOutBytes     = 149,
 
+  // ForwarderStatus memory pools, encoded after the counters
+  AllocatorStatus  = 151,
+  AllocatorName    = 152,
+  BlockSize        = 153,
+  NAllocatedBlocks = 154,
+  NBlocks          = 155,
+
   // FIB Management
   FibEntry      = 128,
   NextHopRecord = 129,
@@ -20,6 +20,7 @@
  */
 
 #include "interest.hpp"
+#include "encoding/block-view.hpp"
 #include "util/random.hpp"
 #include "util/crypto.hpp"
 #include "data.hpp"
@@ -295,7 +296,6 @@ void
 Interest::wireDecode(const Block& wire)
 {
   m_wire = wire;
-  m_wire.parse();
 
   // Interest ::= INTEREST-TYPE TLV-LENGTH
   //                Name
@@ -308,26 +308,61 @@ Interest::wireDecode(const Block& wire)
   if (m_wire.type() != tlv::Interest)
     BOOST_THROW_EXCEPTION(Error("Unexpected TLV number when decoding Interest"));
 
+  // elements are located in a single walk over m_wire without parsing it into sub blocks;
+  // only those kept by the Interest become Blocks, sharing the buffer of m_wire
+  BlockView name, selectors, nonce, interestLifetime, link, selectedDelegation;
+  for (const BlockView& element : BlockView(m_wire)) {
+    BlockView* field = nullptr;
+    switch (element.type()) {
+      case tlv::Name:
+        field = &name;
+        break;
+      case tlv::Selectors:
+        field = &selectors;
+        break;
+      case tlv::Nonce:
+        field = &nonce;
+        break;
+      case tlv::InterestLifetime:
+        field = &interestLifetime;
+        break;
+      case tlv::Data:
+        field = &link;
+        break;
+      case tlv::SelectedDelegation:
+        field = &selectedDelegation;
+        break;
+      default:
+        break;
+    }
+    if (field != nullptr && field->empty()) {
+      *field = element;
+    }
+  }
+
   // Name
-  m_name.wireDecode(m_wire.get(tlv::Name));
+  if (name.empty())
+    BOOST_THROW_EXCEPTION(Error("Name element is missing when decoding Interest"));
+  m_name.wireDecode(Block(m_wire, name));
 
   // Selectors
-  Block::element_const_iterator val = m_wire.find(tlv::Selectors);
-  if (val != m_wire.elements_end())
+  if (!selectors.empty())
     {
-      m_selectors.wireDecode(*val);
+      m_selectors.wireDecode(Block(m_wire, selectors));
     }
   else
     m_selectors = Selectors();
 
   // Nonce
-  m_nonce = m_wire.get(tlv::Nonce);
+  if (nonce.empty())
+    BOOST_THROW_EXCEPTION(Error("Nonce element is missing when decoding Interest"));
+  m_nonce = Block(m_wire, nonce);
 
   // InterestLifetime
-  val = m_wire.find(tlv::InterestLifetime);
-  if (val != m_wire.elements_end())
+  if (!interestLifetime.empty())
     {
-      m_interestLifetime = time::milliseconds(readNonNegativeInteger(*val));
+      m_interestLifetime = time::milliseconds(readNonNegativeInteger(Block(m_wire,
+                                                                           interestLifetime)));
     }
   else
     {
@@ -335,21 +370,19 @@ Interest::wireDecode(const Block& wire)
     }
 
   // Link object
-  val = m_wire.find(tlv::Data);
-  if (val != m_wire.elements_end())
+  if (!link.empty())
     {
-      m_link = (*val);
+      m_link = Block(m_wire, link);
     }
 
   // SelectedDelegation
-  val = m_wire.find(tlv::SelectedDelegation);
-  if (val != m_wire.elements_end()) {
+  if (!selectedDelegation.empty()) {
     if (!this->hasLink()) {
       BOOST_THROW_EXCEPTION(Error("Interest contains selectedDelegation, but no LINK object"));
     }
-    uint64_t selectedDelegation = readNonNegativeInteger(*val);
-    if (selectedDelegation < uint64_t(Link::countDelegationsFromWire(m_link))) {
-      m_selectedDelegationIndex = static_cast<size_t>(selectedDelegation);
+    uint64_t delegationIndex = readNonNegativeInteger(Block(m_wire, selectedDelegation));
+    if (delegationIndex < uint64_t(Link::countDelegationsFromWire(m_link))) {
+      m_selectedDelegationIndex = static_cast<size_t>(delegationIndex);
     }
     else {
       BOOST_THROW_EXCEPTION(Error("Invalid selected delegation index when decoding Interest"));
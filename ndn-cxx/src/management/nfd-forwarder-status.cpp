@@ -59,6 +59,22 @@ ForwarderStatus::wireEncode(EncodingImpl<TAG>& encoder) const
 {
   size_t totalLength = 0;
 
+  for (auto it = m_allocators.rbegin(); it != m_allocators.rend(); ++it) {
+    size_t allocatorLength = 0;
+    allocatorLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NBlocks,
+                                                      it->nBlocks);
+    allocatorLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NAllocatedBlocks,
+                                                      it->nAllocatedBlocks);
+    allocatorLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::BlockSize,
+                                                      it->blockSize);
+    allocatorLength += encoder.prependByteArrayBlock(tlv::nfd::AllocatorName,
+                                         reinterpret_cast<const uint8_t*>(it->name.c_str()),
+                                         it->name.size());
+    allocatorLength += encoder.prependVarNumber(allocatorLength);
+    allocatorLength += encoder.prependVarNumber(tlv::nfd::AllocatorStatus);
+    totalLength += allocatorLength;
+  }
+
   totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutDatas,
                                                 m_nOutDatas);
   totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutInterests,
@@ -217,6 +233,47 @@ ForwarderStatus::wireDecode(const Block& block)
   else {
     BOOST_THROW_EXCEPTION(Error("missing required NOutDatas field"));
   }
+
+  m_allocators.clear();
+  for (; val != m_wire.elements_end() && val->type() == tlv::nfd::AllocatorStatus; ++val) {
+    val->parse();
+    Block::element_const_iterator field = val->elements_begin();
+    AllocatorStatus allocator;
+
+    if (field != val->elements_end() && field->type() == tlv::nfd::AllocatorName) {
+      allocator.name.assign(reinterpret_cast<const char*>(field->value()), field->value_size());
+      ++field;
+    }
+    else {
+      BOOST_THROW_EXCEPTION(Error("missing required AllocatorName field"));
+    }
+
+    if (field != val->elements_end() && field->type() == tlv::nfd::BlockSize) {
+      allocator.blockSize = readNonNegativeInteger(*field);
+      ++field;
+    }
+    else {
+      BOOST_THROW_EXCEPTION(Error("missing required BlockSize field"));
+    }
+
+    if (field != val->elements_end() && field->type() == tlv::nfd::NAllocatedBlocks) {
+      allocator.nAllocatedBlocks = readNonNegativeInteger(*field);
+      ++field;
+    }
+    else {
+      BOOST_THROW_EXCEPTION(Error("missing required NAllocatedBlocks field"));
+    }
+
+    if (field != val->elements_end() && field->type() == tlv::nfd::NBlocks) {
+      allocator.nBlocks = readNonNegativeInteger(*field);
+      ++field;
+    }
+    else {
+      BOOST_THROW_EXCEPTION(Error("missing required NBlocks field"));
+    }
+
+    m_allocators.push_back(allocator);
+  }
 }
 
 ForwarderStatus&
@@ -315,5 +372,21 @@ ForwarderStatus::setNOutDatas(uint64_t nOutDatas)
   return *this;
 }
 
+ForwarderStatus&
+ForwarderStatus::addAllocator(const AllocatorStatus& allocator)
+{
+  m_wire.reset();
+  m_allocators.push_back(allocator);
+  return *this;
+}
+
+ForwarderStatus&
+ForwarderStatus::clearAllocators()
+{
+  m_wire.reset();
+  m_allocators.clear();
+  return *this;
+}
+
 } // namespace nfd
 } // namespace ndn
@@ -46,6 +46,18 @@ public:
     }
   };
 
+  /** \brief statistics of a memory pool used by forwarding tables
+   *
+   *  AllocatorStatus elements are optional and follow the counters in ForwarderStatus.
+   */
+  struct AllocatorStatus
+  {
+    std::string name;
+    uint64_t blockSize;
+    uint64_t nAllocatedBlocks;
+    uint64_t nBlocks;
+  };
+
   ForwarderStatus();
 
   explicit
@@ -182,6 +194,18 @@ public: // getters & setters
   ForwarderStatus&
   setNOutDatas(uint64_t nOutDatas);
 
+  const std::vector<AllocatorStatus>&
+  getAllocators() const
+  {
+    return m_allocators;
+  }
+
+  ForwarderStatus&
+  addAllocator(const AllocatorStatus& allocator);
+
+  ForwarderStatus&
+  clearAllocators();
+
 private:
   std::string m_nfdVersion;
   time::system_clock::TimePoint m_startTimestamp;
@@ -195,6 +219,7 @@ private:
   uint64_t m_nInDatas;
   uint64_t m_nOutInterests;
   uint64_t m_nOutDatas;
+  std::vector<AllocatorStatus> m_allocators;
 
   mutable Block m_wire;
 };
@@ -135,6 +135,10 @@ MetaInfo::wireEncode(EncodingImpl<TAG>& encoder) const
   //                FinalBlockId?
   //                AppMetaInfo*
 
+  // m_wire is reset by every setter, so a cached wire is up to date
+  if (m_wire.hasWire())
+    return encoder.prependBlock(m_wire);
+
   size_t totalLength = 0;
 
   for (std::list<Block>::const_reverse_iterator appMetaInfoItem = m_appMetaInfo.rbegin();
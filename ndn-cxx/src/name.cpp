@@ -68,6 +68,11 @@ template<encoding::Tag TAG>
 size_t
 Name::wireEncode(EncodingImpl<TAG>& encoder) const
 {
+  // a decoded or previously encoded Name is copied as a whole, so that both the estimation
+  // and the encoding of a packet carrying an unchanged Name take a single step
+  if (m_nameBlock.hasWire())
+    return encoder.prependBlock(m_nameBlock);
+
   size_t totalLength = 0;
 
   for (const_reverse_iterator i = rbegin(); i != rend(); ++i)
@@ -700,7 +700,12 @@ KeyChain::signPacketWrapper(Data& data, const Signature& signature,
 {
   data.setSignature(signature);
 
-  EncodingBuffer encoder;
+  // the buffer fits the unsigned portion with the outer Type-Length in front of it
+  // and, unless the key is unusually large, the SignatureValue appended to it
+  EncodingEstimator estimator;
+  size_t unsignedSize = data.wireEncode(estimator, true);
+  const size_t reserveFromBack = 400;
+  EncodingBuffer encoder(unsignedSize + 2 * 9 + reserveFromBack, reserveFromBack);
   data.wireEncode(encoder, true);
 
   Block sigValue = pureSign(encoder.buf(), encoder.size(), keyName, digestAlgorithm);
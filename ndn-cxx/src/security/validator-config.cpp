@@ -377,6 +377,8 @@ ValidatorConfig::onConfigTrustAnchor(const security::conf::ConfigSection& config
 void
 ValidatorConfig::reset()
 {
+  m_verifiedKeys.clear();
+
   if (static_cast<bool>(m_certificateCache))
     m_certificateCache->reset();
   m_interestRules.clear();
@@ -790,7 +792,9 @@ ValidatorConfig::checkSignature(const Packet& packet,
 
   if (static_cast<bool>(trustedCert))
     {
-      if (verifySignature(packet, signature, trustedCert->getPublicKeyInfo()))
+      shared_ptr<const VerificationKey> key =
+        getVerificationKey(signature.getKeyLocator(), trustedCert->getPublicKeyInfo());
+      if (verifySignature(packet, signature, *key))
         return onValidated(packet.shared_from_this());
       else
         return onValidationFailed(packet.shared_from_this(),
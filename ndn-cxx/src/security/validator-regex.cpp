@@ -154,7 +154,9 @@ ValidatorRegex::checkPolicy(const Data& data,
 
               if (static_cast<bool>(trustedCert))
                 {
-                  if (verifySignature(data, data.getSignature(), trustedCert->getPublicKeyInfo()))
+                  shared_ptr<const VerificationKey> key =
+                    getVerificationKey(keyLocator, trustedCert->getPublicKeyInfo());
+                  if (verifySignature(data, data.getSignature(), *key))
                     return onValidated(data.shared_from_this());
                   else
                     return onValidationFailed(data.shared_from_this(),
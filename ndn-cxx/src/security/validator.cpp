@@ -29,10 +29,9 @@
 
 #include "cryptopp.hpp"
 
-namespace ndn {
+#include <boost/thread/thread.hpp>
 
-static OID SECP256R1("1.2.840.10045.3.1.7");
-static OID SECP384R1("1.3.132.0.34");
+namespace ndn {
 
 Validator::Validator(Face* face)
   : m_face(face)
@@ -103,7 +102,7 @@ Validator::onData(const Interest& interest,
 }
 
 bool
-Validator::verifySignature(const Data& data, const PublicKey& key)
+Validator::verifySignature(const Data& data, const VerificationKey& key)
 {
   if (!data.getSignature().hasKeyLocator())
     return false;
@@ -115,7 +114,7 @@ Validator::verifySignature(const Data& data, const PublicKey& key)
 }
 
 bool
-Validator::verifySignature(const Interest& interest, const PublicKey& key)
+Validator::verifySignature(const Interest& interest, const VerificationKey& key)
 {
   const Name& interestName = interest.getName();
 
@@ -142,100 +141,50 @@ Validator::verifySignature(const Interest& interest, const PublicKey& key)
     }
 }
 
-bool
-Validator::verifySignature(const uint8_t* buf,
-                           const size_t size,
-                           const Signature& sig,
-                           const PublicKey& key)
+std::vector<bool>
+Validator::verifySignatures(const std::vector<shared_ptr<const Data>>& data,
+                            const PublicKey& publicKey,
+                            size_t nThreads)
 {
-  try
-    {
-      using namespace CryptoPP;
-
-      switch (sig.getType())
-        {
-        case tlv::SignatureSha256WithRsa:
-          {
-            if (key.getKeyType() != KEY_TYPE_RSA)
-              return false;
-
-            RSA::PublicKey publicKey;
-            ByteQueue queue;
-
-            queue.Put(reinterpret_cast<const byte*>(key.get().buf()), key.get().size());
-            publicKey.Load(queue);
-
-            RSASS<PKCS1v15, SHA256>::Verifier verifier(publicKey);
-            return verifier.VerifyMessage(buf, size,
-                                          sig.getValue().value(), sig.getValue().value_size());
-          }
-        case tlv::SignatureSha256WithEcdsa:
-          {
-            if (key.getKeyType() != KEY_TYPE_ECDSA)
-              return false;
-
-            ECDSA<ECP, SHA256>::PublicKey publicKey;
-            ByteQueue queue;
-
-            queue.Put(reinterpret_cast<const byte*>(key.get().buf()), key.get().size());
-            publicKey.Load(queue);
-
-            ECDSA<ECP, SHA256>::Verifier verifier(publicKey);
-
-            uint32_t length = 0;
-            StringSource src(key.get().buf(), key.get().size(), true);
-            BERSequenceDecoder subjectPublicKeyInfo(src);
-            {
-              BERSequenceDecoder algorithmInfo(subjectPublicKeyInfo);
-              {
-                OID algorithm;
-                algorithm.decode(algorithmInfo);
-
-                OID curveId;
-                curveId.decode(algorithmInfo);
-
-                if (curveId == SECP256R1)
-                  length = 256;
-                else if (curveId == SECP384R1)
-                  length = 384;
-                else
-                  return false;
-              }
-            }
-
-            switch (length)
-              {
-              case 256:
-                {
-                  uint8_t buffer[64];
-                  size_t usedSize = DSAConvertSignatureFormat(buffer, 64, DSA_P1363,
-                                                              sig.getValue().value(),
-                                                              sig.getValue().value_size(),
-                                                              DSA_DER);
-                  return verifier.VerifyMessage(buf, size, buffer, usedSize);
-                }
-              case 384:
-                {
-                  uint8_t buffer[96];
-                  size_t usedSize = DSAConvertSignatureFormat(buffer, 96, DSA_P1363,
-                                                              sig.getValue().value(),
-                                                              sig.getValue().value_size(),
-                                                              DSA_DER);
-                  return verifier.VerifyMessage(buf, size, buffer, usedSize);
-                }
-              default:
-                return false;
-              }
-          }
-        default:
-          // Unsupported sig type
-          return false;
-        }
-    }
-  catch (CryptoPP::Exception& e)
-    {
-      return false;
+  if (data.empty())
+    return {};
+
+  // Data::wireEncode caches the encoding, so it must not be first called concurrently
+  for (const shared_ptr<const Data>& packet : data) {
+    packet->wireEncode();
+  }
+
+  nThreads = std::max<size_t>(1, std::min(nThreads, data.size()));
+  size_t chunkSize = (data.size() + nThreads - 1) / nThreads;
+
+  // Crypto++ initializes some of its static objects on first use, which is not thread-safe.
+  // Therefore, every thread's key is decoded, and the first packet is verified, before
+  // other threads start.  A decoded key is not shared among threads.
+  std::vector<unique_ptr<VerificationKey>> keys;
+  for (size_t i = 0; i < nThreads; ++i) {
+    keys.push_back(unique_ptr<VerificationKey>(new VerificationKey(publicKey)));
+  }
+
+  // unlike std::vector<bool>, distinct elements can be written concurrently
+  std::vector<uint8_t> isValid(data.size());
+  auto verifyRange = [&] (const VerificationKey& key, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      isValid[i] = verifySignature(*data[i], key);
     }
+  };
+  verifyRange(*keys[0], 0, 1);
+
+  boost::thread_group threads;
+  for (size_t i = 1; i < nThreads; ++i) {
+    size_t begin = std::min(i * chunkSize, data.size());
+    size_t end = std::min(begin + chunkSize, data.size());
+    const VerificationKey& key = *keys[i];
+    threads.create_thread([&verifyRange, &key, begin, end] { verifyRange(key, begin, end); });
+  }
+  verifyRange(*keys[0], 1, chunkSize);
+  threads.join_all();
+
+  return std::vector<bool>(isValid.begin(), isValid.end());
 }
 
 bool
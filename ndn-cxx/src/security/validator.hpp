@@ -35,6 +35,7 @@
 #include "digest-sha256.hpp"
 #include "validation-request.hpp"
 #include "identity-certificate.hpp"
+#include "verified-key-cache.hpp"
 
 namespace ndn {
 
@@ -107,7 +108,14 @@ public:
 
   /// @brief Verify the data using the publicKey.
   static bool
-  verifySignature(const Data& data, const PublicKey& publicKey);
+  verifySignature(const Data& data, const PublicKey& publicKey)
+  {
+    return verifySignature(data, VerificationKey(publicKey));
+  }
+
+  /// @brief Verify the data using the decoded key.
+  static bool
+  verifySignature(const Data& data, const VerificationKey& key);
 
   /**
    * @brief Verify the signed Interest using the publicKey.
@@ -115,7 +123,32 @@ public:
    * (Note the signature covers the first n-2 name components).
    */
   static bool
-  verifySignature(const Interest& interest, const PublicKey& publicKey);
+  verifySignature(const Interest& interest, const PublicKey& publicKey)
+  {
+    return verifySignature(interest, VerificationKey(publicKey));
+  }
+
+  /**
+   * @brief Verify the signed Interest using the decoded key.
+   *
+   * (Note the signature covers the first n-2 name components).
+   */
+  static bool
+  verifySignature(const Interest& interest, const VerificationKey& key);
+
+  /**
+   * @brief Verify Data packets signed by the same key.
+   *
+   * The key is decoded once per thread, rather than once per packet.  With @p nThreads
+   * greater than one, the packets are split among that many threads, including the calling one.
+   * @p nThreads of zero is the same as one.
+   *
+   * @return for each packet in @p data, whether its signature is valid
+   */
+  static std::vector<bool>
+  verifySignatures(const std::vector<shared_ptr<const Data>>& data,
+                   const PublicKey& publicKey,
+                   size_t nThreads = 1);
 
   /// @brief Verify the blob using the publicKey against the signature.
   static bool
@@ -129,10 +162,19 @@ public:
   verifySignature(const Data& data,
                   const Signature& sig,
                   const PublicKey& publicKey)
+  {
+    return verifySignature(data, sig, VerificationKey(publicKey));
+  }
+
+  /// @brief Verify the data using the decoded key against the signature.
+  static bool
+  verifySignature(const Data& data,
+                  const Signature& sig,
+                  const VerificationKey& key)
   {
     return verifySignature(data.wireEncode().value(),
                            data.wireEncode().value_size() - data.getSignature().getValue().size(),
-                           sig, publicKey);
+                           sig, key);
   }
 
   /** @brief Verify the interest using the publicKey against the SHA256-RSA signature.
@@ -143,6 +185,18 @@ public:
   verifySignature(const Interest& interest,
                   const Signature& sig,
                   const PublicKey& publicKey)
+  {
+    return verifySignature(interest, sig, VerificationKey(publicKey));
+  }
+
+  /** @brief Verify the interest using the decoded key against the signature.
+   *
+   * (Note the signature covers the first n-2 name components).
+   */
+  static bool
+  verifySignature(const Interest& interest,
+                  const Signature& sig,
+                  const VerificationKey& key)
   {
     if (interest.getName().size() < 2)
       return false;
@@ -151,7 +205,7 @@ public:
 
     return verifySignature(name.wireEncode().value(),
                            name.wireEncode().value_size() - name[-1].size(),
-                           sig, publicKey);
+                           sig, key);
   }
 
   /// @brief Verify the blob using the publicKey against the SHA256-RSA signature.
@@ -159,7 +213,20 @@ public:
   verifySignature(const uint8_t* buf,
                   const size_t size,
                   const Signature& sig,
-                  const PublicKey& publicKey);
+                  const PublicKey& publicKey)
+  {
+    return verifySignature(buf, size, sig, VerificationKey(publicKey));
+  }
+
+  /// @brief Verify the blob using the decoded key against the signature.
+  static bool
+  verifySignature(const uint8_t* buf,
+                  const size_t size,
+                  const Signature& sig,
+                  const VerificationKey& key)
+  {
+    return key.verify(buf, size, sig);
+  }
 
 
   /// @brief Verify the data against the SHA256 signature.
@@ -242,6 +309,20 @@ protected:
 
   typedef function<void(const std::string&)> OnFailure;
 
+  /**
+   * @brief Get decoded key of the signer identified by @p keyLocator.
+   *
+   * @param keyLocator KeyLocator of the packet to verify
+   * @param publicKey  key from the validated certificate of the signer
+   *
+   * The decoded key is cached, so that packets by the same signer do not decode it again.
+   */
+  shared_ptr<const VerificationKey>
+  getVerificationKey(const KeyLocator& keyLocator, const PublicKey& publicKey)
+  {
+    return m_verifiedKeys.get(keyLocator, publicKey);
+  }
+
   /// @brief Process the received certificate.
   void
   onData(const Interest& interest,
@@ -313,6 +394,7 @@ protected:
 
 protected:
   Face* m_face;
+  VerifiedKeyCache m_verifiedKeys;
 };
 
 } // namespace ndn
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "verification-key.hpp"
+
+#include "cryptopp.hpp"
+
+namespace ndn {
+
+static const CryptoPP::OID SECP256R1("1.2.840.10045.3.1.7");
+static const CryptoPP::OID SECP384R1("1.3.132.0.34");
+
+class VerificationKey::Impl
+{
+public:
+  typedef CryptoPP::RSASS<CryptoPP::PKCS1v15, CryptoPP::SHA256>::Verifier RsaVerifier;
+  typedef CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>::Verifier EcdsaVerifier;
+
+  unique_ptr<RsaVerifier> rsaVerifier;
+  unique_ptr<EcdsaVerifier> ecdsaVerifier;
+  size_t ecdsaSignatureSize = 0; ///< size of ECDSA signature in IEEE P1363 format
+};
+
+VerificationKey::VerificationKey(const PublicKey& key)
+  : m_publicKey(key)
+  , m_keyType(key.getKeyType())
+{
+  try {
+    using namespace CryptoPP;
+
+    switch (m_keyType) {
+    case KEY_TYPE_RSA: {
+      RSA::PublicKey publicKey;
+      ByteQueue queue;
+      queue.Put(reinterpret_cast<const byte*>(key.get().buf()), key.get().size());
+      publicKey.Load(queue);
+
+      unique_ptr<Impl> impl(new Impl);
+      impl->rsaVerifier.reset(new Impl::RsaVerifier(publicKey));
+      m_impl = std::move(impl);
+      break;
+    }
+    case KEY_TYPE_ECDSA: {
+      size_t signatureSize = 0;
+      StringSource src(key.get().buf(), key.get().size(), true);
+      BERSequenceDecoder subjectPublicKeyInfo(src);
+      {
+        BERSequenceDecoder algorithmInfo(subjectPublicKeyInfo);
+        {
+          OID algorithm;
+          algorithm.decode(algorithmInfo);
+
+          OID curveId;
+          curveId.decode(algorithmInfo);
+
+          if (curveId == SECP256R1)
+            signatureSize = 64;
+          else if (curveId == SECP384R1)
+            signatureSize = 96;
+          else
+            return;
+        }
+      }
+
+      ECDSA<ECP, SHA256>::PublicKey publicKey;
+      ByteQueue queue;
+      queue.Put(reinterpret_cast<const byte*>(key.get().buf()), key.get().size());
+      publicKey.Load(queue);
+
+      unique_ptr<Impl> impl(new Impl);
+      impl->ecdsaVerifier.reset(new Impl::EcdsaVerifier(publicKey));
+      impl->ecdsaSignatureSize = signatureSize;
+      m_impl = std::move(impl);
+      break;
+    }
+    default:
+      break;
+    }
+  }
+  catch (const CryptoPP::Exception&) {
+    m_impl.reset();
+  }
+}
+
+VerificationKey::~VerificationKey() = default;
+
+bool
+VerificationKey::verify(const uint8_t* buf, size_t size, const Signature& sig) const
+{
+  if (m_impl == nullptr)
+    return false;
+
+  try {
+    using namespace CryptoPP;
+
+    switch (sig.getType()) {
+    case tlv::SignatureSha256WithRsa: {
+      if (m_impl->rsaVerifier == nullptr)
+        return false;
+
+      return m_impl->rsaVerifier->VerifyMessage(buf, size,
+                                                sig.getValue().value(),
+                                                sig.getValue().value_size());
+    }
+    case tlv::SignatureSha256WithEcdsa: {
+      if (m_impl->ecdsaVerifier == nullptr)
+        return false;
+
+      uint8_t buffer[96];
+      size_t usedSize = DSAConvertSignatureFormat(buffer, m_impl->ecdsaSignatureSize, DSA_P1363,
+                                                  sig.getValue().value(),
+                                                  sig.getValue().value_size(),
+                                                  DSA_DER);
+      return m_impl->ecdsaVerifier->VerifyMessage(buf, size, buffer, usedSize);
+    }
+    default:
+      // Unsupported sig type
+      return false;
+    }
+  }
+  catch (const CryptoPP::Exception&) {
+    return false;
+  }
+}
+
+} // namespace ndn
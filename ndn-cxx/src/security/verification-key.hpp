@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_VERIFICATION_KEY_HPP
+#define NDN_SECURITY_VERIFICATION_KEY_HPP
+
+#include "../common.hpp"
+#include "../signature.hpp"
+#include "public-key.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Public key decoded into a form ready to verify signatures
+ *
+ * Decoding a PublicKey is a large part of the cost of a signature verification.  A
+ * VerificationKey decodes it once, so that many signatures by the same key can be verified
+ * without decoding it again.
+ *
+ * A VerificationKey may be used by one thread at a time.
+ */
+class VerificationKey : noncopyable
+{
+public:
+  /**
+   * @brief Decode @p key
+   *
+   * If @p key cannot be decoded, the VerificationKey is created, but cannot verify any signature.
+   */
+  explicit
+  VerificationKey(const PublicKey& key);
+
+  ~VerificationKey();
+
+  KeyType
+  getKeyType() const
+  {
+    return m_keyType;
+  }
+
+  const PublicKey&
+  getPublicKey() const
+  {
+    return m_publicKey;
+  }
+
+  /**
+   * @brief Verify @p sig over the blob
+   * @return false if the signature is invalid, or its type does not match the type of the key
+   */
+  bool
+  verify(const uint8_t* buf, size_t size, const Signature& sig) const;
+
+private:
+  class Impl;
+
+  PublicKey m_publicKey;
+  KeyType m_keyType;
+  unique_ptr<Impl> m_impl;
+};
+
+} // namespace ndn
+
+#endif // NDN_SECURITY_VERIFICATION_KEY_HPP
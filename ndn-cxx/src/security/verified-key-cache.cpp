@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "verified-key-cache.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace ndn {
+
+size_t
+VerifiedKeyCache::BlockHash::operator()(const Block& block) const
+{
+  return boost::hash_range(block.wire(), block.wire() + block.size());
+}
+
+VerifiedKeyCache::VerifiedKeyCache(size_t capacity)
+  : m_capacity(capacity)
+{
+  BOOST_ASSERT(m_capacity > 0);
+}
+
+VerifiedKeyCache::EntryList::iterator
+VerifiedKeyCache::lookup(const Block& wire)
+{
+  auto it = m_keys.find(wire);
+  if (it == m_keys.end()) {
+    return m_entries.end();
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second;
+}
+
+shared_ptr<const VerificationKey>
+VerifiedKeyCache::get(const KeyLocator& keyLocator, const PublicKey& key)
+{
+  const Block& wire = keyLocator.wireEncode();
+
+  auto entry = this->lookup(wire);
+  if (entry != m_entries.end()) {
+    if (entry->key->getPublicKey() == key) {
+      return entry->key;
+    }
+
+    // the signer has a different key now
+    entry->key = make_shared<VerificationKey>(key);
+    return entry->key;
+  }
+
+  if (m_keys.size() >= m_capacity) {
+    m_keys.erase(m_entries.back().keyLocatorWire);
+    m_entries.pop_back();
+  }
+
+  m_entries.push_front(Entry{wire, make_shared<VerificationKey>(key)});
+  m_keys.emplace(wire, m_entries.begin());
+  return m_entries.front().key;
+}
+
+shared_ptr<const VerificationKey>
+VerifiedKeyCache::find(const KeyLocator& keyLocator)
+{
+  auto entry = this->lookup(keyLocator.wireEncode());
+  if (entry == m_entries.end()) {
+    return nullptr;
+  }
+  return entry->key;
+}
+
+void
+VerifiedKeyCache::erase(const KeyLocator& keyLocator)
+{
+  auto it = m_keys.find(keyLocator.wireEncode());
+  if (it != m_keys.end()) {
+    m_entries.erase(it->second);
+    m_keys.erase(it);
+  }
+}
+
+void
+VerifiedKeyCache::clear()
+{
+  m_keys.clear();
+  m_entries.clear();
+}
+
+} // namespace ndn
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_VERIFIED_KEY_CACHE_HPP
+#define NDN_SECURITY_VERIFIED_KEY_CACHE_HPP
+
+#include "../common.hpp"
+#include "../key-locator.hpp"
+#include "verification-key.hpp"
+
+#include <list>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Cache of decoded keys of signers whose certificates have been validated
+ *
+ * Keys are looked up by the KeyLocator that packets carry, through a hash of its wire encoding.
+ * The cache holds at most a fixed number of keys; the least recently used key is evicted first.
+ *
+ * The cache does not decide whether a key is trusted: the caller obtains the PublicKey from
+ * a validated certificate, and a cached key is returned only if it is the same PublicKey.
+ */
+class VerifiedKeyCache : noncopyable
+{
+public:
+  explicit
+  VerifiedKeyCache(size_t capacity = 1024);
+
+  /**
+   * @brief Get decoded @p key of the signer identified by @p keyLocator
+   *
+   * If the cache does not have @p key for @p keyLocator, @p key is decoded and cached,
+   * replacing any other key for @p keyLocator.
+   */
+  shared_ptr<const VerificationKey>
+  get(const KeyLocator& keyLocator, const PublicKey& key);
+
+  /**
+   * @brief Get decoded key for @p keyLocator, or nullptr if it is not cached
+   */
+  shared_ptr<const VerificationKey>
+  find(const KeyLocator& keyLocator);
+
+  void
+  erase(const KeyLocator& keyLocator);
+
+  void
+  clear();
+
+  size_t
+  size() const
+  {
+    return m_keys.size();
+  }
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+private:
+  struct Entry
+  {
+    Block keyLocatorWire;
+    shared_ptr<const VerificationKey> key;
+  };
+
+  /// entries from the most to the least recently used
+  typedef std::list<Entry> EntryList;
+
+  struct BlockHash
+  {
+    size_t
+    operator()(const Block& block) const;
+  };
+
+  EntryList::iterator
+  lookup(const Block& wire);
+
+private:
+  size_t m_capacity;
+  EntryList m_entries;
+  std::unordered_map<Block, EntryList::iterator, BlockHash> m_keys; ///< KeyLocator wire => entry
+};
+
+} // namespace ndn
+
+#endif // NDN_SECURITY_VERIFIED_KEY_CACHE_HPP
@@ -23,127 +23,437 @@
 
 #include "scheduler.hpp"
 
-namespace ns3 {
-
-/// @cond include_hidden
-
-template<>
-struct EventMemberImplObjTraits<std::function<void()>> {
-  typedef std::function<void()> T;
-  static T&
-  GetReference(T& p)
-  {
-    return p;
-  }
-};
-
-/// @endcond
-
-} // namespace ns3
+#include <algorithm>
+#include <tuple>
 
 namespace ndn {
 namespace util {
 namespace scheduler {
 
-struct EventIdImpl
+namespace {
+
+/** \brief allocator that recycles fixed-size blocks through a free list
+ *
+ *  Event records are created with std::allocate_shared, so a record and its shared_ptr
+ *  control block share one pooled block.  Blocks are allocated in chunks and are never
+ *  returned to the system.
+ *
+ *  The free list is shared by all schedulers and is not synchronized, so every Scheduler
+ *  must be used on the thread that runs the ns-3 simulator.  The simulator executes all
+ *  events on that one thread, and a distributed simulation runs one process per MPI rank.
+ *  This is the same technique as nfd::MemoryPool, which cannot be used here because NFD
+ *  is built on top of ndn-cxx.
+ */
+template<typename T>
+class PoolAllocator
 {
-  EventIdImpl(const Scheduler::EventQueue::iterator& event)
-    : m_event(event)
-    , m_isValid(true)
+public:
+  typedef T value_type;
+
+  template<typename U>
+  struct rebind
   {
-  }
+    typedef PoolAllocator<U> other;
+  };
 
-  void
-  invalidate()
+  PoolAllocator()
   {
-    m_isValid = false;
   }
 
-  bool
-  isValid() const
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U>&)
   {
-    return m_isValid;
   }
 
-  operator const Scheduler::EventQueue::iterator&() const
+  T*
+  allocate(size_t n)
   {
-    return m_event;
+    if (n != 1) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    if (s_freeList == nullptr) {
+      refill();
+    }
+    FreeBlock* block = s_freeList;
+    s_freeList = block->next;
+    return reinterpret_cast<T*>(block);
   }
 
   void
-  reset(const Scheduler::EventQueue::iterator& newIterator)
+  deallocate(T* p, size_t n)
   {
-    m_event = newIterator;
-    m_isValid = true;
+    if (n != 1) {
+      ::operator delete(p);
+      return;
+    }
+
+    FreeBlock* block = reinterpret_cast<FreeBlock*>(p);
+    block->next = s_freeList;
+    s_freeList = block;
   }
 
 private:
-  Scheduler::EventQueue::iterator m_event;
-  bool m_isValid;
+  union FreeBlock
+  {
+    FreeBlock* next;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  static void
+  refill()
+  {
+    FreeBlock* chunk = static_cast<FreeBlock*>(::operator new(CHUNK_SIZE * sizeof(FreeBlock)));
+    for (size_t i = CHUNK_SIZE; i > 0; --i) {
+      chunk[i - 1].next = s_freeList;
+      s_freeList = &chunk[i - 1];
+    }
+  }
+
+private:
+  static const size_t CHUNK_SIZE = 256;
+  static FreeBlock* s_freeList;
 };
 
-Scheduler::EventInfo::EventInfo(const time::nanoseconds& after,
-                                const Event& event)
-  : m_scheduledTime(time::steady_clock::now() + after)
-  , m_event(event)
+template<typename T>
+typename PoolAllocator<T>::FreeBlock* PoolAllocator<T>::s_freeList = nullptr;
+
+template<typename T, typename U>
+bool
+operator==(const PoolAllocator<T>&, const PoolAllocator<U>&)
 {
+  return true;
 }
 
-Scheduler::EventInfo::EventInfo(const time::steady_clock::TimePoint& when,
-                                const EventInfo& previousEvent)
-  : m_scheduledTime(when)
-  , m_event(previousEvent.m_event)
-  , m_eventId(previousEvent.m_eventId)
+template<typename T, typename U>
+bool
+operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&)
 {
+  return false;
 }
 
-time::nanoseconds
-Scheduler::EventInfo::expiresFromNow() const
+/** \return the smallest multiple of \p n that is not less than \p x
+ *  \param n a power of two
+ */
+static int64_t
+roundUp(int64_t x, int64_t n)
 {
-  time::steady_clock::TimePoint now = time::steady_clock::now();
-  if (now > m_scheduledTime)
-    return time::seconds(0); // event should be scheduled ASAP
-  else
-    return m_scheduledTime - now;
+  return (x + n - 1) & ~(n - 1);
 }
 
+} // anonymous namespace
+
+struct EventIdImpl : noncopyable
+{
+  EventIdImpl(const Scheduler::Event& event, int64_t expiry, uint64_t seq, Scheduler* scheduler)
+    : m_event(event)
+    , m_expiry(expiry)
+    , m_seq(seq)
+    , m_context(ns3::Simulator::GetContext())
+    , m_scheduler(scheduler)
+    , m_list(nullptr)
+    , m_prev(nullptr)
+    , m_next(nullptr)
+  {
+  }
+
+  int64_t
+  getSlot() const
+  {
+    return m_expiry >> Scheduler::SLOT_SHIFT;
+  }
+
+  void
+  link(EventIdImpl** list)
+  {
+    m_list = list;
+    m_prev = nullptr;
+    m_next = *list;
+    if (m_next != nullptr) {
+      m_next->m_prev = this;
+    }
+    *list = this;
+  }
+
+  void
+  unlink()
+  {
+    if (m_prev != nullptr) {
+      m_prev->m_next = m_next;
+    }
+    else {
+      *m_list = m_next;
+    }
+    if (m_next != nullptr) {
+      m_next->m_prev = m_prev;
+    }
+    m_list = nullptr;
+  }
+
+  /** \brief marks the event as no longer pending and drops the scheduler's reference
+   *  \return the callback, so that it is destroyed after the scheduler is consistent
+   */
+  Scheduler::Event
+  release()
+  {
+    BOOST_ASSERT(m_list == nullptr);
+    m_scheduler = nullptr;
+    Scheduler::Event event;
+    event.swap(m_event);
+    m_self.reset(); // may delete this
+    return event;
+  }
+
+  Scheduler::Event m_event;
+  int64_t m_expiry; ///< ns-3 time step at which the event fires
+  uint64_t m_seq; ///< orders events with the same expiry
+  uint32_t m_context; ///< ns-3 context in which the event was scheduled
+  Scheduler* m_scheduler; ///< owning scheduler while the event is pending, otherwise nullptr
+  EventIdImpl** m_list; ///< head of the wheel slot or dispatched list holding the event
+  EventIdImpl* m_prev;
+  EventIdImpl* m_next;
+  EventId m_self; ///< keeps the record alive while the event is pending
+};
+
+const int Scheduler::SLOT_SHIFT;
+const int Scheduler::LEVEL_BITS;
+const size_t Scheduler::N_SLOTS;
+const size_t Scheduler::N_LEVELS;
 
 Scheduler::Scheduler(boost::asio::io_service& ioService)
-  : m_scheduledEvent(m_events.end())
+  : m_dispatched(nullptr)
+  , m_nEventsInWheel(0)
+  , m_currentSlot(0)
+  , m_nextTick(0)
+  , m_nextSeq(0)
 {
+  std::fill(&m_wheel[0][0], &m_wheel[0][0] + N_LEVELS * N_SLOTS, nullptr);
+}
+
+Scheduler::~Scheduler()
+{
+  if (m_destroyEvent.PeekEventImpl() == 0) {
+    // no event was scheduled since the simulator was last destroyed, so there is nothing to
+    // cancel, and the simulator must not be touched: it may already be gone at program exit
+    BOOST_ASSERT(m_nEventsInWheel == 0 && m_dispatched == nullptr);
+    return;
+  }
+
+  this->cancelAllEvents();
+  ns3::Simulator::Remove(m_destroyEvent);
 }
 
 EventId
 Scheduler::scheduleEvent(const time::nanoseconds& after,
                          const Event& event)
 {
-  ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
-                                             &std::function<void()>::operator(), event);
-  auto id_ptr = std::make_shared<ns3::EventId>(id);
-  m_events.insert(id_ptr);
-  return id_ptr;
+  int64_t now = ns3::Simulator::Now().GetTimeStep();
+  int64_t expiry = now + std::max<int64_t>(ns3::NanoSeconds(after.count()).GetTimeStep(), 0);
+
+  auto eventId = std::allocate_shared<EventIdImpl>(PoolAllocator<EventIdImpl>(),
+                                                   event, expiry, m_nextSeq++, this);
+  eventId->m_self = eventId;
+
+  if (m_destroyEvent.PeekEventImpl() == 0) {
+    m_destroyEvent = ns3::Simulator::ScheduleDestroy(&Scheduler::onSimulatorDestroy, this);
+  }
+
+  int64_t slot = eventId->getSlot();
+  int64_t nowSlot = now >> SLOT_SHIFT;
+  // At the very start of a slot, onTick may be due but not yet run; an event for that slot
+  // then goes into the wheel, so that it is dispatched after the earlier ones with the same expiry.
+  bool isTickPending = m_nEventsInWheel > 0 && slot == m_nextTick;
+  if (slot <= nowSlot && !isTickPending) {
+    // the slot has started, so the wheel has moved past it
+    this->dispatchEvent(eventId.get());
+    return eventId;
+  }
+
+  if (m_nEventsInWheel == 0) {
+    m_currentSlot = nowSlot + 1;
+  }
+  else {
+    // onTick has nothing to do in the slots it skips, so the wheel can catch up with the time
+    m_currentSlot = std::max(m_currentSlot, std::min(nowSlot + 1, m_nextTick));
+  }
+  int64_t activation = this->insertIntoWheel(eventId.get());
+  ++m_nEventsInWheel;
+
+  if (m_nEventsInWheel == 1 || activation < m_nextTick) {
+    this->scheduleNextTick();
+  }
+  return eventId;
 }
 
 void
 Scheduler::cancelEvent(const EventId& eventId)
 {
-  if (eventId != nullptr) {
-    ns3::Simulator::Remove(*eventId);
-    const_cast<EventId&>(eventId).reset();
-    m_events.erase(eventId);
+  if (eventId == nullptr) {
+    return;
   }
+
+  EventIdImpl* event = eventId.get();
+  Scheduler* owner = event->m_scheduler;
+  if (owner != nullptr) {
+    // a dispatched event stays in the ns-3 event queue and is skipped when it expires
+    if (event->m_list != &owner->m_dispatched && --owner->m_nEventsInWheel == 0) {
+      ns3::Simulator::Cancel(owner->m_tickEvent);
+    }
+    event->unlink();
+    event->release();
+  }
+  const_cast<EventId&>(eventId).reset();
 }
 
 void
 Scheduler::cancelAllEvents()
 {
-  for (auto i = m_events.begin(); i != m_events.end(); i++) {
-    if ((*i) != nullptr) {
-      ns3::Simulator::Remove((**i));
-      const_cast<EventId&>(*i).reset();
+  // Releasing a callback may cancel other events, so list heads are re-read every time.
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    for (EventIdImpl*& head : m_wheel[level]) {
+      while (head != nullptr) {
+        EventIdImpl* event = head;
+        event->unlink();
+        --m_nEventsInWheel;
+        event->release();
+      }
     }
   }
-  m_events.clear();
+  if (m_nEventsInWheel == 0) {
+    ns3::Simulator::Cancel(m_tickEvent);
+  }
+
+  while (m_dispatched != nullptr) {
+    EventIdImpl* event = m_dispatched;
+    event->unlink();
+    event->release();
+  }
+}
+
+int64_t
+Scheduler::insertIntoWheel(EventIdImpl* event)
+{
+  int64_t slot = event->getSlot();
+  BOOST_ASSERT(slot >= m_currentSlot);
+
+  size_t level = 0;
+  while (level + 1 < N_LEVELS && slot - m_currentSlot >= (int64_t(1) << (LEVEL_BITS * (level + 1)))) {
+    ++level;
+  }
+
+  // An event beyond the last level is parked in its farthest slot, and gets re-inserted
+  // when that slot is cascaded.
+  int64_t horizon = m_currentSlot + (int64_t(1) << (LEVEL_BITS * N_LEVELS)) - 1;
+  slot = std::min(slot, horizon);
+
+  int shift = LEVEL_BITS * level;
+  event->link(&m_wheel[level][(slot >> shift) & (N_SLOTS - 1)]);
+  return (slot >> shift) << shift;
+}
+
+void
+Scheduler::dispatchEvent(EventIdImpl* event)
+{
+  // ScheduleWithContext keeps the context of the event, but returns no ns3::EventId;
+  // the simulator event instead holds a reference to the record, and does nothing if
+  // the event has been cancelled in the meantime
+  ns3::Time delay = ns3::TimeStep(event->m_expiry) - ns3::Simulator::Now();
+  ns3::Simulator::ScheduleWithContext(event->m_context, delay,
+                                      &Scheduler::executeEvent, event->m_self);
+  event->link(&m_dispatched);
+}
+
+void
+Scheduler::executeEvent(const EventId& eventId)
+{
+  EventIdImpl* event = eventId.get();
+  if (event->m_scheduler == nullptr) {
+    return; // cancelled
+  }
+
+  event->unlink();
+  Event callback = event->release();
+  callback();
+}
+
+void
+Scheduler::onTick()
+{
+  int64_t slot = m_nextTick;
+  m_currentSlot = slot;
+
+  if ((slot & (N_SLOTS - 1)) == 0) {
+    // level-0 wraps around: move the events of the next slot of each higher level down,
+    // stopping at the first level that doesn't wrap around as well
+    for (size_t level = 1; level < N_LEVELS; ++level) {
+      size_t index = (slot >> (LEVEL_BITS * level)) & (N_SLOTS - 1);
+      EventIdImpl* event = m_wheel[level][index];
+      m_wheel[level][index] = nullptr;
+      while (event != nullptr) {
+        EventIdImpl* next = event->m_next;
+        this->insertIntoWheel(event);
+        event = next;
+      }
+      if (index != 0) {
+        break;
+      }
+    }
+  }
+
+  EventIdImpl*& head = m_wheel[0][slot & (N_SLOTS - 1)];
+  m_dispatchBuffer.clear();
+  for (EventIdImpl* event = head; event != nullptr; event = event->m_next) {
+    m_dispatchBuffer.push_back(event);
+  }
+  head = nullptr;
+  m_nEventsInWheel -= m_dispatchBuffer.size();
+
+  std::sort(m_dispatchBuffer.begin(), m_dispatchBuffer.end(),
+            [] (const EventIdImpl* a, const EventIdImpl* b) {
+              return std::tie(a->m_expiry, a->m_seq) < std::tie(b->m_expiry, b->m_seq);
+            });
+  for (EventIdImpl* event : m_dispatchBuffer) {
+    this->dispatchEvent(event);
+  }
+
+  m_currentSlot = slot + 1;
+  if (m_nEventsInWheel > 0) {
+    this->scheduleNextTick();
+  }
+}
+
+void
+Scheduler::scheduleNextTick()
+{
+  // Find the first slot where onTick has work to do: an occupied level-0 slot, or a wraparound
+  // cascading an occupied slot.  A level that still has events elsewhere cannot be skipped
+  // beyond its own wraparound.
+  int64_t slot = m_currentSlot;
+  for (size_t level = 0; level < N_LEVELS; ++level) {
+    int shift = LEVEL_BITS * level;
+    int64_t wraparound = roundUp(slot, int64_t(N_SLOTS) << shift);
+    while (slot < wraparound && m_wheel[level][(slot >> shift) & (N_SLOTS - 1)] == nullptr) {
+      slot += int64_t(1) << shift;
+    }
+    if (slot < wraparound ||
+        std::any_of(std::begin(m_wheel[level]), std::end(m_wheel[level]),
+                    [] (const EventIdImpl* head) { return head != nullptr; })) {
+      break;
+    }
+  }
+
+  ns3::Simulator::Cancel(m_tickEvent);
+  m_nextTick = slot;
+  ns3::Time delay = ns3::TimeStep(slot << SLOT_SHIFT) - ns3::Simulator::Now();
+  BOOST_ASSERT(!delay.IsNegative());
+  m_tickEvent = ns3::Simulator::Schedule(delay, &Scheduler::onTick, this);
+}
+
+void
+Scheduler::onSimulatorDestroy()
+{
+  m_destroyEvent = ns3::EventId();
+  this->cancelAllEvents();
 }
 
 } // namespace scheduler
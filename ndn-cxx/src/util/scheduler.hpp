@@ -27,7 +27,7 @@
 
 #include "ns3/simulator.h"
 
-#include <set>
+#include <vector>
 
 namespace ndn {
 namespace util {
@@ -38,18 +38,28 @@ struct EventIdImpl; ///< \brief Private storage of information about the event
 /** \class EventId
  *  \brief Opaque type (shared_ptr) representing ID of a scheduled event
  */
-typedef std::shared_ptr<ns3::EventId> EventId;
+typedef std::shared_ptr<EventIdImpl> EventId;
 
 /**
  * \brief Generic scheduler
+ *
+ * Events are kept in a hierarchical timing wheel, so that scheduling and cancelling are O(1).
+ * An event enters the ns-3 event queue only when its level-0 slot (about 1ms) is reached;
+ * events cancelled before that, such as most PIT timers, never touch the simulator.
+ * Events still fire at their exact time, in the order they were scheduled.
+ *
+ * \note Destroying the scheduler cancels all its events.
+ * \note A scheduler must be used on the thread that runs the ns-3 simulator.
  */
-class Scheduler
+class Scheduler : noncopyable
 {
 public:
   typedef function<void()> Event;
 
   Scheduler(boost::asio::io_service& ioService);
 
+  ~Scheduler();
+
   /**
    * \brief Schedule one time event after the specified delay
    * \returns EventId that can be used to cancel the scheduled event
@@ -70,37 +80,54 @@ public:
   cancelAllEvents();
 
 private:
-  struct EventInfo
-  {
-    EventInfo(const time::nanoseconds& after, const Event& event);
+  /** \brief places \p event into the wheel level and slot matching its expiry
+   *  \return the level-0 slot at which onTick next needs to process the event
+   */
+  int64_t
+  insertIntoWheel(EventIdImpl* event);
 
-    EventInfo(const time::steady_clock::TimePoint& when, const EventInfo& previousEvent);
+  /** \brief hands \p event to the ns-3 simulator, to be executed at its exact expiry
+   */
+  void
+  dispatchEvent(EventIdImpl* event);
 
-    bool
-    operator <=(const EventInfo& other) const
-    {
-      return this->m_scheduledTime <= other.m_scheduledTime;
-    }
+  static void
+  executeEvent(const EventId& eventId);
 
-    bool
-    operator <(const EventInfo& other) const
-    {
-      return this->m_scheduledTime < other.m_scheduledTime;
-    }
+  /** \brief cascades higher levels when level-0 wraps around,
+   *         then dispatches the events in level-0 slot m_nextTick
+   */
+  void
+  onTick();
 
-    time::nanoseconds
-    expiresFromNow() const;
+  /** \brief schedules onTick at the next level-0 slot that is occupied or cascades events
+   */
+  void
+  scheduleNextTick();
 
-    time::steady_clock::TimePoint m_scheduledTime;
-    Event m_event;
-    mutable EventId m_eventId;
-  };
+  /** \brief forgets all events when the simulation is destroyed
+   */
+  void
+  onSimulatorDestroy();
 
-  typedef std::multiset<EventId> EventQueue;
-  friend struct EventIdImpl;
+private:
+  static const int SLOT_SHIFT = 20; ///< a level-0 slot spans 2^SLOT_SHIFT ns-3 time steps
+  static const int LEVEL_BITS = 8;
+  static const size_t N_SLOTS = 1 << LEVEL_BITS;
+  static const size_t N_LEVELS = 4;
+
+private:
+  EventIdImpl* m_wheel[N_LEVELS][N_SLOTS];
+  EventIdImpl* m_dispatched; ///< events in the ns-3 event queue
+  size_t m_nEventsInWheel;
+  int64_t m_currentSlot; ///< first level-0 slot not yet processed
+  int64_t m_nextTick; ///< level-0 slot at which onTick is scheduled
+  uint64_t m_nextSeq;
+  ns3::EventId m_tickEvent;
+  ns3::EventId m_destroyEvent;
+  std::vector<EventIdImpl*> m_dispatchBuffer;
 
-  EventQueue m_events;
-  EventQueue::iterator m_scheduledEvent;
+  friend struct EventIdImpl;
 };
 
 } // namespace scheduler
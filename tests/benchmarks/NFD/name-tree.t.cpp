@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/name-tree.hpp"
+
+#include "../benchmark-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+using ns3::ndn::timedRun;
+
+/** \brief generate Interests with long names, similar to video segment naming
+ */
+static std::vector<shared_ptr<Interest>>
+makeInterestWorkload(size_t count)
+{
+  std::vector<shared_ptr<Interest>> workload(count);
+  for (size_t i = 0; i < count; ++i) {
+    Name name("/ndn/edu/site/video/channel/program/quality/1080p");
+    name.appendVersion(i % 16);
+    name.appendNumber(i % 64);
+    name.appendSegment(i);
+    workload[i] = make_shared<Interest>(name);
+    workload[i]->getName().wireEncode();
+  }
+  return workload;
+}
+
+BOOST_AUTO_TEST_SUITE(NfdNameTree)
+
+// cost of hashing every prefix of a packet's Name
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  const size_t N_WORKLOAD = 100000;
+  std::vector<shared_ptr<Interest>> workload = makeInterestWorkload(N_WORKLOAD);
+
+  // hashing each prefix separately, as NameTree::lookup used to do
+  size_t sum = 0;
+  double prefixTime = timedRun([&] {
+      for (const shared_ptr<Interest>& interest : workload) {
+        const Name& name = interest->getName();
+        for (size_t i = 0; i <= name.size(); ++i) {
+          sum += name_tree::computeHash(name.getPrefix(i));
+        }
+      }
+    });
+  BOOST_TEST_MESSAGE("computeHash per prefix: " << N_WORKLOAD / prefixTime << " Names/s");
+
+  // hashing each component once
+  double hashSetTime = timedRun([&] {
+      for (const shared_ptr<Interest>& interest : workload) {
+        sum += name_tree::computeHashSet(interest->getName()).back();
+      }
+    });
+  BOOST_TEST_MESSAGE("computeHashSet: " << N_WORKLOAD / hashSetTime << " Names/s");
+
+  // reusing the hash values cached on the packet
+  for (const shared_ptr<Interest>& interest : workload) {
+    name_tree::getHashSetTag(*interest);
+  }
+  double tagTime = timedRun([&] {
+      for (const shared_ptr<Interest>& interest : workload) {
+        sum += name_tree::getHashSetTag(*interest)->getHashSet().back();
+      }
+    });
+  BOOST_TEST_MESSAGE("getHashSetTag (cached): " << N_WORKLOAD / tagTime << " Names/s");
+
+  BOOST_CHECK_NE(sum, 0);
+}
+
+// lookup, findExactMatch and findLongestPrefixMatch on the same Name, as the forwarding
+// pipelines do for every Interest
+BOOST_AUTO_TEST_CASE(LookupFind)
+{
+  const size_t N_WORKLOAD = 100000;
+  std::vector<shared_ptr<Interest>> workload = makeInterestWorkload(N_WORKLOAD);
+
+  NameTree nt1;
+  double nameTime = timedRun([&] {
+      for (const shared_ptr<Interest>& interest : workload) {
+        const Name& name = interest->getName();
+        nt1.lookup(name);
+        nt1.findExactMatch(name);
+        nt1.findLongestPrefixMatch(name);
+      }
+    });
+  BOOST_TEST_MESSAGE("lookup-find: " << N_WORKLOAD / nameTime << " Interests/s");
+
+  NameTree nt2;
+  double tagTime = timedRun([&] {
+      for (const shared_ptr<Interest>& interest : workload) {
+        const Name& name = interest->getName();
+        const std::vector<size_t>& hashSet = name_tree::getHashSetTag(*interest)->getHashSet();
+        nt2.lookup(name, hashSet);
+        nt2.findExactMatch(name, hashSet.back());
+        nt2.findLongestPrefixMatch(name, hashSet);
+      }
+    });
+  BOOST_TEST_MESSAGE("lookup-find (HashSetTag): " << N_WORKLOAD / tagTime << " Interests/s");
+
+  BOOST_CHECK_EQUAL(nt1.size(), nt2.size());
+}
+
+// lookup, then find every entry again, with each hash table layout
+BOOST_AUTO_TEST_CASE(Layout)
+{
+  const size_t N_WORKLOAD = 1000000;
+  std::vector<shared_ptr<Interest>> workload = makeInterestWorkload(N_WORKLOAD);
+  std::vector<std::vector<size_t>> hashSets;
+  for (const shared_ptr<Interest>& interest : workload) {
+    hashSets.push_back(name_tree::computeHashSet(interest->getName()));
+  }
+
+  std::set<size_t> sizes;
+  for (name_tree::HashtableLayout layout : {name_tree::HASHTABLE_CHAINED,
+                                            name_tree::HASHTABLE_OPEN_ADDRESSING}) {
+    NameTree nt(1024, layout);
+    double lookupTime = timedRun([&] {
+        for (size_t i = 0; i < N_WORKLOAD; ++i) {
+          nt.lookup(workload[i]->getName(), hashSets[i]);
+        }
+      });
+    double lpmTime = timedRun([&] {
+        for (size_t i = 0; i < N_WORKLOAD; ++i) {
+          nt.findLongestPrefixMatch(workload[i]->getName(), hashSets[i]);
+        }
+      });
+    BOOST_TEST_MESSAGE("layout " << static_cast<int>(layout) << ", " << nt.size() << " entries: " <<
+                       "lookup " << N_WORKLOAD / lookupTime << " Names/s, " <<
+                       "findLongestPrefixMatch " << N_WORKLOAD / lpmTime << " Names/s");
+    sizes.insert(nt.size());
+  }
+  BOOST_CHECK_EQUAL(sizes.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "face/ndnlp-slicer.hpp"
+
+#include "../benchmark-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+using ns3::ndn::timedRun;
+using ns3::ndn::makeData;
+
+BOOST_AUTO_TEST_SUITE(NfdNdnlpSlicer)
+
+BOOST_AUTO_TEST_CASE(Data8k)
+{
+  const size_t N_PACKETS = 200000;
+  const size_t MTU = 1500;
+
+  Data data = makeData("/ndnlp-slicer/benchmark");
+  std::vector<uint8_t> payload(8192);
+  data.setContent(payload.data(), payload.size());
+  const Block& wire = data.wireEncode();
+
+  // a face would write every NDNLP packet into a frame
+  std::vector<uint8_t> frame(MTU);
+  size_t nFragments = 0;
+
+  ndnlp::Slicer slicer(MTU);
+  double sliceTime = timedRun([&] {
+      for (size_t i = 0; i < N_PACKETS; ++i) {
+        ndnlp::PacketArray pa = slicer.slice(wire);
+        for (const Block& packet : *pa) {
+          std::copy(packet.begin(), packet.end(), frame.begin());
+          ++nFragments;
+        }
+      }
+    });
+
+  ndnlp::FragmentArray fragments;
+  double inPlaceTime = timedRun([&] {
+      for (size_t i = 0; i < N_PACKETS; ++i) {
+        slicer.sliceInPlace(wire, fragments);
+        for (const ndnlp::Fragment& fragment : fragments) {
+          auto end = std::copy_n(fragment.header, fragment.headerSize, frame.begin());
+          std::copy_n(fragment.payload, fragment.payloadSize, end);
+          ++nFragments;
+        }
+      }
+    });
+
+  BOOST_TEST_MESSAGE("packets of " << wire.size() << " bytes, " <<
+                     nFragments / 2 / N_PACKETS << " fragments each");
+  BOOST_TEST_MESSAGE("slice: " << N_PACKETS / sliceTime << " packets/s");
+  BOOST_TEST_MESSAGE("sliceInPlace: " << N_PACKETS / inPlaceTime << " packets/s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/pit.hpp"
+
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include "../benchmark-common.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// heap usage of the benchmarks program, to measure memory per PIT entry
+static size_t g_nAllocs = 0;
+static size_t g_nLiveBytes = 0;
+
+// each block is prefixed with its size, so that freed bytes are known
+static const size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void*
+operator new(size_t size)
+{
+  void* p = std::malloc(HEADER_SIZE + size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  ++g_nAllocs;
+  g_nLiveBytes += size;
+  *static_cast<size_t*>(p) = size;
+  return static_cast<char*>(p) + HEADER_SIZE;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  if (p == nullptr) {
+    return;
+  }
+  p = static_cast<char*>(p) - HEADER_SIZE;
+  g_nLiveBytes -= *static_cast<size_t*>(p);
+  std::free(p);
+}
+
+namespace nfd {
+namespace tests {
+
+using ns3::ndn::timedRun;
+
+class PitBenchmarkFixture
+{
+protected:
+  PitBenchmarkFixture()
+    : interest(make_shared<Interest>("/pit/benchmark"))
+  {
+    for (size_t i = 0; i < N_FACES; ++i) {
+      faces.push_back(make_shared<DummyFace>());
+    }
+  }
+
+protected:
+  static const size_t N_FACES = 4;
+  std::vector<shared_ptr<Face>> faces;
+  shared_ptr<Interest> interest;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdPit, PitBenchmarkFixture)
+
+// heap allocations and live heap bytes per entry with 1 to N_FACES InRecords and OutRecords
+BOOST_AUTO_TEST_CASE(MemoryPerEntry)
+{
+  const size_t N_ENTRIES = 10000;
+
+  BOOST_TEST_MESSAGE("sizeof(pit::Entry) " << sizeof(pit::Entry) <<
+                     ", sizeof(pit::InRecord) " << sizeof(pit::InRecord) <<
+                     ", sizeof(pit::OutRecord) " << sizeof(pit::OutRecord));
+
+  for (size_t nRecords = 1; nRecords <= N_FACES; ++nRecords) {
+    std::vector<shared_ptr<pit::Entry>> entries;
+    entries.reserve(N_ENTRIES);
+
+    size_t nAllocs = g_nAllocs;
+    size_t nLiveBytes = g_nLiveBytes;
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      auto entry = make_shared<pit::Entry>(*interest);
+      for (size_t j = 0; j < nRecords; ++j) {
+        entry->insertOrUpdateInRecord(faces[j], *interest);
+        entry->insertOrUpdateOutRecord(faces[j], *interest);
+      }
+      entries.push_back(entry);
+    }
+    BOOST_TEST_MESSAGE(nRecords << " in+out records: " <<
+                       (g_nAllocs - nAllocs) / N_ENTRIES << " allocations, " <<
+                       (g_nLiveBytes - nLiveBytes) / N_ENTRIES << " bytes per entry");
+  }
+}
+
+// update and look up face records, as the forwarding pipelines do for every packet
+BOOST_AUTO_TEST_CASE(FaceRecords)
+{
+  const size_t N_ITERATIONS = 1000000;
+
+  for (size_t nRecords = 1; nRecords <= N_FACES; ++nRecords) {
+    pit::Entry entry(*interest);
+    size_t nFound = 0;
+    double d = timedRun([&] {
+        for (size_t i = 0; i < N_ITERATIONS; ++i) {
+          const shared_ptr<Face>& face = faces[i % nRecords];
+          entry.insertOrUpdateInRecord(face, *interest);
+          entry.insertOrUpdateOutRecord(face, *interest);
+          nFound += entry.getOutRecord(*face) != entry.getOutRecords().end();
+        }
+      });
+    BOOST_TEST_MESSAGE(nRecords << " in+out records: insert-update-get " <<
+                       N_ITERATIONS / d << " iterations/s");
+    BOOST_CHECK_EQUAL(nFound, N_ITERATIONS);
+  }
+}
+
+// create and erase PIT entries, as Interests come and get satisfied
+BOOST_AUTO_TEST_CASE(InsertErase)
+{
+  const size_t N_ITERATIONS = 1000000;
+  const size_t N_OUTSTANDING = 1000;
+
+  NameTree nameTree;
+  Pit pit(nameTree);
+  std::vector<shared_ptr<Interest>> interests;
+  for (size_t i = 0; i < N_OUTSTANDING; ++i) {
+    interests.push_back(make_shared<Interest>(Name("/pit/benchmark").appendNumber(i)));
+    name_tree::getHashSetTag(*interests.back());
+  }
+  std::vector<shared_ptr<pit::Entry>> entries(N_OUTSTANDING);
+
+  size_t nAllocs = g_nAllocs;
+  double d = timedRun([&] {
+      for (size_t i = 0; i < N_ITERATIONS; ++i) {
+        shared_ptr<pit::Entry>& entry = entries[i % N_OUTSTANDING];
+        if (entry != nullptr) {
+          pit.erase(entry);
+        }
+        entry = pit.insert(*interests[i % N_OUTSTANDING]).first;
+      }
+    });
+  BOOST_TEST_MESSAGE("insert-erase: " << N_ITERATIONS / d << " iterations/s, " <<
+                     static_cast<double>(g_nAllocs - nAllocs) / N_ITERATIONS <<
+                     " allocations per iteration");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/strategy-choice.hpp"
+#include "fw/forwarder.hpp"
+
+#include "tests/daemon/fw/dummy-strategy.hpp"
+
+#include "../benchmark-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+using ns3::ndn::timedRun;
+
+class StrategyChoiceBenchmarkFixture : public ns3::ndn::CleanupFixture
+{
+protected:
+  StrategyChoiceBenchmarkFixture()
+    : nameTree(forwarder.getNameTree())
+    , table(forwarder.getStrategyChoice())
+  {
+    // FIB prefixes /fib/<i % 100>/<i>, with strategy choices on a few /fib/<k> subtrees
+    for (size_t i = 0; i < N_FIB_PREFIXES; ++i) {
+      forwarder.getFib().insert(Name("/fib").appendNumber(i % 100).appendNumber(i));
+    }
+    for (size_t k = 0; k < N_STRATEGY_CHOICES; ++k) {
+      Name strategyName = Name("/strategy").appendNumber(k);
+      table.install(make_shared<DummyStrategy>(ref(forwarder), strategyName));
+      table.insert(Name("/fib").appendNumber(k * 10), strategyName);
+    }
+
+    // outstanding Interests under randomly chosen FIB prefixes
+    for (size_t j = 0; j < N_PIT_ENTRIES; ++j) {
+      size_t i = (j * 7919) % N_FIB_PREFIXES;
+      Interest interest(Name("/fib").appendNumber(i % 100).appendNumber(i).append("data"));
+      pitEntries.push_back(forwarder.getPit().insert(interest).first);
+    }
+  }
+
+protected:
+  static const size_t N_FIB_PREFIXES = 100000;
+  static const size_t N_STRATEGY_CHOICES = 10;
+  static const size_t N_PIT_ENTRIES = 10000;
+
+  Forwarder forwarder;
+  NameTree& nameTree;
+  StrategyChoice& table;
+  std::vector<shared_ptr<pit::Entry>> pitEntries;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdStrategyChoice, StrategyChoiceBenchmarkFixture)
+
+// effective strategy lookup for a PIT entry, as the forwarding pipelines do for every packet
+BOOST_AUTO_TEST_CASE(FindEffectiveStrategy)
+{
+  const size_t N_ITERATIONS = 1000000;
+  const size_t nPitEntries = pitEntries.size();
+
+  auto hasStrategyChoice = [] (const name_tree::Entry& entry) {
+    return static_cast<bool>(entry.getStrategyChoiceEntry());
+  };
+
+  // baseline: longest prefix match with an entry selector, without memoization
+  double lpmTime = timedRun([&] {
+      for (size_t i = 0; i < N_ITERATIONS; ++i) {
+        nameTree.findLongestPrefixMatch(nameTree.get(*pitEntries[i % nPitEntries]),
+                                        hasStrategyChoice);
+      }
+    });
+
+  size_t nMismatches = 0;
+  for (const shared_ptr<pit::Entry>& pitEntry : pitEntries) {
+    shared_ptr<name_tree::Entry> nte =
+      nameTree.findLongestPrefixMatch(nameTree.get(*pitEntry), hasStrategyChoice);
+    nMismatches += &nte->getStrategyChoiceEntry()->getStrategy() !=
+                   &table.findEffectiveStrategy(*pitEntry);
+  }
+  BOOST_CHECK_EQUAL(nMismatches, 0);
+
+  double coldTime = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+    // the first pass after a change recomputes and memoizes, the second one hits
+    table.insert(Name("/fib").appendNumber(5), Name("/strategy").appendNumber(pass));
+    coldTime = timedRun([&] {
+        for (size_t i = 0; i < nPitEntries; ++i) {
+          table.findEffectiveStrategy(*pitEntries[i]);
+        }
+      });
+  }
+
+  double memoizedTime = timedRun([&] {
+      for (size_t i = 0; i < N_ITERATIONS; ++i) {
+        table.findEffectiveStrategy(*pitEntries[i % nPitEntries]);
+      }
+    });
+
+  BOOST_TEST_MESSAGE("findEffectiveStrategy: " << N_ITERATIONS / memoizedTime << " lookups/s, " <<
+                     "longest prefix match: " << N_ITERATIONS / lpmTime << " lookups/s, " <<
+                     "first " << nPitEntries << " after a change: " << nPitEntries / coldTime <<
+                     " lookups/s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "face/unix-stream-face.hpp"
+
+#include "core/global-io.hpp"
+
+#include "../benchmark-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+using ns3::ndn::timedRun;
+using ns3::ndn::makeData;
+
+class StreamFaceBenchmarkFixture
+{
+protected:
+  StreamFaceBenchmarkFixture()
+    : nReceived(0)
+  {
+    // the previous test case has run the io_service out of work
+    getGlobalIoService().reset();
+
+    UnixStreamFace::protocol::socket socket1(getGlobalIoService());
+    UnixStreamFace::protocol::socket socket2(getGlobalIoService());
+    boost::asio::local::connect_pair(socket1, socket2);
+
+    FaceUri remoteUri1 = FaceUri::fromFd(socket1.native_handle());
+    FaceUri remoteUri2 = FaceUri::fromFd(socket2.native_handle());
+    sender = make_shared<UnixStreamFace>(remoteUri1, FaceUri("unix:///benchmark"),
+                                         std::move(socket1));
+    receiver = make_shared<UnixStreamFace>(remoteUri2, FaceUri("unix:///benchmark"),
+                                           std::move(socket2));
+    receiver->onReceiveData.connect([this] (const Data&) { ++nReceived; });
+  }
+
+  ~StreamFaceBenchmarkFixture()
+  {
+    sender->close();
+    receiver->close();
+    getGlobalIoService().poll();
+  }
+
+  /** \brief send \p nPackets Data in bursts of \p burstSize, waiting for each burst to arrive
+   */
+  double
+  timedTransfer(size_t nPackets, size_t burstSize, const Data& data)
+  {
+    nReceived = 0;
+    return timedRun([&] {
+        for (size_t nSent = 0; nSent < nPackets; ) {
+          for (size_t i = 0; i < burstSize && nSent < nPackets; ++i, ++nSent) {
+            sender->sendData(data);
+          }
+          while (nReceived < nSent) {
+            getGlobalIoService().run_one();
+          }
+        }
+      });
+  }
+
+  void
+  run(const std::string& label, size_t payloadSize)
+  {
+    const size_t N_PACKETS = 200000;
+    const size_t BURST_SIZE = 32;
+
+    Data data = makeData("/stream-face/benchmark");
+    std::vector<uint8_t> payload(payloadSize);
+    data.setContent(payload.data(), payload.size());
+
+    sender->setSendBatchLimits(UnixStreamFace::DEFAULT_SEND_BATCH_BYTES, 1);
+    double d1 = timedTransfer(N_PACKETS, BURST_SIZE, data);
+    size_t nBatches1 = sender->getSendBatchCounters().getNBatches();
+
+    sender->setSendBatchLimits(UnixStreamFace::DEFAULT_SEND_BATCH_BYTES,
+                               UnixStreamFace::DEFAULT_SEND_BATCH_PACKETS);
+    double d2 = timedTransfer(N_PACKETS, BURST_SIZE, data);
+    size_t nBatches2 = sender->getSendBatchCounters().getNBatches() - nBatches1;
+
+    BOOST_TEST_MESSAGE(label << ", one write per packet: " << N_PACKETS / d1 << " packets/s ("
+                       << nBatches1 << " writes)");
+    BOOST_TEST_MESSAGE(label << ", batched writes: " << N_PACKETS / d2 << " packets/s ("
+                       << nBatches2 << " writes)");
+  }
+
+protected:
+  shared_ptr<UnixStreamFace> sender;
+  shared_ptr<UnixStreamFace> receiver;
+  size_t nReceived;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdStreamFace, StreamFaceBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(SmallData)
+{
+  run("SmallData", 100);
+}
+
+BOOST_AUTO_TEST_CASE(LargeData)
+{
+  run("LargeData", 4000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
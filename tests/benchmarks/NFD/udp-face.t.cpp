@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "face/udp-face.hpp"
+
+#include "core/global-io.hpp"
+
+#include "../benchmark-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+using ns3::ndn::timedRun;
+using ns3::ndn::makeData;
+
+class UdpFaceBenchmarkFixture
+{
+protected:
+  UdpFaceBenchmarkFixture()
+    : nReceived(0)
+  {
+    // the previous test case has run the io_service out of work
+    getGlobalIoService().reset();
+
+    using boost::asio::ip::udp;
+    udp::endpoint loopback(boost::asio::ip::address_v4::loopback(), 0);
+    udp::socket socket1(getGlobalIoService(), loopback);
+    udp::socket socket2(getGlobalIoService(), loopback);
+    socket1.connect(socket2.local_endpoint());
+    socket2.connect(socket1.local_endpoint());
+
+    FaceUri uri1(socket1.local_endpoint());
+    FaceUri uri2(socket2.local_endpoint());
+    sender = make_shared<UdpFace>(uri2, uri1, std::move(socket1),
+                                  ndn::nfd::FACE_PERSISTENCY_PERSISTENT, time::seconds(600));
+    receiver = make_shared<UdpFace>(uri1, uri2, std::move(socket2),
+                                    ndn::nfd::FACE_PERSISTENCY_PERSISTENT, time::seconds(600));
+    receiver->onReceiveData.connect([this] (const Data&) { ++nReceived; });
+  }
+
+  ~UdpFaceBenchmarkFixture()
+  {
+    sender->close();
+    receiver->close();
+    getGlobalIoService().poll();
+  }
+
+  /** \brief send \p nPackets Data in bursts of \p burstSize, waiting for each burst to arrive
+   *  \param[out] nLost number of Data that did not arrive
+   */
+  double
+  timedTransfer(size_t nPackets, size_t burstSize, const Data& data, size_t& nLost)
+  {
+    nReceived = 0;
+    nLost = 0;
+    return timedRun([&] {
+        for (size_t nSent = 0; nSent < nPackets; ) {
+          for (size_t i = 0; i < burstSize && nSent < nPackets; ++i, ++nSent) {
+            sender->sendData(data);
+          }
+          // datagrams are dropped when the receive buffer overflows
+          time::steady_clock::TimePoint deadline = time::steady_clock::now() +
+                                                   time::milliseconds(100);
+          while (nReceived + nLost < nSent && time::steady_clock::now() < deadline) {
+            getGlobalIoService().poll();
+          }
+          nLost = nSent - nReceived;
+        }
+      });
+  }
+
+  /** \brief compare one datagram per system call with batches of \p burstSize datagrams
+   *  \note \p burstSize Data should fit in the default receive buffer of a loopback socket
+   */
+  void
+  run(const std::string& label, size_t payloadSize, size_t burstSize)
+  {
+    const size_t N_PACKETS = 200000;
+
+    Data data = makeData("/udp-face/benchmark");
+    std::vector<uint8_t> payload(payloadSize);
+    data.setContent(payload.data(), payload.size());
+
+    size_t nLost1 = 0;
+    double d1 = timedTransfer(N_PACKETS, burstSize, data, nLost1);
+
+    sender->setBatchSize(burstSize);
+    receiver->setBatchSize(burstSize);
+    size_t nLost2 = 0;
+    double d2 = timedTransfer(N_PACKETS, burstSize, data, nLost2);
+
+    BOOST_TEST_MESSAGE(label << ", one datagram per system call: " << N_PACKETS / d1
+                       << " packets/s (" << nLost1 << " lost)");
+    BOOST_TEST_MESSAGE(label << ", batch size " << burstSize << ": " << N_PACKETS / d2
+                       << " packets/s (" << nLost2 << " lost, "
+                       << sender->getSendBatchCounters().getNBatches() << " sendmmsg, "
+                       << receiver->getReceiveBatchCounters().getNBatches() << " recvmmsg)");
+  }
+
+protected:
+  shared_ptr<UdpFace> sender;
+  shared_ptr<UdpFace> receiver;
+  size_t nReceived;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NfdUdpFace, UdpFaceBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(SmallData)
+{
+  run("SmallData", 100, 32);
+}
+
+BOOST_AUTO_TEST_CASE(LargeData)
+{
+  run("LargeData", 4000, 16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_TESTS_BENCHMARKS_BENCHMARK_COMMON_HPP
+#define NDNSIM_TESTS_BENCHMARKS_BENCHMARK_COMMON_HPP
+
+#include "unit-tests/tests-common.hpp"
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <chrono>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Run @p f once and return the wall clock time it took, in seconds
+ *
+ * ndn::time clocks follow simulation time, so wall time is measured with std::chrono.
+ */
+inline double
+timedRun(const std::function<void()>& f)
+{
+  auto t1 = std::chrono::steady_clock::now();
+  f();
+  auto t2 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(t2 - t1).count();
+}
+
+/**
+ * @brief Make an Interest with a Nonce, an InterestLifetime and MustBeFresh
+ */
+inline Interest
+makeInterest(const Name& name)
+{
+  Interest interest(name);
+  interest.setNonce(0x12345678);
+  interest.setInterestLifetime(time::seconds(2));
+  interest.setMustBeFresh(true);
+  return interest;
+}
+
+/**
+ * @brief Make a Data with a FreshnessPeriod, 1024 octets of Content and a fake signature
+ */
+inline Data
+makeData(const Name& name)
+{
+  Data data(name);
+  data.setFreshnessPeriod(time::seconds(10));
+  data.setContent(make_shared< ::ndn::Buffer>(1024));
+
+  Signature signature;
+  signature.setInfo(SignatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255)));
+  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+  data.setSignature(signature);
+  return data;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_TESTS_BENCHMARKS_BENCHMARK_COMMON_HPP
@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-ns3.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/data.hpp>
+
+#include "../benchmark-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnNs3, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(ToPacketFromPacket)
+{
+  const size_t N_PACKETS = 100000;
+
+  auto interest = make_shared<ndn::Interest>("/benchmark/interest");
+  interest->setNonce(1);
+
+  auto data = make_shared<ndn::Data>("/benchmark/data");
+  data->setContent(make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(*data);
+
+  double interestTime = timedRun([&] {
+      for (size_t i = 0; i < N_PACKETS; ++i) {
+        Convert::FromPacket<ndn::Interest>(Convert::ToPacket(*interest));
+      }
+    });
+  BOOST_TEST_MESSAGE("Interest ToPacket/FromPacket: " << N_PACKETS / interestTime << " packets/s");
+
+  double dataTime = timedRun([&] {
+      for (size_t i = 0; i < N_PACKETS; ++i) {
+        Convert::FromPacket<ndn::Data>(Convert::ToPacket(*data));
+      }
+    });
+  BOOST_TEST_MESSAGE("Data ToPacket/FromPacket: " << N_PACKETS / dataTime << " packets/s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/detail/name-indexed-table.hpp>
+
+#include <list>
+
+#include "../benchmark-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::NameIndexedTable;
+
+class RecordId;
+
+struct Record
+{
+  explicit
+  Record(const Name& name)
+    : name(name)
+  {
+  }
+
+  const RecordId*
+  getId() const
+  {
+    return reinterpret_cast<const RecordId*>(this);
+  }
+
+  Name name;
+};
+
+typedef NameIndexedTable<Record, RecordId> Table;
+
+class NameIndexedTableFixture
+{
+protected:
+  Table table;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxNameIndexedTable, NameIndexedTableFixture)
+
+BOOST_AUTO_TEST_CASE(InsertMatchErase)
+{
+  // a consumer with a window of outstanding Interests, each satisfied by a Data
+  const size_t N_OUTSTANDING = 10000;
+  const size_t N_ROUNDS = 10;
+
+  std::vector<shared_ptr<Record>> records;
+  for (size_t i = 0; i < N_OUTSTANDING; ++i) {
+    records.push_back(make_shared<Record>(Name("/example/testApp/randomData").appendSegment(i)));
+  }
+
+  size_t nMatches = 0;
+  double tableTime = timedRun([&] {
+      for (size_t round = 0; round < N_ROUNDS; ++round) {
+        for (const auto& record : records) {
+          table.insert(record->name, record->getId(), record);
+        }
+        for (const auto& record : records) {
+          std::vector<shared_ptr<Record>> matches;
+          table.forEachPrefixOf(record->name, [&] (const shared_ptr<Record>& candidate) {
+              if (candidate->name.isPrefixOf(record->name)) {
+                matches.push_back(candidate);
+              }
+            });
+          for (const auto& match : matches) {
+            table.erase(match->getId());
+          }
+          nMatches += matches.size();
+        }
+      }
+    });
+  BOOST_TEST_MESSAGE("NameIndexedTable: " << N_ROUNDS * N_OUTSTANDING / tableTime << " Data/s");
+
+  // baseline: the list that was scanned for every Data
+  std::list<shared_ptr<Record>> list;
+  double listTime = timedRun([&] {
+      for (size_t round = 0; round < N_ROUNDS; ++round) {
+        for (const auto& record : records) {
+          list.push_back(record);
+        }
+        for (const auto& record : records) {
+          for (auto entry = list.begin(); entry != list.end(); ) {
+            if ((*entry)->name.isPrefixOf(record->name)) {
+              entry = list.erase(entry);
+              --nMatches;
+            }
+            else {
+              ++entry;
+            }
+          }
+        }
+      }
+    });
+  BOOST_TEST_MESSAGE("std::list scan: " << N_ROUNDS * N_OUTSTANDING / listTime << " Data/s");
+  BOOST_CHECK_EQUAL(nMatches, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/encoding/block-view.hpp>
+
+#include "../benchmark-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Block;
+using ::ndn::BlockView;
+namespace tlv = ::ndn::tlv;
+
+BOOST_AUTO_TEST_SUITE(NdnCxxPacketDecode)
+
+BOOST_AUTO_TEST_CASE(Decode)
+{
+  const size_t N_ITERATIONS = 1000000;
+
+  // every packet is decoded from a Block of its own, as when received from a face
+  Block interestWire = makeInterest(Name("/example/testApp/randomData/%FE%01")).wireEncode();
+  double interestTime = timedRun([&] {
+      for (size_t i = 0; i < N_ITERATIONS; ++i) {
+        Block wire(interestWire.getBuffer());
+        Interest interest(wire);
+      }
+    });
+  BOOST_TEST_MESSAGE("Interest::wireDecode: " << N_ITERATIONS / interestTime << " packets/s");
+
+  Block dataWire = makeData(Name("/example/testApp/randomData/%FE%01")).wireEncode();
+  double dataTime = timedRun([&] {
+      for (size_t i = 0; i < N_ITERATIONS; ++i) {
+        Block wire(dataWire.getBuffer());
+        Data data(wire);
+      }
+    });
+  BOOST_TEST_MESSAGE("Data::wireDecode: " << N_ITERATIONS / dataTime << " packets/s");
+
+  size_t nComponents = 0;
+  double viewTime = timedRun([&] {
+      for (size_t i = 0; i < N_ITERATIONS; ++i) {
+        BlockView view(interestWire);
+        nComponents += view.get(tlv::Name).elements_size();
+      }
+    });
+  BOOST_TEST_MESSAGE("BlockView Name lookup: " << N_ITERATIONS / viewTime << " packets/s");
+  BOOST_CHECK_EQUAL(nComponents, N_ITERATIONS * 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
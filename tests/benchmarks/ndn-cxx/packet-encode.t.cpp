@@ -0,0 +1,61 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/data.hpp>
+
+#include "../benchmark-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(NdnCxxPacketEncode)
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  const size_t N_ITERATIONS = 1000000;
+
+  Name name("/example/testApp/randomData/%FE%01");
+  name.wireEncode();
+
+  size_t nBytes = 0;
+  double scratchTime = timedRun([&] {
+      for (size_t i = 0; i < N_ITERATIONS; ++i) {
+        nBytes += makeData(name).wireEncode().size();
+      }
+    });
+  BOOST_TEST_MESSAGE("Data::wireEncode from scratch: " << N_ITERATIONS / scratchTime << " packets/s");
+
+  Data dataTemplate = makeData(Name());
+  dataTemplate.getMetaInfo().wireEncode();
+  dataTemplate.getContent();
+  double templateTime = timedRun([&] {
+      for (size_t i = 0; i < N_ITERATIONS; ++i) {
+        Data data(dataTemplate);
+        data.setName(name);
+        nBytes -= data.wireEncode().size();
+      }
+    });
+  BOOST_TEST_MESSAGE("Data::wireEncode from template: " << N_ITERATIONS / templateTime << " packets/s");
+  BOOST_CHECK_EQUAL(nBytes, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
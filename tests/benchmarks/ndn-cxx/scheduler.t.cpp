@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <random>
+
+#include "../benchmark-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::util::scheduler::Scheduler;
+using ::ndn::util::scheduler::EventId;
+
+static void
+noop()
+{
+}
+
+class SchedulerBenchmarkFixture : public CleanupFixture
+{
+public:
+  SchedulerBenchmarkFixture()
+    : scheduler(io)
+  {
+  }
+
+protected:
+  boost::asio::io_service io;
+  Scheduler scheduler;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxScheduler, SchedulerBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(ScheduleCancel)
+{
+  // PIT timers: 1M outstanding events, each cancelled and replaced by a new one
+  const size_t N_EVENTS = 1000000;
+
+  std::mt19937 rng(1);
+  auto randomDelay = [&rng] { return time::milliseconds(1000 + rng() % 4000); };
+
+  std::vector<EventId> eventIds(N_EVENTS);
+  for (EventId& eventId : eventIds) {
+    eventId = scheduler.scheduleEvent(randomDelay(), &noop);
+  }
+  double wheelTime = timedRun([&] {
+      for (EventId& eventId : eventIds) {
+        scheduler.cancelEvent(eventId);
+        eventId = scheduler.scheduleEvent(randomDelay(), &noop);
+      }
+    });
+  BOOST_TEST_MESSAGE("Scheduler schedule+cancel: " << N_EVENTS / wheelTime << " ops/s");
+  scheduler.cancelAllEvents();
+  eventIds.clear();
+
+  // baseline: the simulator event queue, which previously held every event directly
+  std::vector<ns3::EventId> ns3EventIds(N_EVENTS);
+  for (ns3::EventId& eventId : ns3EventIds) {
+    eventId = Simulator::Schedule(NanoSeconds(randomDelay().count()), &noop);
+  }
+  double simulatorTime = timedRun([&] {
+      for (ns3::EventId& eventId : ns3EventIds) {
+        Simulator::Remove(eventId);
+        eventId = Simulator::Schedule(NanoSeconds(randomDelay().count()), &noop);
+      }
+    });
+  BOOST_TEST_MESSAGE("Simulator schedule+remove: " << N_EVENTS / simulatorTime << " ops/s");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
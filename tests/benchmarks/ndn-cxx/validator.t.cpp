@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/security/validator.hpp>
+#include <ndn-cxx/security/verification-key.hpp>
+
+#include <algorithm>
+
+#include "unit-tests/ndn-cxx/key-chain-fixture.hpp"
+#include "../benchmark-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::PublicKey;
+using ::ndn::Validator;
+using ::ndn::VerificationKey;
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxValidator, KeyChainFixture)
+
+BOOST_AUTO_TEST_CASE(VerifySignatures)
+{
+  const size_t N_PACKETS = 2000;
+  const size_t N_THREADS = 4;
+
+  for (bool isRsa : {true, false}) {
+    Name identity(isRsa ? "/TestValidator/Benchmark/rsa" : "/TestValidator/Benchmark/ecdsa");
+    shared_ptr<PublicKey> publicKey;
+    if (isRsa)
+      publicKey = addIdentity(identity, ::ndn::RsaKeyParams());
+    else
+      publicKey = addIdentity(identity, ::ndn::EcdsaKeyParams());
+
+    std::vector<shared_ptr<const Data>> packets;
+    for (size_t i = 0; i < N_PACKETS; ++i) {
+      shared_ptr<Data> data = makeSignedData(Name("/TestData").appendNumber(i), identity);
+      data->wireEncode();
+      packets.push_back(data);
+    }
+
+    size_t nValid = 0;
+    double publicKeyTime = timedRun([&] {
+        for (const auto& data : packets) {
+          nValid += Validator::verifySignature(*data, *publicKey);
+        }
+      });
+
+    VerificationKey key(*publicKey);
+    double decodedKeyTime = timedRun([&] {
+        for (const auto& data : packets) {
+          nValid += Validator::verifySignature(*data, key);
+        }
+      });
+
+    std::vector<bool> isValid;
+    double batchTime = timedRun([&] {
+        isValid = Validator::verifySignatures(packets, *publicKey, N_THREADS);
+      });
+    nValid += std::count(isValid.begin(), isValid.end(), true);
+    BOOST_CHECK_EQUAL(nValid, 3 * N_PACKETS);
+
+    std::string type = isRsa ? "RSA" : "ECDSA";
+    BOOST_TEST_MESSAGE(type << " with PublicKey: " << N_PACKETS / publicKeyTime << " verifications/s");
+    BOOST_TEST_MESSAGE(type << " with VerificationKey: " << N_PACKETS / decodedKeyTime <<
+                       " verifications/s");
+    BOOST_TEST_MESSAGE(type << " batch in " << N_THREADS << " threads: " << N_PACKETS / batchTime <<
+                       " verifications/s");
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,182 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/cs.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include "../tests-common.hpp"
+
+#define CHECK_CS_FIND(expected) find([&] (uint32_t found) { BOOST_CHECK_EQUAL(expected, found); });
+
+namespace nfd {
+namespace cs {
+namespace tests {
+
+static shared_ptr<Data>
+makeData(const Name& name)
+{
+  auto data = make_shared<Data>(name);
+  ndn::SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(ndn::dataBlock(tlv::SignatureValue,
+                                        static_cast<const uint8_t*>(nullptr), 0));
+  data->setSignature(fakeSignature);
+  data->wireEncode();
+  return data;
+}
+
+BOOST_AUTO_TEST_SUITE(NfdCs)
+
+class FindFixture
+{
+protected:
+  Name
+  insert(uint32_t id, const Name& name)
+  {
+    shared_ptr<Data> data = makeData(name);
+    data->setFreshnessPeriod(time::milliseconds(99999));
+    data->setContent(reinterpret_cast<const uint8_t*>(&id), sizeof(id));
+    data->wireEncode();
+
+    m_cs.insert(*data);
+
+    return data->getFullName();
+  }
+
+  Interest&
+  startInterest(const Name& name)
+  {
+    m_interest = make_shared<Interest>(name);
+    return *m_interest;
+  }
+
+  void
+  find(const std::function<void(uint32_t)>& check)
+  {
+    m_cs.find(*m_interest,
+              [&] (const Interest& interest, const Data& data) {
+                  const Block& content = data.getContent();
+                  uint32_t found = *reinterpret_cast<const uint32_t*>(content.value());
+                  check(found); },
+              bind([&] { check(0); }));
+  }
+
+protected:
+  Cs m_cs;
+  shared_ptr<Interest> m_interest;
+};
+
+BOOST_FIXTURE_TEST_SUITE(Find, FindFixture)
+
+BOOST_AUTO_TEST_CASE(RightmostExactAndChildren)
+{
+  insert(1, "ndn:/A");
+  insert(2, "ndn:/A/B");
+  insert(3, "ndn:/A/B/C");
+
+  startInterest("ndn:/A")
+    .setChildSelector(1);
+  CHECK_CS_FIND(2);
+
+  startInterest("ndn:/A")
+    .setChildSelector(1)
+    .setMaxSuffixComponents(1);
+  CHECK_CS_FIND(1);
+
+  startInterest("ndn:/A")
+    .setChildSelector(1)
+    .setMinSuffixComponents(3);
+  CHECK_CS_FIND(3);
+}
+
+BOOST_AUTO_TEST_CASE(ExcludeChildren)
+{
+  insert(1, "ndn:/A/B");
+  insert(2, "ndn:/A/C");
+  insert(3, "ndn:/A/D");
+
+  Exclude excludeB;
+  excludeB.excludeOne(name::Component("B"));
+  startInterest("ndn:/A")
+    .setChildSelector(0)
+    .setExclude(excludeB);
+  CHECK_CS_FIND(2);
+
+  Exclude excludeD;
+  excludeD.excludeOne(name::Component("D"));
+  startInterest("ndn:/A")
+    .setChildSelector(1)
+    .setExclude(excludeD);
+  CHECK_CS_FIND(2);
+}
+
+BOOST_AUTO_TEST_CASE(FullNameWithSelectors)
+{
+  Name n1 = insert(1, "ndn:/A");
+  insert(2, "ndn:/A/B");
+
+  startInterest(n1)
+    .setChildSelector(1);
+  CHECK_CS_FIND(1);
+
+  startInterest(n1)
+    .setMinSuffixComponents(1);
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_CASE(EnumerationOrder)
+{
+  Cs cs;
+
+  std::vector<Name> names = {"/D", "/A/B/C", "/", "/A", "/A/B", "/B/A"};
+  for (const Name& name : names) {
+    cs.insert(*makeData(name));
+  }
+
+  std::vector<Name> expected = names;
+  std::sort(expected.begin(), expected.end());
+  std::vector<Name> actual;
+  for (const auto& csEntry : cs) {
+    actual.push_back(csEntry.getName());
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Eviction)
+{
+  Cs cs(1);
+
+  cs.insert(*makeData("/A/B/C"));
+  cs.insert(*makeData("/D"));
+  BOOST_CHECK_EQUAL(cs.size(), 1);
+  BOOST_CHECK_EQUAL(cs.begin()->getName(), Name("/D"));
+  BOOST_CHECK(std::next(cs.begin()) == cs.end());
+
+  cs.find(Interest("/A"),
+          bind([] { BOOST_CHECK(false); }),
+          bind([] { BOOST_CHECK(true); }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace cs
+} // namespace nfd
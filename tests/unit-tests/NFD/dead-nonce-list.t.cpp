@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/dead-nonce-list.hpp"
+
+#include "../tests-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(NfdDeadNonceList, ns3::ndn::CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Duplicate)
+{
+  Name nameA("ndn:/A");
+  const uint32_t nonce1 = 0x53b4eaa8;
+
+  DeadNonceList dnl;
+  dnl.add(nameA, nonce1);
+  dnl.add(nameA, nonce1);
+  BOOST_CHECK_EQUAL(dnl.size(), 2);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+}
+
+BOOST_AUTO_TEST_CASE(Eviction)
+{
+  Name nameA("ndn:/A");
+  const uint32_t nNonces = 1000;
+
+  // MARKs are the oldest entries and are evicted first; no MARK is added and the capacity
+  // is not adjusted until the simulation runs
+  DeadNonceList dnl;
+  for (uint32_t nonce = 0; nonce < nNonces; ++nonce) {
+    dnl.add(nameA, nonce);
+  }
+  size_t capacity = dnl.size();
+  BOOST_REQUIRE_LT(capacity, nNonces);
+
+  size_t nFound = 0;
+  for (uint32_t nonce = 0; nonce < nNonces; ++nonce) {
+    if (dnl.has(nameA, nonce)) {
+      BOOST_CHECK_GE(nonce, nNonces - capacity);
+      ++nFound;
+    }
+  }
+  BOOST_CHECK_EQUAL(nFound, capacity);
+}
+
+BOOST_AUTO_TEST_CASE(CapacityGrowth)
+{
+  Name nameA("ndn:/A");
+
+  // 2000 Nonces per lifetime push MARKs out early, so the capacity and the storage grow
+  // beyond their initial size until Nonces are kept for about the lifetime
+  DeadNonceList dnl(time::seconds(1));
+  uint32_t nextNonce = 0;
+  scheduler::ScopedEventId addEvent;
+  std::function<void()> addNonces = [&] {
+    for (int i = 0; i < 20; ++i) {
+      dnl.add(nameA, nextNonce++);
+    }
+    addEvent = scheduler::schedule(time::milliseconds(10), addNonces);
+  };
+  addNonces();
+
+  ns3::Simulator::Stop(ns3::Seconds(30));
+  ns3::Simulator::Run();
+
+  BOOST_CHECK_GT(dnl.size(), 1000);
+  size_t nFound = 0;
+  for (uint32_t nonce = nextNonce - 1000; nonce < nextNonce; ++nonce) {
+    nFound += dnl.has(nameA, nonce);
+  }
+  BOOST_CHECK_EQUAL(nFound, 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
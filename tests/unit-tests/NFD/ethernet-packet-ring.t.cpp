@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "face/ethernet-packet-ring.hpp"
+
+#include "core/network-interface.hpp"
+
+#include "../tests-common.hpp"
+
+#ifdef NFD_HAVE_PACKET_RING
+
+#include <net/if.h> // for if_nametoindex()
+#include <poll.h>   // for poll()
+
+namespace nfd {
+namespace tests {
+
+/** \brief rings in ordinary memory, with the test playing the kernel
+ */
+class PacketRingMemoryFixture
+{
+protected:
+  PacketRingMemoryFixture()
+    : ring(ethernet::HDR_LEN + ethernet::MAX_DATA_LEN, 4096)
+    , memory(ring.getRingsSize() / sizeof(uint64_t) + 1)
+  {
+    ring.attach(reinterpret_cast<uint8_t*>(memory.data()));
+  }
+
+  tpacket_block_desc*
+  getRxBlock(size_t index)
+  {
+    return reinterpret_cast<tpacket_block_desc*>(reinterpret_cast<uint8_t*>(memory.data()) +
+                                                 index * ring.getRxBlockSize());
+  }
+
+  tpacket3_hdr*
+  getTxSlot(size_t index)
+  {
+    return reinterpret_cast<tpacket3_hdr*>(reinterpret_cast<uint8_t*>(memory.data()) +
+                                           ring.getRxBlockSize() * ring.getNRxBlocks() +
+                                           index * ring.getFrameSize());
+  }
+
+  /** \brief hands RX block \p index over with \p nFrames frames of FRAME_LENGTH octets,
+   *         filled with \p value, \p value + 1, ...
+   */
+  void
+  fillRxBlock(size_t index, size_t nFrames, uint8_t value)
+  {
+    tpacket_block_desc* block = getRxBlock(index);
+    block->hdr.bh1.num_pkts = nFrames;
+    block->hdr.bh1.offset_to_first_pkt = TPACKET_ALIGN(sizeof(tpacket_block_desc));
+
+    uint8_t* position = reinterpret_cast<uint8_t*>(block) + block->hdr.bh1.offset_to_first_pkt;
+    for (size_t i = 0; i < nFrames; ++i) {
+      auto header = reinterpret_cast<tpacket3_hdr*>(position);
+      header->tp_mac = TPACKET_ALIGN(sizeof(tpacket3_hdr));
+      header->tp_snaplen = FRAME_LENGTH;
+      header->tp_next_offset = i + 1 < nFrames ? TPACKET_ALIGN(header->tp_mac + FRAME_LENGTH) : 0;
+      std::fill_n(position + header->tp_mac, FRAME_LENGTH, static_cast<uint8_t>(value + i));
+      position += header->tp_next_offset;
+    }
+    block->hdr.bh1.block_status = TP_STATUS_USER;
+  }
+
+protected:
+  static const size_t FRAME_LENGTH = 100;
+
+  PacketRingMemory ring;
+  std::vector<uint64_t> memory;
+};
+
+const size_t PacketRingMemoryFixture::FRAME_LENGTH;
+
+BOOST_AUTO_TEST_SUITE(NfdEthernetPacketRing)
+
+BOOST_FIXTURE_TEST_CASE(ReceiveBlocks, PacketRingMemoryFixture)
+{
+  const uint8_t* frame = nullptr;
+  size_t frameLength = 0;
+  BOOST_CHECK_EQUAL(ring.receive(frame, frameLength), false);
+
+  // more blocks than the ring has, so that the block index wraps around
+  for (size_t i = 0; i < ring.getNRxBlocks() + 2; ++i) {
+    size_t index = i % ring.getNRxBlocks();
+    fillRxBlock(index, 3, static_cast<uint8_t>(i));
+
+    for (size_t j = 0; j < 3; ++j) {
+      BOOST_REQUIRE_EQUAL(ring.receive(frame, frameLength), true);
+      BOOST_CHECK_EQUAL(frameLength, FRAME_LENGTH);
+      BOOST_CHECK_EQUAL(frame[0], static_cast<uint8_t>(i + j));
+      BOOST_CHECK_EQUAL(frame[FRAME_LENGTH - 1], static_cast<uint8_t>(i + j));
+    }
+
+    // the block goes back to the kernel on the call after its last frame
+    BOOST_CHECK_EQUAL(getRxBlock(index)->hdr.bh1.block_status, TP_STATUS_USER);
+    BOOST_CHECK_EQUAL(ring.receive(frame, frameLength), false);
+    BOOST_CHECK_EQUAL(getRxBlock(index)->hdr.bh1.block_status, TP_STATUS_KERNEL);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(SendSlots, PacketRingMemoryFixture)
+{
+  size_t dataOffset = ring.getFrameSize() - ring.getMaxFrameLength();
+  for (size_t i = 0; i < ring.getNTxFrames(); ++i) {
+    uint8_t* frame = ring.beginSend();
+    BOOST_REQUIRE(frame == reinterpret_cast<uint8_t*>(getTxSlot(i)) + dataOffset);
+    ring.commitSend(ethernet::MIN_DATA_LEN + i % 100);
+    BOOST_CHECK_EQUAL(getTxSlot(i)->tp_status, TP_STATUS_SEND_REQUEST);
+    BOOST_CHECK_EQUAL(getTxSlot(i)->tp_len, ethernet::MIN_DATA_LEN + i % 100);
+  }
+
+  // the ring is full until the kernel has transmitted the first slot
+  BOOST_CHECK(ring.beginSend() == nullptr);
+  getTxSlot(0)->tp_status = TP_STATUS_SENDING;
+  BOOST_CHECK(ring.beginSend() == nullptr);
+  getTxSlot(0)->tp_status = TP_STATUS_AVAILABLE;
+  BOOST_CHECK(ring.beginSend() == reinterpret_cast<uint8_t*>(getTxSlot(0)) + dataOffset);
+}
+
+/** \brief two packet rings bound to the loopback interface
+ *
+ *  Frames sent on the loopback interface are received by every socket bound to it.
+ */
+class PacketRingFixture
+{
+protected:
+  PacketRingFixture()
+  {
+    try {
+      sender.reset(new PacketRing(ethernet::HDR_LEN + ethernet::MAX_DATA_LEN));
+      receiver.reset(new PacketRing(ethernet::HDR_LEN + ethernet::MAX_DATA_LEN));
+      sender->bind(if_nametoindex("lo"), ETHERTYPE);
+      receiver->bind(if_nametoindex("lo"), ETHERTYPE);
+    }
+    catch (const PacketRing::Error& e) {
+      BOOST_WARN_MESSAGE(false, "Cannot create packet ring (" << e.what() << "), "
+                                "skipping the test, which requires CAP_NET_RAW");
+      sender.reset();
+      receiver.reset();
+    }
+  }
+
+  /** \brief writes a frame whose payload is \p payloadLength octets of \p value
+   */
+  static size_t
+  makeFrame(uint8_t* frame, uint8_t value, size_t payloadLength)
+  {
+    static const uint8_t header[ethernet::HDR_LEN] = {
+      0x01, 0x00, 0x5e, 0x00, 0x17, 0xaa, // destination address
+      0x02, 0x00, 0x00, 0x00, 0x00, 0x02, // source address
+      ETHERTYPE >> 8, ETHERTYPE & 0xff
+    };
+    std::copy(header, header + sizeof(header), frame);
+    std::fill_n(frame + ethernet::HDR_LEN, payloadLength, value);
+    return ethernet::HDR_LEN + payloadLength;
+  }
+
+  /** \brief receives frames until \p nFrames have arrived or no frame arrives for one second
+   */
+  std::vector<std::vector<uint8_t>>
+  receiveFrames(size_t nFrames)
+  {
+    std::vector<std::vector<uint8_t>> frames;
+    pollfd pfd{receiver->getFd(), POLLIN, 0};
+    while (frames.size() < nFrames && ::poll(&pfd, 1, 1000) > 0) {
+      const uint8_t* frame;
+      size_t frameLength;
+      while (receiver->receive(frame, frameLength)) {
+        frames.emplace_back(frame, frame + frameLength);
+      }
+    }
+    return frames;
+  }
+
+protected:
+  // an ethertype nothing else on the loopback interface would be using
+  static const uint16_t ETHERTYPE = 0x88b5;
+
+  unique_ptr<PacketRing> sender;
+  unique_ptr<PacketRing> receiver;
+};
+
+BOOST_FIXTURE_TEST_CASE(SendReceive, PacketRingFixture)
+{
+  if (sender == nullptr)
+    return;
+
+  const size_t N_FRAMES = 200;
+  for (size_t i = 0; i < N_FRAMES; ++i) {
+    uint8_t* frame = sender->beginSend();
+    BOOST_REQUIRE(frame != nullptr);
+    sender->commitSend(makeFrame(frame, static_cast<uint8_t>(i),
+                                 ethernet::MIN_DATA_LEN + i * 7 % ethernet::MAX_DATA_LEN));
+  }
+  BOOST_CHECK_EQUAL(sender->flush(), N_FRAMES);
+  BOOST_CHECK_EQUAL(sender->flush(), 0);
+
+  std::vector<std::vector<uint8_t>> frames = receiveFrames(N_FRAMES);
+  BOOST_REQUIRE_EQUAL(frames.size(), N_FRAMES);
+  std::vector<uint8_t> expected(ethernet::HDR_LEN + ethernet::MAX_DATA_LEN);
+  for (size_t i = 0; i < N_FRAMES; ++i) {
+    size_t expectedLength = makeFrame(expected.data(), static_cast<uint8_t>(i),
+                                      ethernet::MIN_DATA_LEN + i * 7 % ethernet::MAX_DATA_LEN);
+    BOOST_CHECK_EQUAL_COLLECTIONS(frames[i].begin(), frames[i].end(),
+                                  expected.begin(), expected.begin() + expectedLength);
+  }
+
+  // all RX blocks have been given back to the kernel
+  pollfd pfd{receiver->getFd(), POLLIN, 0};
+  BOOST_CHECK_EQUAL(::poll(&pfd, 1, 0), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(TxRingFull, PacketRingFixture)
+{
+  if (sender == nullptr)
+    return;
+
+  size_t nSlots = 0;
+  while (uint8_t* frame = sender->beginSend()) {
+    sender->commitSend(makeFrame(frame, 0xbb, ethernet::MIN_DATA_LEN));
+    ++nSlots;
+  }
+  BOOST_CHECK_GE(nSlots, 16);
+
+  // slots become free again once the kernel has transmitted the frames
+  BOOST_CHECK_EQUAL(sender->flush(true), nSlots);
+  BOOST_CHECK(sender->beginSend() != nullptr);
+  BOOST_CHECK_EQUAL(receiveFrames(nSlots).size(), nSlots);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
+
+#endif // NFD_HAVE_PACKET_RING
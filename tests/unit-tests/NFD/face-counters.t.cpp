@@ -0,0 +1,54 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "face/face-counters.hpp"
+
+#include "../tests-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(NfdFaceCounters)
+
+BOOST_AUTO_TEST_CASE(BatchCnt)
+{
+  BatchCounters counters;
+  BOOST_CHECK_EQUAL(counters.getNBatches(), 0);
+  BOOST_CHECK_EQUAL(counters.getMaxBatchSize(), 0);
+
+  counters.add(1);
+  counters.add(3);
+  counters.add(4);
+  counters.add(7);
+  counters.add(500);
+  BOOST_CHECK_EQUAL(counters.getNBatches(), 5);
+  BOOST_CHECK_EQUAL(counters.getNPackets(), 515);
+  BOOST_CHECK_EQUAL(counters.getMaxBatchSize(), 500);
+  BOOST_CHECK_EQUAL(counters.getNBatchesInBucket(0), 1);
+  BOOST_CHECK_EQUAL(counters.getNBatchesInBucket(1), 1);
+  BOOST_CHECK_EQUAL(counters.getNBatchesInBucket(2), 2);
+  BOOST_CHECK_EQUAL(counters.getNBatchesInBucket(3), 0);
+  BOOST_CHECK_EQUAL(counters.getNBatchesInBucket(BatchCounters::N_BUCKETS - 1), 1);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "fw/face-table.hpp"
+#include "fw/forwarder.hpp"
+
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include "../tests-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(NfdFaceTable, ns3::ndn::CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(ManyFaces)
+{
+  Forwarder forwarder;
+  FaceTable& faceTable = forwarder.getFaceTable();
+
+  shared_ptr<Face> reserved = make_shared<DummyFace>();
+  faceTable.addReserved(reserved, 5);
+
+  // the index grows several times, and is probed past long-lived faces
+  std::vector<shared_ptr<Face>> faces;
+  for (size_t i = 0; i < 1000; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+    faceTable.add(faces.back());
+    if (i % 3 == 0) {
+      faces[i / 2]->close();
+    }
+  }
+
+  size_t nFaces = 1;
+  for (const shared_ptr<Face>& face : faces) {
+    if (face->getId() != INVALID_FACEID) {
+      BOOST_CHECK_EQUAL(faceTable.get(face->getId()), face);
+      ++nFaces;
+    }
+  }
+  BOOST_CHECK_EQUAL(faceTable.size(), nFaces);
+  BOOST_CHECK_EQUAL(faceTable.get(5), reserved);
+  BOOST_CHECK(faceTable.get(INVALID_FACEID) == nullptr);
+  BOOST_CHECK(faceTable.get(FACEID_RESERVED_MAX + 1) == nullptr);
+  BOOST_CHECK(faceTable.get(FACEID_RESERVED_MAX + 5000) == nullptr);
+
+  // enumeration is in increasing FaceId order
+  BOOST_CHECK_EQUAL(std::distance(faceTable.begin(), faceTable.end()), faceTable.size());
+  BOOST_CHECK(std::is_sorted(faceTable.begin(), faceTable.end(),
+                             [] (const shared_ptr<Face>& a, const shared_ptr<Face>& b) {
+                               return a->getId() < b->getId();
+                             }));
+  BOOST_CHECK_EQUAL(*faceTable.begin(), reserved);
+
+  for (const shared_ptr<Face>& face : faces) {
+    FaceId faceId = face->getId();
+    if (faceId != INVALID_FACEID) {
+      face->close();
+      BOOST_CHECK(faceTable.get(faceId) == nullptr);
+    }
+  }
+  BOOST_CHECK_EQUAL(faceTable.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "core/memory-pool.hpp"
+
+#include "../tests-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(NfdMemoryPool)
+
+BOOST_AUTO_TEST_CASE(AllocateDeallocate)
+{
+  MemoryPool pool;
+  BOOST_CHECK(pool.canAllocate(24));
+  BOOST_CHECK_EQUAL(pool.getNBlocks(), 0);
+
+  void* p1 = pool.allocate(24);
+  BOOST_CHECK(!pool.canAllocate(32));
+  BOOST_CHECK(pool.canAllocate(24));
+  BOOST_CHECK_GE(pool.getBlockSize(), 24);
+  BOOST_CHECK_EQUAL(pool.getNAllocatedBlocks(), 1);
+  BOOST_CHECK_EQUAL(pool.getNBlocks(), MemoryPool::MIN_CHUNK_BLOCKS);
+
+  std::vector<void*> blocks;
+  for (size_t i = 0; i < MemoryPool::MIN_CHUNK_BLOCKS; ++i) {
+    blocks.push_back(pool.allocate(24));
+  }
+  BOOST_CHECK_EQUAL(pool.getNAllocatedBlocks(), MemoryPool::MIN_CHUNK_BLOCKS + 1);
+  BOOST_CHECK_EQUAL(pool.getNBlocks(), MemoryPool::MIN_CHUNK_BLOCKS * 2);
+
+  // a deallocated block is reused first
+  pool.deallocate(p1);
+  BOOST_CHECK_EQUAL(pool.getNAllocatedBlocks(), MemoryPool::MIN_CHUNK_BLOCKS);
+  void* p2 = pool.allocate(24);
+  BOOST_CHECK_EQUAL(p2, p1);
+
+  blocks.push_back(p2);
+  for (void* p : blocks) {
+    pool.deallocate(p);
+  }
+  BOOST_CHECK_EQUAL(pool.getNAllocatedBlocks(), 0);
+  BOOST_CHECK_EQUAL(pool.getNBlocks(), MemoryPool::MIN_CHUNK_BLOCKS * 2);
+}
+
+class Item
+{
+public:
+  explicit
+  Item(int& nAlive)
+    : m_nAlive(nAlive)
+  {
+    ++m_nAlive;
+  }
+
+  ~Item()
+  {
+    --m_nAlive;
+  }
+
+private:
+  int& m_nAlive;
+};
+
+BOOST_AUTO_TEST_CASE(AllocateShared)
+{
+  int nAlive = 0;
+  shared_ptr<MemoryPool> pool = make_shared<MemoryPool>();
+  weak_ptr<MemoryPool> weakPool = pool;
+
+  shared_ptr<Item> item1 = std::allocate_shared<Item>(PoolAllocator<Item>(pool), ref(nAlive));
+  shared_ptr<Item> item2 = std::allocate_shared<Item>(PoolAllocator<Item>(pool), ref(nAlive));
+  BOOST_CHECK_EQUAL(nAlive, 2);
+  BOOST_CHECK_EQUAL(pool->getNAllocatedBlocks(), 2);
+  BOOST_CHECK_GE(pool->getBlockSize(), sizeof(Item));
+
+  item1.reset();
+  BOOST_CHECK_EQUAL(nAlive, 1);
+  BOOST_CHECK_EQUAL(pool->getNAllocatedBlocks(), 1);
+
+  // the pool is kept alive by objects allocated from it
+  pool.reset();
+  BOOST_CHECK_EQUAL(weakPool.expired(), false);
+
+  // a weak_ptr keeps the block until it is released
+  weak_ptr<Item> weakItem = item2;
+  item2.reset();
+  BOOST_CHECK_EQUAL(nAlive, 0);
+  BOOST_CHECK_EQUAL(weakPool.expired(), false);
+  weakItem.reset();
+  BOOST_CHECK_EQUAL(weakPool.expired(), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
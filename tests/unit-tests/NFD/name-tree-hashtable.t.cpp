@@ -0,0 +1,238 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/name-tree-hashtable.hpp"
+#include "table/name-tree.hpp"
+
+#include <set>
+
+#include "../tests-common.hpp"
+
+namespace nfd {
+namespace name_tree {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(NfdNameTreeHashtable)
+
+static shared_ptr<Entry>
+makeEntry(const Name& name)
+{
+  shared_ptr<Entry> entry = make_shared<Entry>(name);
+  entry->setHash(computeHash(name));
+  return entry;
+}
+
+static size_t
+countEntries(const Hashtable& ht)
+{
+  size_t count = 0;
+  for (shared_ptr<Entry> entry = ht.getFirst(); entry != nullptr; entry = ht.getNext(*entry)) {
+    ++count;
+  }
+  return count;
+}
+
+typedef boost::mpl::vector<ChainedHashtable, OpenAddressingHashtable> HashtableTypes;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(FindInsertErase, HashtableType, HashtableTypes)
+{
+  HashtableType ht(16);
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK(ht.getFirst() == nullptr);
+
+  Name nameABC("/A/B/C");
+  shared_ptr<Entry> entryAB = makeEntry("/A/B");
+  shared_ptr<Entry> entryABC = makeEntry(nameABC);
+  ht.insert(entryAB);
+  ht.insert(entryABC);
+  BOOST_CHECK_EQUAL(ht.size(), 2);
+  BOOST_CHECK_EQUAL(countEntries(ht), 2);
+
+  // a prefix is given as a name and a number of components
+  BOOST_CHECK_EQUAL(ht.find(nameABC, 3, computeHash(nameABC)), entryABC);
+  BOOST_CHECK_EQUAL(ht.find(nameABC, 2, computeHash("/A/B")), entryAB);
+  BOOST_CHECK(ht.find(nameABC, 1, computeHash("/A")) == nullptr);
+  BOOST_CHECK(ht.find("/A/B/D", 3, computeHash(nameABC)) == nullptr);
+
+  ht.erase(*entryAB);
+  BOOST_CHECK_EQUAL(ht.size(), 1);
+  BOOST_CHECK(ht.find(nameABC, 2, computeHash("/A/B")) == nullptr);
+  BOOST_CHECK_EQUAL(ht.find(nameABC, 3, computeHash(nameABC)), entryABC);
+  BOOST_CHECK_EQUAL(ht.getFirst(), entryABC);
+  BOOST_CHECK(ht.getNext(*entryABC) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(Resize, HashtableType, HashtableTypes)
+{
+  const size_t N_ENTRIES = 5000;
+
+  HashtableType ht(16);
+  std::vector<shared_ptr<Entry>> entries;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    Name name("/resize");
+    name.appendNumber(i);
+    entries.push_back(makeEntry(name));
+    ht.insert(entries.back());
+  }
+  BOOST_CHECK_EQUAL(ht.size(), N_ENTRIES);
+  BOOST_CHECK_GT(ht.getNBuckets(), N_ENTRIES);
+  BOOST_CHECK_EQUAL(countEntries(ht), N_ENTRIES);
+
+  for (size_t i = 0; i < N_ENTRIES; i += 2) {
+    ht.erase(*entries[i]);
+  }
+  BOOST_CHECK_EQUAL(countEntries(ht), N_ENTRIES / 2);
+
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    const Name& name = entries[i]->getPrefix();
+    shared_ptr<Entry> found = ht.find(name, name.size(), entries[i]->getHash());
+    if (i % 2 == 0) {
+      BOOST_CHECK(found == nullptr);
+    }
+    else {
+      BOOST_CHECK_EQUAL(found, entries[i]);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalResize)
+{
+  OpenAddressingHashtable ht(16);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 16);
+
+  std::vector<shared_ptr<Entry>> entries;
+  for (size_t i = 0; !ht.isResizing(); ++i) {
+    Name name("/incremental");
+    name.appendNumber(i);
+    entries.push_back(makeEntry(name));
+    ht.insert(entries.back());
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+
+  // entries that are not migrated yet remain reachable
+  for (const shared_ptr<Entry>& entry : entries) {
+    const Name& name = entry->getPrefix();
+    BOOST_CHECK_EQUAL(ht.find(name, name.size(), entry->getHash()), entry);
+  }
+  BOOST_CHECK_EQUAL(countEntries(ht), entries.size());
+
+  // each insertion migrates a few slots, until the old slot array is released
+  for (size_t i = 0; ht.isResizing(); ++i) {
+    Name name("/more");
+    name.appendNumber(i);
+    entries.push_back(makeEntry(name));
+    ht.insert(entries.back());
+  }
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+  BOOST_CHECK_EQUAL(countEntries(ht), entries.size());
+}
+
+BOOST_AUTO_TEST_CASE(EnumerateDuringResize)
+{
+  OpenAddressingHashtable ht(16);
+
+  std::vector<shared_ptr<Entry>> entries;
+  for (size_t i = 0; !ht.isResizing(); ++i) {
+    Name name("/enumerate");
+    name.appendNumber(i);
+    entries.push_back(makeEntry(name));
+    ht.insert(entries.back());
+  }
+  std::set<Entry*> remaining;
+  for (const shared_ptr<Entry>& entry : entries) {
+    remaining.insert(entry.get());
+  }
+
+  // Every step inserts an entry, which migrates old slots and eventually starts further
+  // resizes, and every other step erases the current entry.  Entries present from start
+  // to end of the enumeration must be visited exactly once.
+  std::set<Entry*> visited;
+  std::set<Entry*> erased;
+  size_t nInserted = 0;
+  size_t nResizingSteps = 0;
+  size_t nBuckets = ht.getNBuckets();
+  for (shared_ptr<Entry> entry = ht.getFirst(); entry != nullptr; entry = ht.getNext(*entry)) {
+    BOOST_REQUIRE(visited.insert(entry.get()).second);
+    remaining.erase(entry.get());
+
+    if (nInserted < 500) {
+      Name name("/inserted");
+      name.appendNumber(nInserted++);
+      entries.push_back(makeEntry(name));
+      ht.insert(entries.back());
+    }
+    if (visited.size() % 2 == 0) {
+      ht.erase(*entry);
+      erased.insert(entry.get());
+    }
+    if (ht.isResizing()) {
+      ++nResizingSteps;
+    }
+  }
+  BOOST_CHECK(remaining.empty());
+  BOOST_CHECK_GT(nResizingSteps, 0);
+  BOOST_CHECK_GT(ht.getNBuckets(), nBuckets);
+
+  // erasures during a resize keep the remaining entries reachable
+  BOOST_CHECK_EQUAL(countEntries(ht), ht.size());
+  BOOST_CHECK_EQUAL(ht.size(), entries.size() - erased.size());
+  for (const shared_ptr<Entry>& entry : entries) {
+    const Name& name = entry->getPrefix();
+    shared_ptr<Entry> found = ht.find(name, name.size(), entry->getHash());
+    if (erased.count(entry.get()) > 0) {
+      BOOST_CHECK(found == nullptr);
+    }
+    else {
+      BOOST_CHECK_EQUAL(found, entry);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(NameTreeOpenAddressing)
+{
+  NameTree nt(16, HASHTABLE_OPEN_ADDRESSING);
+  BOOST_CHECK_EQUAL(nt.getNBuckets(), 16);
+
+  shared_ptr<Entry> entryABC = nt.lookup("/a/b/c");
+  nt.lookup("/a/b/d");
+  nt.lookup("/e");
+  BOOST_CHECK_EQUAL(nt.size(), 6);
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/a/b/c"), entryABC);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/a/b/c/d/e"), entryABC);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch("/a/f"), nt.findExactMatch("/a"));
+
+  size_t nEntries = 0;
+  for (const Entry& entry : nt) {
+    BOOST_CHECK(nt.findExactMatch(entry.getPrefix()) != nullptr);
+    ++nEntries;
+  }
+  BOOST_CHECK_EQUAL(nEntries, 6);
+
+  BOOST_CHECK(nt.eraseEntryIfEmpty(nt.findExactMatch("/e")));
+  BOOST_CHECK_EQUAL(nt.size(), 5);
+  BOOST_CHECK(nt.eraseEntryIfEmpty(entryABC));
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+  BOOST_CHECK(nt.findExactMatch("/a/b/c") == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace name_tree
+} // namespace nfd
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/name-tree.hpp"
+
+#include "../tests-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(NfdNameTree)
+
+BOOST_AUTO_TEST_CASE(HashSetTag)
+{
+  auto interest = make_shared<Interest>(Name("/A/B/C"));
+  BOOST_CHECK(interest->getTag<name_tree::HashSetTag>() == nullptr);
+
+  shared_ptr<name_tree::HashSetTag> tag = name_tree::getHashSetTag(*interest);
+  BOOST_CHECK(tag->getHashSet() == name_tree::computeHashSet(interest->getName()));
+  BOOST_CHECK_EQUAL(interest->getTag<name_tree::HashSetTag>(), tag);
+
+  // second call reuses the cached hash values
+  BOOST_CHECK_EQUAL(name_tree::getHashSetTag(*interest), tag);
+
+  // a modified Name invalidates the tag
+  interest->setName("/A/B/D");
+  shared_ptr<name_tree::HashSetTag> tag2 = name_tree::getHashSetTag(*interest);
+  BOOST_CHECK_NE(tag2, tag);
+  BOOST_CHECK(tag2->getHashSet() == name_tree::computeHashSet(interest->getName()));
+}
+
+BOOST_AUTO_TEST_CASE(PrecomputedHash)
+{
+  NameTree nt(16);
+
+  Name nameABC("/a/b/c");
+  std::vector<size_t> hashSetABC = name_tree::computeHashSet(nameABC);
+  shared_ptr<name_tree::Entry> npeABC = nt.lookup(nameABC, hashSetABC);
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+  BOOST_CHECK_EQUAL(npeABC->getHash(), hashSetABC.back());
+  BOOST_CHECK_EQUAL(nt.lookup(nameABC), npeABC);
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+
+  BOOST_CHECK_EQUAL(nt.findExactMatch(nameABC, hashSetABC.back()), npeABC);
+  BOOST_CHECK_EQUAL(nt.findExactMatch("/a/b", hashSetABC[2]), npeABC->getParent());
+
+  Name nameABCDE("/a/b/c/d/e");
+  std::vector<size_t> hashSetABCDE = name_tree::computeHashSet(nameABCDE);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(nameABCDE, hashSetABCDE), npeABC);
+  BOOST_CHECK_EQUAL(nt.findLongestPrefixMatch(nameABCDE, hashSetABCDE,
+                      [] (const name_tree::Entry& entry) { return entry.getPrefix().size() < 2; }),
+                    nt.findExactMatch("/a"));
+
+  size_t nMatches = 0;
+  for (const name_tree::Entry& entry : nt.findAllMatches(nameABCDE, hashSetABCDE)) {
+    BOOST_CHECK(entry.getPrefix().isPrefixOf(nameABCDE));
+    ++nMatches;
+  }
+  BOOST_CHECK_EQUAL(nMatches, 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "face/ndnlp-slicer.hpp"
+#include "face/ndnlp-partial-message-store.hpp"
+
+#include "../tests-common.hpp"
+
+#include <boost/scoped_array.hpp>
+
+namespace nfd {
+namespace ndnlp {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(NfdNdnlp)
+
+// slicing in place produces the same NDNLP packets as slice()
+BOOST_AUTO_TEST_CASE(SliceInPlace)
+{
+  uint8_t blockValue[5050];
+  memset(blockValue, 0xcc, sizeof(blockValue));
+  Block block = ndn::dataBlock(0x01, blockValue, sizeof(blockValue));
+
+  ndnlp::Slicer slicer(1500);
+  ndnlp::Slicer slicer2(1500);
+  ndnlp::FragmentArray fragments;
+  BOOST_REQUIRE_EQUAL(slicer.sliceInPlace(block, fragments), true);
+  ndnlp::PacketArray pa = slicer2.slice(block);
+  BOOST_REQUIRE_EQUAL(fragments.size(), pa->size());
+
+  for (size_t i = 0; i < fragments.size(); ++i) {
+    const ndnlp::Fragment& fragment = fragments[i];
+    BOOST_CHECK(fragment.payload >= block.wire() &&
+                fragment.payload + fragment.payloadSize <= block.wire() + block.size());
+
+    std::vector<uint8_t> packet(fragment.header, fragment.header + fragment.headerSize);
+    packet.insert(packet.end(), fragment.payload, fragment.payload + fragment.payloadSize);
+    BOOST_CHECK_LE(packet.size(), 1500);
+    BOOST_CHECK_EQUAL_COLLECTIONS(packet.begin(),     packet.end(),
+                                  pa->at(i).begin(), pa->at(i).end());
+  }
+
+  // sequence numbers continue with the next packet
+  BOOST_REQUIRE_EQUAL(slicer.sliceInPlace(block, fragments), true);
+  pa = slicer2.slice(block);
+  BOOST_REQUIRE_EQUAL(fragments.size(), pa->size());
+  BOOST_CHECK(std::equal(fragments[1].header, fragments[1].header + fragments[1].headerSize,
+                         pa->at(1).begin()));
+
+  // a packet that fits in the MTU is not sliced
+  uint8_t smallValue[1000];
+  memset(smallValue, 0xcc, sizeof(smallValue));
+  BOOST_CHECK_EQUAL(slicer.sliceInPlace(ndn::dataBlock(0x01, smallValue, sizeof(smallValue)),
+                                        fragments), false);
+  BOOST_CHECK(fragments.empty());
+}
+
+class ReassembleFixture
+{
+protected:
+  ReassembleFixture()
+    : slicer(1500)
+    , pms(time::milliseconds(100))
+  {
+    pms.onReceive.connect([this] (const Block& block) {
+      received.push_back(block);
+    });
+  }
+
+  Block
+  makeBlock(size_t valueLength)
+  {
+    boost::scoped_array<uint8_t> blockValue(new uint8_t[valueLength]);
+    memset(blockValue.get(), 0xcc, valueLength);
+    return ndn::dataBlock(0x01, blockValue.get(), valueLength);
+  }
+
+  void
+  receiveNdnlpData(const Block& block)
+  {
+    bool isOk = false;
+    ndnlp::NdnlpData pkt;
+    std::tie(isOk, pkt) = ndnlp::NdnlpData::fromBlock(block);
+    BOOST_REQUIRE(isOk);
+    pms.receive(pkt);
+  }
+
+protected:
+  ndnlp::Slicer slicer;
+  ndnlp::PartialMessageStore pms;
+
+  // received network layer packets
+  std::vector<Block> received;
+};
+
+// reassemble many messages whose fragments are interleaved and arrive in reverse order
+BOOST_FIXTURE_TEST_CASE(ReassembleInterleaved, ReassembleFixture)
+{
+  std::vector<Block> blocks;
+  std::vector<ndnlp::PacketArray> pas;
+  for (size_t i = 0; i < 16; ++i) {
+    blocks.push_back(makeBlock(3000 + i));
+    pas.push_back(slicer.slice(blocks.back()));
+    BOOST_REQUIRE_EQUAL(pas.back()->size(), 3);
+  }
+
+  for (int fragIndex = 2; fragIndex >= 0; --fragIndex) {
+    BOOST_CHECK_EQUAL(received.size(), 0);
+    for (const ndnlp::PacketArray& pa : pas) {
+      this->receiveNdnlpData(pa->at(fragIndex));
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(received.size(), blocks.size());
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    BOOST_CHECK_EQUAL_COLLECTIONS(received.at(i).begin(), received.at(i).end(),
+                                  blocks.at(i).begin(),   blocks.at(i).end());
+  }
+}
+
+// consecutive messages occupy consecutive slots, and a message that needs the slot of an
+// incomplete one evicts it as a collision
+BOOST_FIXTURE_TEST_CASE(ReassembleCollision, ReassembleFixture)
+{
+  const size_t nSlots = ndnlp::PartialMessageStore::N_SLOTS;
+  std::vector<ndnlp::PacketArray> pas;
+  for (size_t i = 0; i <= 2 * nSlots; ++i) {
+    pas.push_back(slicer.slice(makeBlock(3000)));
+    BOOST_REQUIRE_EQUAL(pas.back()->size(), 3);
+  }
+
+  // N_SLOTS messages in progress at once
+  for (int fragIndex = 0; fragIndex < 3; ++fragIndex) {
+    for (size_t i = 0; i < nSlots; ++i) {
+      this->receiveNdnlpData(pas[i]->at(fragIndex));
+    }
+  }
+  BOOST_CHECK_EQUAL(received.size(), nSlots);
+  BOOST_CHECK_EQUAL(pms.getNCollisions(), 0);
+
+  // messages N_SLOTS apart share a slot
+  this->receiveNdnlpData(pas[nSlots]->at(0));
+  for (int fragIndex = 0; fragIndex < 3; ++fragIndex) {
+    this->receiveNdnlpData(pas[2 * nSlots]->at(fragIndex));
+  }
+  BOOST_CHECK_EQUAL(received.size(), nSlots + 1);
+  BOOST_CHECK_EQUAL(pms.getNCollisions(), 1);
+
+  // the evicted message cannot be completed
+  this->receiveNdnlpData(pas[nSlots]->at(1));
+  this->receiveNdnlpData(pas[nSlots]->at(2));
+  BOOST_CHECK_EQUAL(received.size(), nSlots + 1);
+  BOOST_CHECK_EQUAL(pms.getNCollisions(), 1);
+}
+
+// a fragment whose size does not match the other fragments is dropped
+BOOST_FIXTURE_TEST_CASE(ReassembleInconsistentSize, ReassembleFixture)
+{
+  Block block = makeBlock(2000);
+  ndnlp::PacketArray pa = slicer.slice(block);
+  BOOST_REQUIRE_EQUAL(pa->size(), 2);
+
+  // fragments of another message sliced with a larger MTU
+  Block block2 = makeBlock(5000);
+  ndnlp::Slicer slicer2(3000);
+  ndnlp::PacketArray pa2 = slicer2.slice(block2);
+  BOOST_REQUIRE_EQUAL(pa2->size(), 2);
+
+  ndnlp::PartialMessage pm;
+  pm.start(0, 2);
+
+  bool isOk = false;
+  ndnlp::NdnlpData frag0, frag1, badFrag0;
+  std::tie(isOk, frag0) = ndnlp::NdnlpData::fromBlock(pa->at(0));
+  BOOST_REQUIRE(isOk);
+  std::tie(isOk, frag1) = ndnlp::NdnlpData::fromBlock(pa->at(1));
+  BOOST_REQUIRE(isOk);
+  std::tie(isOk, badFrag0) = ndnlp::NdnlpData::fromBlock(pa2->at(0));
+  BOOST_REQUIRE(isOk);
+
+  BOOST_CHECK_EQUAL(pm.add(0, 2, frag0.payload), true);
+  BOOST_CHECK_EQUAL(pm.add(0, 2, frag0.payload), false); // duplicate
+  BOOST_CHECK_EQUAL(pm.add(1, 2, badFrag0.payload), false); // last fragment larger than others
+  BOOST_CHECK_EQUAL(pm.add(1, 3, frag1.payload), false); // wrong fragment count
+  BOOST_CHECK_EQUAL(pm.isComplete(), false);
+  BOOST_CHECK_EQUAL(pm.add(1, 2, frag1.payload), true);
+  BOOST_REQUIRE_EQUAL(pm.isComplete(), true);
+
+  Block reassembled;
+  std::tie(isOk, reassembled) = pm.reassemble();
+  BOOST_REQUIRE(isOk);
+  BOOST_CHECK_EQUAL_COLLECTIONS(reassembled.begin(), reassembled.end(),
+                                block.begin(),       block.end());
+  BOOST_CHECK_EQUAL(pm.isInUse(), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndnlp
+} // namespace nfd
@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "core/small-vector.hpp"
+
+#include "../tests-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(NfdSmallVector)
+
+BOOST_AUTO_TEST_CASE(InlineAndSpill)
+{
+  SmallVector<shared_ptr<int>, 2> vec;
+  BOOST_CHECK(vec.empty());
+  BOOST_CHECK_EQUAL(vec.capacity(), 2);
+
+  auto it = vec.emplace_back(make_shared<int>(2));
+  BOOST_CHECK_EQUAL(**it, 2);
+  it = vec.emplace(vec.begin(), make_shared<int>(1));
+  BOOST_CHECK(it == vec.begin());
+  BOOST_CHECK_EQUAL(vec.capacity(), 2);
+
+  // spill to heap
+  shared_ptr<int> three = make_shared<int>(3);
+  it = vec.emplace(vec.end(), three);
+  BOOST_CHECK_EQUAL(**it, 3);
+  BOOST_CHECK_EQUAL(vec.capacity(), 3);
+  it = vec.emplace(vec.begin() + 1, make_shared<int>(0));
+  BOOST_CHECK_EQUAL(**it, 0);
+
+  std::vector<int> values;
+  for (const shared_ptr<int>& p : vec) {
+    values.push_back(*p);
+  }
+  std::vector<int> expected{1, 0, 2, 3};
+  BOOST_CHECK_EQUAL_COLLECTIONS(values.begin(), values.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(three.use_count(), 2);
+
+  it = vec.erase(vec.begin() + 1);
+  BOOST_CHECK_EQUAL(**it, 2);
+  it = vec.erase(vec.end() - 1);
+  BOOST_CHECK(it == vec.end());
+  BOOST_CHECK_EQUAL(vec.size(), 2);
+  BOOST_CHECK_EQUAL(*vec.front(), 1);
+  BOOST_CHECK_EQUAL(three.use_count(), 1);
+
+  vec.emplace_back(three);
+  vec.clear();
+  BOOST_CHECK(vec.empty());
+  BOOST_CHECK_EQUAL(three.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
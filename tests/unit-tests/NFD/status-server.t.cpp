@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "mgmt/status-server.hpp"
+#include "mgmt/internal-face.hpp"
+#include "fw/forwarder.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include "../tests-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(NfdStatusServer, ns3::ndn::CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Allocators)
+{
+  Forwarder forwarder;
+  shared_ptr<InternalFace> internalFace = make_shared<InternalFace>();
+  shared_ptr<const Data> response;
+  internalFace->onReceiveData.connect([&response] (const Data& data) {
+      response = data.shared_from_this();
+    });
+  StatusServer statusServer(internalFace, forwarder, ns3::ndn::StackHelper::getKeyChain());
+
+  forwarder.getPit().insert(*make_shared<Interest>("/pit1"));
+  forwarder.getPit().insert(*make_shared<Interest>("/pit2"));
+  forwarder.getMeasurements().get("/measurements1");
+
+  auto request = make_shared<Interest>("/localhost/nfd/status");
+  request->setMustBeFresh(true);
+  request->setChildSelector(1);
+  internalFace->sendInterest(*request);
+  ns3::Simulator::Run();
+  BOOST_REQUIRE(response != nullptr);
+
+  ndn::nfd::ForwarderStatus status;
+  BOOST_REQUIRE_NO_THROW(status.wireDecode(response->getContent()));
+
+  std::map<std::string, ndn::nfd::ForwarderStatus::AllocatorStatus> allocators;
+  for (const auto& allocator : status.getAllocators()) {
+    allocators[allocator.name] = allocator;
+  }
+  BOOST_REQUIRE_EQUAL(allocators.count("NameTreeEntry"), 1);
+  BOOST_CHECK_EQUAL(allocators["NameTreeEntry"].nAllocatedBlocks,
+                    forwarder.getNameTree().size());
+  BOOST_REQUIRE_EQUAL(allocators.count("PitEntry"), 1);
+  BOOST_CHECK_EQUAL(allocators["PitEntry"].nAllocatedBlocks, forwarder.getPit().size());
+  BOOST_CHECK_GE(allocators["PitEntry"].nBlocks, forwarder.getPit().size());
+  BOOST_CHECK_GE(allocators["PitEntry"].blockSize, sizeof(pit::Entry));
+  BOOST_REQUIRE_EQUAL(allocators.count("MeasurementsEntry"), 1);
+  BOOST_CHECK_EQUAL(allocators["MeasurementsEntry"].nAllocatedBlocks,
+                    forwarder.getMeasurements().size());}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
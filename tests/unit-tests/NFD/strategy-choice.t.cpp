@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/strategy-choice.hpp"
+#include "fw/forwarder.hpp"
+
+#include "tests/daemon/fw/dummy-strategy.hpp"
+
+#include "../tests-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+using fw::Strategy;
+
+BOOST_FIXTURE_TEST_SUITE(NfdStrategyChoice, ns3::ndn::CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(EffectiveMemoized)
+{
+  Forwarder forwarder;
+  Name nameP("ndn:/strategy/P");
+  Name nameQ("ndn:/strategy/Q");
+  shared_ptr<Strategy> strategyP = make_shared<DummyStrategy>(ref(forwarder), nameP);
+  shared_ptr<Strategy> strategyQ = make_shared<DummyStrategy>(ref(forwarder), nameQ);
+
+  StrategyChoice& table = forwarder.getStrategyChoice();
+  table.install(strategyP);
+  table.install(strategyQ);
+
+  BOOST_CHECK(table.insert("ndn:/", nameP));
+  // { '/'=>P }
+
+  // effective strategy of a deep entry is memoized on the entry and its ancestors,
+  // and must follow every later change above it
+  auto interest = make_shared<Interest>("ndn:/A/B/C");
+  shared_ptr<pit::Entry> pitEntry = forwarder.getPit().insert(*interest).first;
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameP);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameP);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy("ndn:/A/B/C/D").getName(), nameP);
+
+  BOOST_CHECK(table.insert("ndn:/A", nameQ));
+  // { '/'=>P, '/A'=>Q }
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameQ);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy("ndn:/A/B/C/D").getName(), nameQ);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy("ndn:/A/B").getName(), nameQ);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy("ndn:/E").getName(), nameP);
+
+  BOOST_CHECK(table.insert("ndn:/A/B/C", nameP));
+  // { '/'=>P, '/A'=>Q, '/A/B/C'=>P }
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameP);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy("ndn:/A/B").getName(), nameQ);
+
+  table.erase("ndn:/A/B/C");
+  // { '/'=>P, '/A'=>Q }
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameQ);
+
+  BOOST_CHECK(table.insert("ndn:/", nameQ));
+  table.erase("ndn:/A");
+  // { '/'=>Q }
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameQ);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy("ndn:/E").getName(), nameQ);
+
+  BOOST_CHECK(table.insert("ndn:/", nameP));
+  // { '/'=>P }
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy(*pitEntry).getName(), nameP);
+  BOOST_CHECK_EQUAL(table.findEffectiveStrategy("ndn:/A/B/C/D").getName(), nameP);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
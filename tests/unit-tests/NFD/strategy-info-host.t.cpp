@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/strategy-info-host.hpp"
+
+#include "../tests-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+using fw::StrategyInfo;
+
+static int g_DummyStrategyInfo_count = 0;
+
+class DummyStrategyInfo : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 1;
+  }
+
+  DummyStrategyInfo(int id)
+    : m_id(id)
+  {
+    ++g_DummyStrategyInfo_count;
+  }
+
+  DummyStrategyInfo(const DummyStrategyInfo& other)
+    : m_id(other.m_id)
+  {
+    ++g_DummyStrategyInfo_count;
+  }
+
+  virtual
+  ~DummyStrategyInfo()
+  {
+    --g_DummyStrategyInfo_count;
+  }
+
+  int m_id;
+};
+
+class DummyStrategyInfo2 : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 2;
+  }
+
+  DummyStrategyInfo2(int id)
+    : m_id(id)
+  {
+  }
+
+  int m_id;
+};
+
+BOOST_AUTO_TEST_SUITE(NfdStrategyInfoHost)
+
+BOOST_AUTO_TEST_CASE(GetEraseClear)
+{
+  StrategyInfoHost host;
+
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+
+  g_DummyStrategyInfo_count = 0;
+
+  DummyStrategyInfo& info = host.getOrCreateStrategyInfo<DummyStrategyInfo>(7591);
+  BOOST_CHECK_EQUAL(info.m_id, 7591);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>(), &info);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 1);
+
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), true);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), false);
+
+  host.getOrCreateStrategyInfo<DummyStrategyInfo>(1524);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 1524);
+
+  host.clearStrategyInfo();
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Create)
+{
+  StrategyInfoHost host;
+
+  host.getOrCreateStrategyInfo<DummyStrategyInfo>(3503);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 3503);
+
+  host.getOrCreateStrategyInfo<DummyStrategyInfo>(1032);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 3503);
+
+  host.eraseStrategyInfo<DummyStrategyInfo>();
+  host.getOrCreateStrategyInfo<DummyStrategyInfo>(9956);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 9956);
+}
+
+BOOST_AUTO_TEST_CASE(Types)
+{
+  StrategyInfoHost host;
+
+  host.getOrCreateStrategyInfo<DummyStrategyInfo>(8063);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 8063);
+
+  host.getOrCreateStrategyInfo<DummyStrategyInfo2>(2871);
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo2>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo2>()->m_id, 2871);
+
+  BOOST_REQUIRE(host.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>()->m_id, 8063);
+}
+
+class DummyStrategyInfoLarge : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 3;
+  }
+
+  explicit
+  DummyStrategyInfoLarge(int id)
+    : m_id(id)
+  {
+    ++g_DummyStrategyInfo_count;
+  }
+
+  virtual
+  ~DummyStrategyInfoLarge()
+  {
+    --g_DummyStrategyInfo_count;
+  }
+
+  int m_id;
+  char m_payload[StrategyInfoHost::SLOT_SIZE];
+};
+
+BOOST_AUTO_TEST_CASE(InPlace)
+{
+  StrategyInfoHost host;
+  g_DummyStrategyInfo_count = 0;
+
+  // a small item is constructed inside the host, a large one on the heap
+  DummyStrategyInfo& info = host.getOrCreateStrategyInfo<DummyStrategyInfo>(5117);
+  const char* hostBegin = reinterpret_cast<const char*>(&host);
+  const char* infoAddr = reinterpret_cast<const char*>(&info);
+  BOOST_CHECK(infoAddr >= hostBegin && infoAddr < hostBegin + sizeof(host));
+
+  DummyStrategyInfoLarge& large = host.getOrCreateStrategyInfo<DummyStrategyInfoLarge>(8251);
+  const char* largeAddr = reinterpret_cast<const char*>(&large);
+  BOOST_CHECK(largeAddr < hostBegin || largeAddr >= hostBegin + sizeof(host));
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 2);
+
+  // items follow the host when it is moved
+  StrategyInfoHost host2(std::move(host));
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfoLarge>() == nullptr);
+  BOOST_REQUIRE(host2.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host2.getStrategyInfo<DummyStrategyInfo>()->m_id, 5117);
+  BOOST_CHECK_EQUAL(host2.getStrategyInfo<DummyStrategyInfoLarge>(), &large);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 2);
+
+  StrategyInfoHost host3;
+  host3.getOrCreateStrategyInfo<DummyStrategyInfo>(3390);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 3);
+  host3 = std::move(host2);
+  BOOST_CHECK(host2.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_REQUIRE(host3.getStrategyInfo<DummyStrategyInfo>() != nullptr);
+  BOOST_CHECK_EQUAL(host3.getStrategyInfo<DummyStrategyInfo>()->m_id, 5117);
+  BOOST_CHECK_EQUAL(host3.getStrategyInfo<DummyStrategyInfoLarge>(), &large);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 2);
+
+  host3.clearStrategyInfo();
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+}
+
+template<int TYPE_ID>
+class DummyStrategyInfoN : public StrategyInfo
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return TYPE_ID;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(Overflow)
+{
+  StrategyInfoHost host;
+  BOOST_REQUIRE_EQUAL(StrategyInfoHost::N_SLOTS, 3);
+
+  host.getOrCreateStrategyInfo<DummyStrategyInfoN<11>>();
+  host.getOrCreateStrategyInfo<DummyStrategyInfoN<12>>();
+  host.getOrCreateStrategyInfo<DummyStrategyInfoN<13>>();
+  g_DummyStrategyInfo_count = 0;
+  DummyStrategyInfo& info = host.getOrCreateStrategyInfo<DummyStrategyInfo>(4711);
+  DummyStrategyInfoN<15>& info15 = host.getOrCreateStrategyInfo<DummyStrategyInfoN<15>>();
+  host.getOrCreateStrategyInfo<DummyStrategyInfoN<16>>();
+
+  // items in the overflow list are found, and keep their addresses as the list grows
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfoN<11>>() != nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfoN<12>>() != nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfoN<13>>() != nullptr);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>(), &info);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfoN<15>>(), &info15);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfoN<16>>() != nullptr);
+  BOOST_CHECK_EQUAL(&host.getOrCreateStrategyInfo<DummyStrategyInfo>(2305), &info);
+  BOOST_CHECK_EQUAL(info.m_id, 4711);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 1);
+
+  // erase from the overflow list
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), true);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), false);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfoN<15>>(), &info15);
+
+  // an erased slot is reused before the overflow list
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfoN<12>>(), true);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfoN<12>>() == nullptr);
+  host.getOrCreateStrategyInfo<DummyStrategyInfoN<14>>();
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfoN<14>>() != nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfoN<16>>() != nullptr);
+
+  host.getOrCreateStrategyInfo<DummyStrategyInfo>(6012);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 1);
+  host.clearStrategyInfo();
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfoN<11>>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfoN<15>>() == nullptr);
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
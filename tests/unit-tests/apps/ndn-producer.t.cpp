@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-producer.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ProducerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  ProducerFixture()
+  {
+    createTopology({
+        {"1", "2"},
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "9.99s"},
+        {"2", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::Producer/"
+                                  "TransmittedDatas",
+                                  MakeCallback(&ProducerFixture::onData, this));
+  }
+
+  void
+  onData(shared_ptr<const Data> data, Ptr<App>, shared_ptr<Face>)
+  {
+    datas.push_back(data);
+  }
+
+  void
+  setAttributes()
+  {
+    Config::Set("/NodeList/*/ApplicationList/*/$ns3::ndn::Producer/PayloadSize",
+                UintegerValue(100));
+    Config::Set("/NodeList/*/ApplicationList/*/$ns3::ndn::Producer/Freshness",
+                TimeValue(Seconds(2)));
+    Config::Set("/NodeList/*/ApplicationList/*/$ns3::ndn::Producer/KeyLocator",
+                NameValue("/producer/KEY"));
+  }
+
+public:
+  std::vector<shared_ptr<const Data>> datas;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnProducer, ProducerFixture)
+
+BOOST_AUTO_TEST_CASE(SetAttributesWhileRunning)
+{
+  Simulator::Schedule(Seconds(5.0), &ProducerFixture::setAttributes, this);
+
+  Simulator::Stop(Seconds(10.0));
+  Simulator::Run();
+
+  BOOST_REQUIRE_GT(datas.size(), 90);
+
+  const Data& first = *datas.front();
+  BOOST_CHECK_EQUAL(first.getContent().value_size(), 1024);
+  BOOST_CHECK_EQUAL(first.getFreshnessPeriod(), ::ndn::time::milliseconds(0));
+  BOOST_CHECK(!first.getSignature().hasKeyLocator());
+
+  const Data& last = *datas.back();
+  BOOST_CHECK_EQUAL(last.getContent().value_size(), 100);
+  BOOST_CHECK_EQUAL(last.getFreshnessPeriod(), ::ndn::time::seconds(2));
+  BOOST_REQUIRE(last.getSignature().hasKeyLocator());
+  BOOST_CHECK_EQUAL(last.getSignature().getKeyLocator().getName(), Name("/producer/KEY"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
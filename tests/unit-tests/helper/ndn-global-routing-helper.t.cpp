@@ -146,6 +146,59 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+// Routes installed on a grid, which has many equal-cost paths, must not depend on thread count
+BOOST_AUTO_TEST_CASE(CalculateRoutesInParallel)
+{
+  typedef std::set<std::tuple<uint32_t, Name, nfd::FaceId, uint64_t>> FibSnapshot;
+
+  auto calculate = [] (uint32_t nThreads, bool isAllPossible) {
+    PointToPointHelper p2p;
+    PointToPointGridHelper grid(4, 4, p2p);
+
+    ndn::StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+    ndnGlobalRoutingHelper.InstallAll();
+    ndnGlobalRoutingHelper.AddOrigins("/prefix/A", grid.GetNode(0, 0));
+    ndnGlobalRoutingHelper.AddOrigins("/prefix/B", grid.GetNode(3, 2));
+
+    GlobalValue::Bind("NdnGlobalRoutingThreads", UintegerValue(nThreads));
+    if (isAllPossible) {
+      ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+    }
+    else {
+      ndn::GlobalRoutingHelper::CalculateRoutes();
+    }
+    GlobalValue::Bind("NdnGlobalRoutingThreads", UintegerValue(1));
+
+    FibSnapshot fibs;
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      auto ndn = (*node)->GetObject<ndn::L3Protocol>();
+      for (const auto& entry : ndn->getForwarder()->getFib()) {
+        for (const auto& nextHop : entry.getNextHops()) {
+          fibs.insert(std::make_tuple((*node)->GetId(), entry.getPrefix(),
+                                      nextHop.getFace()->getId(), nextHop.getCost()));
+        }
+      }
+    }
+
+    Simulator::Destroy();
+    GlobalRouter::clear();
+    return fibs;
+  };
+
+  FibSnapshot serial = calculate(1, false);
+  FibSnapshot parallel = calculate(4, false);
+  BOOST_CHECK_GE(serial.size(), 2 * 15);
+  BOOST_CHECK(serial == parallel);
+
+  FibSnapshot serialAllPossible = calculate(1, true);
+  FibSnapshot parallelAllPossible = calculate(4, true);
+  BOOST_CHECK_GT(serialAllPossible.size(), serial.size());
+  BOOST_CHECK(serialAllPossible == parallelAllPossible);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-partition-helper.hpp"
+
+#include "helper/ndn-stack-helper.hpp"
+#include "utils/topology/annotated-topology-reader.hpp"
+#include "utils/tracers/ndn-l3-rate-tracer.hpp"
+
+#include "ns3/names.h"
+
+#include "../tests-common.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_PARTITION_TOPO_TXT =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "partition-topo.txt";
+const boost::filesystem::path TEST_PARTITION_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "partition-trace.txt";
+
+class PartitionHelperFixture : public CleanupFixture
+{
+public:
+  PartitionHelperFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~PartitionHelperFixture()
+  {
+    L3RateTracer::Destroy();
+    boost::filesystem::remove(TEST_PARTITION_TOPO_TXT);
+    boost::filesystem::remove(TEST_PARTITION_TRACE);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnPartitionHelper, PartitionHelperFixture)
+
+BOOST_AUTO_TEST_CASE(KeepLowDelayLinks)
+{
+  // two triangles of 1-2ms links connected by two long links
+  PartitionHelper helper;
+  helper.AddLink("a1", "a2", MilliSeconds(1));
+  helper.AddLink("a2", "a3", MilliSeconds(1));
+  helper.AddLink("a3", "a1", MilliSeconds(2));
+  helper.AddLink("b1", "b2", MilliSeconds(1));
+  helper.AddLink("b2", "b3", MilliSeconds(2));
+  helper.AddLink("b3", "b1", MilliSeconds(2));
+  helper.AddLink("a3", "b1", MilliSeconds(50));
+  helper.AddLink("a1", "b3", MilliSeconds(30));
+  helper.AddNode("a2");
+
+  helper.Partition(2);
+  BOOST_CHECK_EQUAL(helper.GetSystemId("a1"), helper.GetSystemId("a2"));
+  BOOST_CHECK_EQUAL(helper.GetSystemId("a1"), helper.GetSystemId("a3"));
+  BOOST_CHECK_EQUAL(helper.GetSystemId("b1"), helper.GetSystemId("b2"));
+  BOOST_CHECK_EQUAL(helper.GetSystemId("b1"), helper.GetSystemId("b3"));
+  BOOST_CHECK_NE(helper.GetSystemId("a1"), helper.GetSystemId("b1"));
+  BOOST_CHECK_EQUAL(helper.GetLookahead(), MilliSeconds(30));
+
+  helper.Partition(1);
+  BOOST_CHECK_EQUAL(helper.GetSystemId("b3"), 0);
+  BOOST_CHECK_EQUAL(helper.GetLookahead(), Time::Max());
+}
+
+BOOST_AUTO_TEST_CASE(Balance)
+{
+  // 10x10 grid with varying link delays
+  PartitionHelper helper;
+  auto nodeName = [] (int i, int j) { return std::to_string(i) + "-" + std::to_string(j); };
+  for (int i = 0; i < 10; ++i) {
+    for (int j = 0; j < 10; ++j) {
+      if (i + 1 < 10) {
+        helper.AddLink(nodeName(i, j), nodeName(i + 1, j), MilliSeconds(1 + (i * 7 + j * 3) % 10));
+      }
+      if (j + 1 < 10) {
+        helper.AddLink(nodeName(i, j), nodeName(i, j + 1), MilliSeconds(1 + (i * 3 + j * 5) % 10));
+      }
+    }
+  }
+
+  helper.SetSlack(0.1);
+  helper.Partition(4);
+
+  std::vector<int> load(4, 0);
+  for (int i = 0; i < 10; ++i) {
+    for (int j = 0; j < 10; ++j) {
+      uint32_t systemId = helper.GetSystemId(nodeName(i, j));
+      BOOST_REQUIRE_LT(systemId, 4);
+      ++load[systemId];
+    }
+  }
+  for (int nNodes : load) {
+    BOOST_CHECK_LE(nNodes, 28);
+    BOOST_CHECK_GT(nNodes, 0);
+  }
+  BOOST_CHECK_GT(helper.GetLookahead(), MilliSeconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(PartitionedTopology)
+{
+  // mpi-partition column is ignored when the reader partitions the topology
+  std::ofstream topo(TEST_PARTITION_TOPO_TXT.string().c_str());
+  topo << "router\n\n"
+       << "#node city  y x mpi-partition\n"
+       << "a1  NA  0 0 0\n"
+       << "a2  NA  0 0 0\n"
+       << "a3  NA  0 0 0\n"
+       << "b1  NA  0 0 0\n"
+       << "b2  NA  0 0 0\n"
+       << "b3  NA  0 0 0\n\n"
+       << "link\n\n"
+       << "# from  to  capacity  metric  delay queue\n"
+       << "a1      a2  10Mbps    1 1ms 100\n"
+       << "a2      a3  10Mbps    1 1ms 100\n"
+       << "a3      a1  10Mbps    1 2ms 100\n"
+       << "b1      b2  10Mbps    1 1ms 100\n"
+       << "b2      b3  10Mbps    1 2ms 100\n"
+       << "b3      b1  10Mbps    1 2ms 100\n"
+       << "a3      b1  10Mbps    1 50ms 100\n";
+  topo.close();
+
+  AnnotatedTopologyReader reader("");
+  reader.SetFileName(TEST_PARTITION_TOPO_TXT.string());
+  reader.SetNPartitions(2);
+  NodeContainer nodes = reader.Read();
+  BOOST_REQUIRE_EQUAL(nodes.GetN(), 6);
+
+  auto systemId = [] (const std::string& name) { return Names::Find<Node>(name)->GetSystemId(); };
+  BOOST_CHECK_EQUAL(systemId("a1"), systemId("a2"));
+  BOOST_CHECK_EQUAL(systemId("a1"), systemId("a3"));
+  BOOST_CHECK_EQUAL(systemId("b1"), systemId("b2"));
+  BOOST_CHECK_EQUAL(systemId("b1"), systemId("b3"));
+  BOOST_CHECK_EQUAL(systemId("a1") + systemId("b1"), 1);
+
+  // without MPI this process simulates both partitions, so every node is traced into one file
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    BOOST_CHECK(PartitionHelper::IsLocal(*node));
+  }
+
+  L3RateTracer::InstallAll(TEST_PARTITION_TRACE.string(), Seconds(0.5));
+  Simulator::Stop(Seconds(0.6));
+  Simulator::Run();
+  L3RateTracer::Destroy(); // to force log to be written
+
+  std::ifstream trace(TEST_PARTITION_TRACE.string().c_str());
+  BOOST_REQUIRE(trace.is_open());
+  std::string line;
+  std::getline(trace, line); // header
+  std::set<std::string> tracedNodes;
+  while (std::getline(trace, line)) {
+    std::istringstream fields(line);
+    std::string time, node;
+    fields >> time >> node;
+    tracedNodes.insert(node);
+  }
+  BOOST_CHECK_EQUAL(tracedNodes.size(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(SinglePartitionFileName)
+{
+  // without MPI the simulation is a single partition and file names are unchanged
+  BOOST_CHECK_EQUAL(PartitionHelper::GetNSystems(), 1);
+  BOOST_CHECK_EQUAL(PartitionHelper::GetLocalSystemId(), 0);
+  BOOST_CHECK_EQUAL(PartitionHelper::GetPartitionFileName("rate-trace.txt"), "rate-trace.txt");
+  BOOST_CHECK_EQUAL(PartitionHelper::GetPartitionFileName("-"), "-");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
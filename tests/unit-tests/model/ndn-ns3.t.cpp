@@ -21,6 +21,7 @@
 #include "helper/ndn-stack-helper.hpp"
 #include "model/ndn-header.hpp"
 #include "utils/ndn-ns3-packet-tag.hpp"
+#include "utils/ndn-fw-hop-count-tag.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
@@ -54,6 +55,55 @@ BOOST_AUTO_TEST_CASE(ToPacket)
   BOOST_CHECK_EQUAL(type2, ::ndn::tlv::Data);
 }
 
+BOOST_AUTO_TEST_CASE(FromPacket)
+{
+  auto interest = make_shared<ndn::Interest>("/prefix");
+  interest->setNonce(1);
+  Ptr<Packet> interestPacket = Convert::ToPacket(*interest);
+  BOOST_CHECK_EQUAL(interestPacket->GetSize(), interest->wireEncode().size());
+
+  shared_ptr<const ndn::Interest> decodedInterest = Convert::FromPacket<ndn::Interest>(interestPacket);
+  BOOST_CHECK_EQUAL(*decodedInterest, *interest);
+  // the received packet is left unchanged
+  BOOST_CHECK_EQUAL(interestPacket->GetSize(), interest->wireEncode().size());
+
+  // 1024-octet Content makes TLV-LENGTH of Data a 3-octet VAR-NUMBER
+  auto data = make_shared<ndn::Data>(interest->getName());
+  data->setContent(make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(*data);
+  Ptr<Packet> dataPacket = Convert::ToPacket(*data);
+  BOOST_CHECK_EQUAL(dataPacket->GetSize(), data->wireEncode().size());
+
+  shared_ptr<const ndn::Data> decodedData = Convert::FromPacket<ndn::Data>(dataPacket);
+  BOOST_CHECK_EQUAL(*decodedData, *data);
+  BOOST_CHECK_EQUAL(dataPacket->GetSize(), data->wireEncode().size());
+
+  const Block& wire = data->wireEncode();
+  Ptr<Packet> truncatedPacket = Create<Packet>(wire.wire(), wire.size() - 1);
+  BOOST_CHECK_THROW(Convert::FromPacket<ndn::Data>(truncatedPacket), ::ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ForwardReceivedPacket)
+{
+  auto interest = make_shared<ndn::Interest>("/prefix");
+  interest->setNonce(1);
+  Ptr<Packet> received = Convert::ToPacket(*interest);
+  FwHopCountTag hopCountTag;
+  hopCountTag.Increment();
+  received->AddPacketTag(hopCountTag);
+
+  // ToPacket of a decoded packet keeps the ns-3 tags of the received packet,
+  // and replaces its NDN header instead of adding another one
+  shared_ptr<const ndn::Interest> decodedInterest = Convert::FromPacket<ndn::Interest>(received);
+  Ptr<Packet> forwarded = Convert::ToPacket(*decodedInterest);
+  BOOST_CHECK_EQUAL(forwarded->GetSize(), interest->wireEncode().size());
+  BOOST_CHECK_EQUAL(*Convert::FromPacket<ndn::Interest>(forwarded), *interest);
+
+  FwHopCountTag forwardedTag;
+  BOOST_REQUIRE(forwarded->PeekPacketTag(forwardedTag));
+  BOOST_CHECK_EQUAL(forwardedTag.Get(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
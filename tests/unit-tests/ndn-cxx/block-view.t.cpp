@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/encoding/block-view.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Block;
+using ::ndn::BlockView;
+namespace tlv = ::ndn::tlv;
+
+BOOST_AUTO_TEST_SUITE(NdnCxxBlockView)
+
+static const uint8_t WIRE[] = {
+  0x05, 0x10, // Interest
+        0x07, 0x05, // Name
+              0x08, 0x03, 0x6e, 0x64, 0x6e, // NameComponent "ndn"
+        0x0a, 0x04, // Nonce
+              0x01, 0x02, 0x03, 0x04,
+        0x0c, 0x01, // InterestLifetime
+              0x64,
+  0xff // trailing octet outside of the element
+};
+
+BOOST_AUTO_TEST_CASE(Parse)
+{
+  BlockView view(WIRE, WIRE + sizeof(WIRE));
+  BOOST_CHECK(!view.empty());
+  BOOST_CHECK_EQUAL(view.type(), tlv::Interest);
+  BOOST_CHECK(view.wire() == WIRE);
+  BOOST_CHECK_EQUAL(view.size(), 18);
+  BOOST_CHECK(view.value() == WIRE + 2);
+  BOOST_CHECK_EQUAL(view.value_size(), 16);
+
+  BOOST_CHECK(BlockView().empty());
+
+  BOOST_CHECK_THROW(BlockView(WIRE, WIRE + 17), tlv::Error);
+  BOOST_CHECK_THROW(BlockView(WIRE, WIRE + 1), tlv::Error);
+  BOOST_CHECK_THROW(BlockView(WIRE, WIRE), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Iterate)
+{
+  BlockView view(WIRE, WIRE + sizeof(WIRE));
+
+  std::vector<uint32_t> types;
+  for (const BlockView& element : view) {
+    types.push_back(element.type());
+  }
+  std::vector<uint32_t> expected = {tlv::Name, tlv::Nonce, tlv::InterestLifetime};
+  BOOST_CHECK_EQUAL_COLLECTIONS(types.begin(), types.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(view.elements_size(), 3);
+
+  BlockView name = view.get(tlv::Name);
+  BOOST_CHECK(name.wire() == WIRE + 2);
+  BOOST_CHECK_EQUAL(name.size(), 7);
+  BOOST_CHECK_EQUAL(name.elements_size(), 1);
+  BOOST_CHECK_EQUAL(name.begin()->value_size(), 3);
+
+  BlockView lifetime = view.get(tlv::InterestLifetime);
+  BOOST_CHECK_EQUAL(lifetime.value_size(), 1);
+  BOOST_CHECK_EQUAL(*lifetime.value(), 0x64);
+
+  BOOST_CHECK(view.find(tlv::Selectors) == view.end());
+  BOOST_CHECK_THROW(view.get(tlv::Selectors), BlockView::Error);
+
+  // the value of a NameComponent is not a sequence of TLV elements
+  BlockView component = *name.begin();
+  BOOST_CHECK_THROW(component.elements_size(), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(FromBlock)
+{
+  Block block(WIRE, sizeof(WIRE));
+  BlockView view(block);
+  BOOST_CHECK_EQUAL(view.type(), block.type());
+  BOOST_CHECK(view.wire() == block.wire());
+  BOOST_CHECK_EQUAL(view.size(), block.size());
+  BOOST_CHECK_EQUAL(view.value_size(), block.value_size());
+
+  // a Block created from a sub element shares the buffer of the block
+  Block nonce(block, view.get(tlv::Nonce));
+  BOOST_CHECK_EQUAL(nonce.type(), tlv::Nonce);
+  BOOST_CHECK(nonce.getBuffer() == block.getBuffer());
+  BOOST_CHECK(nonce.wire() == block.wire() + 9);
+  BOOST_CHECK_EQUAL(nonce.size(), 6);
+  BOOST_CHECK_EQUAL(nonce.value_size(), 4);
+  BOOST_CHECK_EQUAL(nonce.value()[0], 0x01);
+
+  block.parse();
+  BOOST_CHECK(nonce == block.get(tlv::Nonce));
+}
+
+BOOST_AUTO_TEST_CASE(ParseMalformed)
+{
+  static const uint8_t MALFORMED[] = {
+    0x05, 0x06,
+          0x07, 0x00,
+          0x0a, 0x04, 0x01, 0x02 // Nonce exceeds the Interest
+  };
+  Block block(MALFORMED, sizeof(MALFORMED));
+  BOOST_CHECK_THROW(block.parse(), tlv::Error);
+  BOOST_CHECK_EQUAL(block.elements_size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
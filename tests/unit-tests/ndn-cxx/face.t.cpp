@@ -22,6 +22,8 @@
 #include <ndn-cxx/util/scheduler-scoped-event-id.hpp>
 
 #include "ns3/ndnSIM/helper/ndn-app-helper.hpp"
+#include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
@@ -263,6 +265,59 @@ BOOST_AUTO_TEST_CASE(ExpressMultipleInterests)
   BOOST_CHECK_EQUAL(recvCount, 10);
 }
 
+class WindowOfInterests : public BaseTesterApp
+{
+public:
+  WindowOfInterests(const Name& name, size_t nInterests, const NameCallback& onData,
+                    const VoidCallback& onTimeout)
+  {
+    for (size_t seqNo = 0; seqNo < nInterests; ++seqNo) {
+      auto id = m_face.expressInterest(Name(name).appendSegment(seqNo), std::bind([=] (const Data& data) {
+            onData(data.getName());
+          }, _2),
+        std::bind(onTimeout));
+
+      // every other Interest is withdrawn before it is satisfied
+      if (seqNo % 2 == 1) {
+        m_face.removePendingInterest(id);
+      }
+    }
+  }
+
+  size_t
+  getNPendingInterests() const
+  {
+    return m_face.getNPendingInterests();
+  }
+};
+
+BOOST_AUTO_TEST_CASE(ExpressWindowOfInterests)
+{
+  addApps({{"B", "ns3::ndn::Producer", {{"Prefix", "/test"}}, "0s", "100s"}});
+
+  std::set<Name> received;
+  shared_ptr<WindowOfInterests> app;
+
+  FactoryCallbackApp::Install(getNode("A"), [&] () -> shared_ptr<void> {
+      app = make_shared<WindowOfInterests>("/test/prefix", 20, [&] (const Name& data) {
+          BOOST_CHECK(received.insert(data).second);
+        },
+        [] {
+          BOOST_ERROR("Unexpected timeout");
+        });
+      return app;
+    })
+    .Start(Seconds(1.01));
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(received.size(), 10);
+  BOOST_CHECK(received.count(Name("/test/prefix").appendSegment(18)) > 0);
+  BOOST_REQUIRE(app != nullptr);
+  BOOST_CHECK_EQUAL(app->getNPendingInterests(), 0);
+}
+
 class SingleInterestWithFaceShutdown : public BaseTesterApp
 {
 public:
@@ -291,6 +346,184 @@ BOOST_AUTO_TEST_CASE(FaceShutdownFromTimeoutCallback)
   Simulator::Run();
 }
 
+/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+
+class DeliveryTester
+{
+public:
+  typedef BaseTesterApp::NameCallback NameCallback;
+
+  DeliveryTester(size_t nInterests, const NameCallback& onPacket)
+    : m_face(new ::ndn::Face)
+  {
+    m_face->setInterestFilter("/burst", std::bind([onPacket] (const Interest& interest) {
+          onPacket(interest.getName());
+        }, _2));
+
+    for (size_t seqNo = 0; seqNo < nInterests; ++seqNo) {
+      m_face->expressInterest(Name("/burst/data").appendSegment(seqNo),
+                              std::bind([onPacket] (const Data& data) {
+                                  onPacket(data.getName());
+                                }, _2),
+                              std::bind([] {
+                                  BOOST_ERROR("Unexpected timeout");
+                                }));
+    }
+  }
+
+  void
+  destroyFace()
+  {
+    m_face.reset();
+  }
+
+private:
+  std::unique_ptr< ::ndn::Face> m_face;
+};
+
+/**
+ * @brief Fixture that hands packets to the app face on node A, as the forwarder would
+ */
+class DeliveryFixture : public NndCxxFaceFixture
+{
+public:
+  void
+  installTester(size_t nInterests)
+  {
+    FactoryCallbackApp::Install(getNode("A"), [=] () -> shared_ptr<void> {
+        tester = make_shared<DeliveryTester>(nInterests, [=] (const Name& name) {
+            delivered.push_back(name);
+            deliveryTimes.push_back(Simulator::Now());
+            if (onDelivery) {
+              onDelivery(name);
+            }
+          });
+        return tester;
+      })
+      .Start(Seconds(1.0));
+  }
+
+  /**
+   * @brief Get the forwarder side of the last ndn::Face created on node A
+   */
+  shared_ptr<Face>
+  getAppFace()
+  {
+    shared_ptr<Face> appFace;
+    for (const auto& face : getNode("A")->GetObject<L3Protocol>()->getForwarder()->getFaceTable()) {
+      if (face->getRemoteUri().getScheme() == "ndnFace") {
+        appFace = face;
+      }
+    }
+    BOOST_REQUIRE(appFace != nullptr);
+    return appFace;
+  }
+
+  /**
+   * @brief Send Interests and Data to the app face, alternating between the two
+   */
+  void
+  sendBurst(size_t nInterests, size_t nDatas)
+  {
+    shared_ptr<Face> face = getAppFace();
+    for (size_t seqNo = 0; seqNo < std::max(nInterests, nDatas); ++seqNo) {
+      if (seqNo < nInterests) {
+        face->sendInterest(*make_shared<Interest>(Name("/burst/interest").appendSegment(seqNo)));
+      }
+      if (seqNo < nDatas) {
+        sendData(seqNo);
+      }
+    }
+  }
+
+  void
+  sendData(size_t seqNo)
+  {
+    auto data = make_shared<Data>(Name("/burst/data").appendSegment(seqNo));
+    StackHelper::getKeyChain().sign(*data);
+    getAppFace()->sendData(*data);
+  }
+
+  void
+  markNextEvent()
+  {
+    delivered.push_back("/next-event");
+  }
+
+  void
+  sendBurstAndDestroyFace()
+  {
+    sendBurst(2, 2);
+    tester->destroyFace();
+  }
+
+protected:
+  shared_ptr<DeliveryTester> tester;
+  std::vector<Name> delivered;
+  std::vector<Time> deliveryTimes;
+  std::function<void(const Name&)> onDelivery;
+};
+
+BOOST_FIXTURE_TEST_CASE(DeliveryOrder, DeliveryFixture)
+{
+  installTester(3);
+  Simulator::Schedule(Seconds(1.5), &DeliveryFixture::sendBurst, this, 3, 3);
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  // Interests and Data are delivered in the order the forwarder sent them, all at once
+  std::vector<Name> expected{Name("/burst/interest").appendSegment(0),
+                             Name("/burst/data").appendSegment(0),
+                             Name("/burst/interest").appendSegment(1),
+                             Name("/burst/data").appendSegment(1),
+                             Name("/burst/interest").appendSegment(2),
+                             Name("/burst/data").appendSegment(2)};
+  BOOST_CHECK_EQUAL_COLLECTIONS(delivered.begin(), delivered.end(),
+                                expected.begin(), expected.end());
+  for (const Time& time : deliveryTimes) {
+    BOOST_CHECK_EQUAL(time, Seconds(1.5));
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(SendFromDeliveryCallback, DeliveryFixture)
+{
+  installTester(1);
+  onDelivery = [this] (const Name& name) {
+    if (name == Name("/burst/interest").appendSegment(0)) {
+      // the simulator runs events of the same time in the order they were scheduled
+      Simulator::ScheduleNow(&DeliveryFixture::markNextEvent, this);
+      sendData(0);
+    }
+  };
+  Simulator::Schedule(Seconds(1.5), &DeliveryFixture::sendBurst, this, 2, 0);
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  // Data sent while the burst is delivered waits for the rest of the burst, and for an event
+  // scheduled before it was sent
+  std::vector<Name> expected{Name("/burst/interest").appendSegment(0),
+                             Name("/burst/interest").appendSegment(1),
+                             Name("/next-event"),
+                             Name("/burst/data").appendSegment(0)};
+  BOOST_CHECK_EQUAL_COLLECTIONS(delivered.begin(), delivered.end(),
+                                expected.begin(), expected.end());
+}
+
+BOOST_FIXTURE_TEST_CASE(DestroyFaceWithPendingDelivery, DeliveryFixture)
+{
+  installTester(2);
+  Simulator::Schedule(Seconds(1.5), &DeliveryFixture::sendBurstAndDestroyFace, this);
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(delivered.size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
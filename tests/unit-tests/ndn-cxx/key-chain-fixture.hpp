@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_TESTS_UNIT_TESTS_NDN_CXX_KEY_CHAIN_FIXTURE_HPP
+#define NDNSIM_TESTS_UNIT_TESTS_NDN_CXX_KEY_CHAIN_FIXTURE_HPP
+
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_KEY_CHAIN_PATH = boost::filesystem::path(TEST_CONFIG_PATH) / "key-chain";
+
+/**
+ * @brief Fixture with a KeyChain that keeps real keys in a temporary directory
+ *
+ * StackHelper::getKeyChain() makes dummy signatures, which cannot be verified.
+ */
+class KeyChainFixture : public CleanupFixture
+{
+public:
+  KeyChainFixture()
+    : keyChain("pib-sqlite3:" + TEST_KEY_CHAIN_PATH.string(),
+               "tpm-file:" + TEST_KEY_CHAIN_PATH.string())
+  {
+  }
+
+  ~KeyChainFixture()
+  {
+    boost::filesystem::remove_all(TEST_KEY_CHAIN_PATH);
+  }
+
+  shared_ptr< ::ndn::PublicKey>
+  addIdentity(const Name& identity, const ::ndn::KeyParams& params = ::ndn::EcdsaKeyParams())
+  {
+    keyChain.createIdentity(identity, params);
+    return keyChain.getPublicKey(keyChain.getDefaultKeyNameForIdentity(identity));
+  }
+
+  shared_ptr<Data>
+  makeSignedData(const Name& name, const Name& identity)
+  {
+    auto data = make_shared<Data>(name);
+    keyChain.sign(*data, ::ndn::security::signingByIdentity(identity));
+    return data;
+  }
+
+protected:
+  KeyChain keyChain;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_TESTS_UNIT_TESTS_NDN_CXX_KEY_CHAIN_FIXTURE_HPP
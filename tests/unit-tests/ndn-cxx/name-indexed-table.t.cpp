@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/detail/name-indexed-table.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::NameIndexedTable;
+
+class RecordId;
+
+struct Record
+{
+  explicit
+  Record(const Name& name)
+    : name(name)
+  {
+  }
+
+  const RecordId*
+  getId() const
+  {
+    return reinterpret_cast<const RecordId*>(this);
+  }
+
+  Name name;
+};
+
+typedef NameIndexedTable<Record, RecordId> Table;
+
+class NameIndexedTableFixture
+{
+public:
+  shared_ptr<Record>
+  insert(const Name& name)
+  {
+    auto record = make_shared<Record>(name);
+    BOOST_CHECK(table.insert(name, record->getId(), record));
+    return record;
+  }
+
+  std::vector<Name>
+  findPrefixesOf(const Name& name)
+  {
+    std::vector<Name> found;
+    hasLonger = table.forEachPrefixOf(name, [&found] (const shared_ptr<Record>& record) {
+        found.push_back(record->name);
+      });
+    return found;
+  }
+
+  std::vector<Name>
+  findExact(const Name& name)
+  {
+    std::vector<Name> found;
+    table.forEachExact(name, [&found] (const shared_ptr<Record>& record) {
+        found.push_back(record->name);
+      });
+    return found;
+  }
+
+protected:
+  Table table;
+  bool hasLonger = false;
+};
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxNameIndexedTable, NameIndexedTableFixture)
+
+BOOST_AUTO_TEST_CASE(PrefixMatch)
+{
+  insert("/A/B/C");
+  insert("/A");
+  insert("/");
+  insert("/A/B");
+  insert("/A/D");
+  insert("/A");
+  BOOST_CHECK_EQUAL(table.size(), 6);
+
+  std::vector<Name> expected = {"/", "/A", "/A", "/A/B"};
+  BOOST_CHECK(findPrefixesOf("/A/B") == expected);
+  BOOST_CHECK(hasLonger);
+
+  expected = {"/", "/A", "/A", "/A/B", "/A/B/C"};
+  BOOST_CHECK(findPrefixesOf("/A/B/C/E") == expected);
+  BOOST_CHECK(!hasLonger);
+
+  expected = {"/"};
+  BOOST_CHECK(findPrefixesOf("/B") == expected);
+  BOOST_CHECK(!hasLonger);
+
+  expected = {"/A", "/A"};
+  BOOST_CHECK(findExact("/A") == expected);
+  BOOST_CHECK(findExact("/A/B/C/E").empty());
+  BOOST_CHECK(findExact("/A/C").empty());
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  auto abc = insert("/A/B/C");
+  auto ab = insert("/A/B");
+  auto ab2 = insert("/A/B");
+
+  BOOST_CHECK(!table.insert(ab->name, ab->getId(), ab));
+  BOOST_CHECK_EQUAL(table.size(), 3);
+
+  BOOST_CHECK(table.erase(ab->getId()));
+  BOOST_CHECK(!table.erase(ab->getId()));
+  std::vector<Name> expected = {"/A/B"};
+  BOOST_CHECK(findExact("/A/B") == expected);
+
+  // nodes without records are removed along with their empty ancestors
+  BOOST_CHECK(table.erase(abc->getId()));
+  findPrefixesOf("/A/B");
+  BOOST_CHECK(!hasLonger);
+  BOOST_CHECK(table.erase(ab2->getId()));
+  findPrefixesOf("/");
+  BOOST_CHECK(!hasLonger);
+  BOOST_CHECK(table.empty());
+
+  // the record stays alive while referenced elsewhere
+  BOOST_CHECK_EQUAL(ab.use_count(), 1);
+
+  insert("/A");
+  table.clear();
+  BOOST_CHECK(table.empty());
+  BOOST_CHECK(findPrefixesOf("/A").empty());
+}
+
+BOOST_AUTO_TEST_CASE(ManyChildren)
+{
+  // enough children under one node to rehash its child map several times
+  std::vector<shared_ptr<Record>> records;
+  for (int i = 0; i < 1000; ++i) {
+    records.push_back(insert(Name("/A").appendSegment(i)));
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    BOOST_CHECK(table.erase(records[i]->getId()));
+  }
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(findExact(Name("/A").appendSegment(i)).size(), i % 2);
+  }
+  for (int i = 1; i < 1000; i += 2) {
+    BOOST_CHECK(table.erase(records[i]->getId()));
+  }
+  findPrefixesOf("/");
+  BOOST_CHECK(!hasLonger);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
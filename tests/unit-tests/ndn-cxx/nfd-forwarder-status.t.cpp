@@ -0,0 +1,66 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/management/nfd-forwarder-status.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Block;
+using ::ndn::nfd::ForwarderStatus;
+
+BOOST_AUTO_TEST_SUITE(NdnCxxNfdForwarderStatus)
+
+BOOST_AUTO_TEST_CASE(Allocators)
+{
+  ForwarderStatus status1;
+  status1.setNfdVersion("0.3.4");
+  status1.addAllocator({"PitEntry", 384, 1000, 1024});
+  status1.addAllocator({"MeasurementsEntry", 112, 0, 32});
+
+  // AllocatorStatus elements follow the counters, keeping TLV-TYPEs in ascending order
+  Block wire = status1.wireEncode();
+  wire.parse();
+  std::vector<uint32_t> types;
+  for (const Block& element : wire.elements()) {
+    types.push_back(element.type());
+  }
+  BOOST_CHECK(std::is_sorted(types.begin(), types.end()));
+  BOOST_CHECK_EQUAL(std::count(types.begin(), types.end(), ::ndn::tlv::nfd::AllocatorStatus), 2);
+
+  ForwarderStatus status2(wire);
+  BOOST_REQUIRE_EQUAL(status2.getAllocators().size(), 2);
+  BOOST_CHECK_EQUAL(status2.getAllocators()[0].name, "PitEntry");
+  BOOST_CHECK_EQUAL(status2.getAllocators()[0].blockSize, 384);
+  BOOST_CHECK_EQUAL(status2.getAllocators()[0].nAllocatedBlocks, 1000);
+  BOOST_CHECK_EQUAL(status2.getAllocators()[0].nBlocks, 1024);
+  BOOST_CHECK_EQUAL(status2.getAllocators()[1].name, "MeasurementsEntry");
+  BOOST_CHECK_EQUAL(status2.getAllocators()[1].nBlocks, 32);
+
+  status2.clearAllocators();
+  ForwarderStatus status3(status2.wireEncode());
+  BOOST_CHECK(status3.getAllocators().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
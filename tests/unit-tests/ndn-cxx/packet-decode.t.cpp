@@ -0,0 +1,73 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/encoding/block-view.hpp>
+
+#include "../tests-common.hpp"
+#include "../../benchmarks/benchmark-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Block;
+using ::ndn::BlockView;
+namespace tlv = ::ndn::tlv;
+
+BOOST_AUTO_TEST_SUITE(NdnCxxPacketDecode)
+
+BOOST_AUTO_TEST_CASE(InterestDecode)
+{
+  Block wire = makeInterest(Name("/example/testApp/randomData/%FE%01")).wireEncode();
+
+  Interest interest;
+  interest.wireDecode(wire);
+  BOOST_CHECK_EQUAL(interest.getName(), Name("/example/testApp/randomData/%FE%01"));
+  BOOST_CHECK_EQUAL(interest.getNonce(), 0x12345678);
+  BOOST_CHECK(interest.getInterestLifetime() == time::seconds(2));
+  BOOST_CHECK_EQUAL(interest.getMustBeFresh(), true);
+  BOOST_CHECK(interest.wireEncode() == wire);
+
+  // decoded elements share the buffer of the wire, so that the Nonce is replaced in place
+  interest.setNonce(0x87654321);
+  BOOST_CHECK(interest.wireEncode().getBuffer() == wire.getBuffer());
+  BOOST_CHECK_EQUAL(Interest(wire).getNonce(), 0x87654321);
+
+  BOOST_CHECK_THROW(interest.wireDecode(Block(tlv::Interest, wire.getBuffer())), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(DataDecode)
+{
+  Block wire = makeData(Name("/example/testApp/randomData/%FE%01")).wireEncode();
+
+  Data data;
+  data.wireDecode(wire);
+  BOOST_CHECK_EQUAL(data.getName(), Name("/example/testApp/randomData/%FE%01"));
+  BOOST_CHECK(data.getFreshnessPeriod() == time::seconds(10));
+  BOOST_CHECK_EQUAL(data.getContent().value_size(), 1024);
+  BOOST_CHECK_EQUAL(data.getSignature().getType(), 255);
+  BOOST_CHECK(data.wireEncode() == wire);
+  BOOST_CHECK(data.getContent().getBuffer() == wire.getBuffer());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include "../tests-common.hpp"
+#include "../../benchmarks/benchmark-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Block;
+using ::ndn::EncodingBuffer;
+using ::ndn::EncodingEstimator;
+using ::ndn::MetaInfo;
+
+BOOST_AUTO_TEST_SUITE(NdnCxxPacketEncode)
+
+BOOST_AUTO_TEST_CASE(CachedName)
+{
+  Name name("/example/testApp");
+  Block fresh = name.wireEncode();
+
+  // an encoded Name is prepended as is
+  EncodingBuffer encoder;
+  BOOST_CHECK_EQUAL(name.wireEncode(encoder), fresh.size());
+  BOOST_CHECK(encoder.block() == fresh);
+
+  // a modified Name is encoded from its components
+  name.append("randomData");
+  EncodingEstimator estimator;
+  BOOST_CHECK_EQUAL(name.wireEncode(estimator), fresh.size() + 12);
+  EncodingBuffer encoder2;
+  name.wireEncode(encoder2);
+  BOOST_CHECK(encoder2.block() == Name("/example/testApp/randomData").wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(CachedMetaInfo)
+{
+  MetaInfo metaInfo;
+  metaInfo.setFreshnessPeriod(time::seconds(10));
+  Block fresh = metaInfo.wireEncode();
+
+  EncodingBuffer encoder;
+  BOOST_CHECK_EQUAL(metaInfo.wireEncode(encoder), fresh.size());
+  BOOST_CHECK(encoder.block() == fresh);
+
+  metaInfo.setFreshnessPeriod(time::seconds(1));
+  EncodingBuffer encoder2;
+  metaInfo.wireEncode(encoder2);
+  BOOST_CHECK(encoder2.block() != fresh);
+  BOOST_CHECK(MetaInfo(encoder2.block()).getFreshnessPeriod() == time::seconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(DataTemplate)
+{
+  Data dataTemplate = makeData(Name());
+  dataTemplate.getMetaInfo().wireEncode();
+  dataTemplate.getContent();
+
+  Name name("/example/testApp/randomData/%FE%01");
+  Data data(dataTemplate);
+  data.setName(name);
+  BOOST_CHECK(data.wireEncode() == makeData(name).wireEncode());
+
+  // the template is not affected by encoding its copies
+  BOOST_CHECK(!dataTemplate.hasWire());
+  BOOST_CHECK_EQUAL(dataTemplate.getName(), Name());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::util::scheduler::Scheduler;
+using ::ndn::util::scheduler::EventId;
+
+class SchedulerFixture : public CleanupFixture
+{
+public:
+  SchedulerFixture()
+    : scheduler(io)
+  {
+  }
+
+  Scheduler::Event
+  makeEvent(int id)
+  {
+    return [this, id] {
+      fired.push_back(std::make_pair(Simulator::Now().GetNanoSeconds(), id));
+    };
+  }
+
+protected:
+  boost::asio::io_service io;
+  Scheduler scheduler;
+  std::vector<std::pair<int64_t, int>> fired; // (time in ns, id)
+};
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxScheduler, SchedulerFixture)
+
+BOOST_AUTO_TEST_CASE(ExactTimeAndOrder)
+{
+  // delays within a level-0 slot, on slot boundaries, and at every level of the wheel
+  std::vector<int64_t> delays = {0, 1, 999999, 1048576, 1048577, 268435456, 300000000,
+                                 70000000000, 70000000000, 18000000000000, 0, 1048576};
+  std::vector<std::pair<int64_t, int>> expected;
+  for (size_t i = 0; i < delays.size(); ++i) {
+    scheduler.scheduleEvent(time::nanoseconds(delays[i]), makeEvent(i));
+    expected.push_back(std::make_pair(delays[i], i));
+  }
+  std::sort(expected.begin(), expected.end());
+
+  Simulator::Run();
+  BOOST_CHECK(fired == expected);
+}
+
+BOOST_AUTO_TEST_CASE(ScheduleFromEvent)
+{
+  // events scheduled while the simulation is running land in partially elapsed slots
+  scheduler.scheduleEvent(time::microseconds(1500), [this] {
+      scheduler.scheduleEvent(time::microseconds(100), makeEvent(1));
+      scheduler.scheduleEvent(time::seconds(3), makeEvent(3));
+      scheduler.scheduleEvent(time::microseconds(600), makeEvent(2));
+    });
+
+  Simulator::Run();
+  BOOST_REQUIRE_EQUAL(fired.size(), 3);
+  BOOST_CHECK_EQUAL(fired[0].first, 1600000);
+  BOOST_CHECK_EQUAL(fired[1].first, 2100000);
+  BOOST_CHECK_EQUAL(fired[2].first, 3001500000);
+}
+
+BOOST_AUTO_TEST_CASE(ScheduleAtSlotStart)
+{
+  // at the start of a slot, before the wheel has processed it, an event scheduled for now
+  // must still fire after the earlier events with the same expiry
+  Simulator::Schedule(NanoSeconds(1048576), [this] {
+      scheduler.scheduleEvent(time::nanoseconds(0), makeEvent(2));
+    });
+  scheduler.scheduleEvent(time::nanoseconds(1048576), makeEvent(1));
+
+  Simulator::Run();
+  std::vector<std::pair<int64_t, int>> expected = {{1048576, 1}, {1048576, 2}};
+  BOOST_CHECK(fired == expected);
+}
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  EventId inWheel = scheduler.scheduleEvent(time::seconds(10), makeEvent(1));
+  EventId dispatched = scheduler.scheduleEvent(time::nanoseconds(100), makeEvent(2));
+  EventId fromEvent = scheduler.scheduleEvent(time::seconds(2), makeEvent(3));
+  scheduler.scheduleEvent(time::seconds(1), [&] { scheduler.cancelEvent(fromEvent); });
+  EventId self;
+  self = scheduler.scheduleEvent(time::seconds(4), [&] { scheduler.cancelEvent(self); });
+
+  scheduler.cancelEvent(inWheel);
+  scheduler.cancelEvent(dispatched);
+  BOOST_CHECK(inWheel == nullptr);
+  BOOST_CHECK(dispatched == nullptr);
+
+  EventId empty;
+  scheduler.cancelEvent(empty);
+
+  Simulator::Run();
+  BOOST_CHECK(fired.empty());
+  BOOST_CHECK(self == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(CancelAll)
+{
+  scheduler.scheduleEvent(time::seconds(0), makeEvent(1));
+  scheduler.scheduleEvent(time::seconds(100), makeEvent(2));
+  scheduler.cancelAllEvents();
+  scheduler.scheduleEvent(time::seconds(1), makeEvent(3));
+
+  Simulator::Run();
+  BOOST_REQUIRE_EQUAL(fired.size(), 1);
+  BOOST_CHECK_EQUAL(fired[0].second, 3);
+}
+
+BOOST_AUTO_TEST_CASE(Destruction)
+{
+  int hit = 0;
+  {
+    Scheduler other(io);
+    other.scheduleEvent(time::nanoseconds(1), [&] { ++hit; });
+    other.scheduleEvent(time::seconds(5), [&] { ++hit; });
+  }
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(hit, 0);
+}
+
+BOOST_AUTO_TEST_CASE(SimulatorDestroy)
+{
+  scheduler.scheduleEvent(time::milliseconds(10), makeEvent(1));
+  scheduler.scheduleEvent(time::seconds(10), makeEvent(2));
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  Simulator::Destroy();
+
+  // the scheduler outlives the simulation and starts over with the next one
+  scheduler.scheduleEvent(time::milliseconds(1500), makeEvent(3));
+  Simulator::Run();
+  BOOST_REQUIRE_EQUAL(fired.size(), 2);
+  BOOST_CHECK_EQUAL(fired[0].second, 1);
+  BOOST_CHECK_EQUAL(fired[1].second, 3);
+  BOOST_CHECK_EQUAL(fired[1].first, 1500000000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
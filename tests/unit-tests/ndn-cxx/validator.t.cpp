@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/security/validator.hpp>
+#include <ndn-cxx/security/verification-key.hpp>
+
+#include "key-chain-fixture.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::PublicKey;
+using ::ndn::Validator;
+using ::ndn::VerificationKey;
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxValidator, KeyChainFixture)
+
+BOOST_AUTO_TEST_CASE(VerifySignatures)
+{
+  Name identity("/TestValidator/VerifySignatures");
+  shared_ptr<PublicKey> publicKey = addIdentity(identity);
+  Name badIdentity("/TestValidator/VerifySignatures/bad");
+  addIdentity(badIdentity);
+
+  // one packet is signed by another key
+  std::vector<shared_ptr<const Data>> packets;
+  for (int i = 0; i < 10; ++i) {
+    packets.push_back(makeSignedData(Name("/TestData").appendNumber(i),
+                                     i == 7 ? badIdentity : identity));
+  }
+
+  // 0 is the same as 1 thread, and more threads than packets are capped
+  for (size_t nThreads : {0, 1, 3, 20}) {
+    BOOST_TEST_MESSAGE("nThreads=" << nThreads);
+    std::vector<bool> isValid = Validator::verifySignatures(packets, *publicKey, nThreads);
+    BOOST_REQUIRE_EQUAL(isValid.size(), packets.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+      BOOST_CHECK_EQUAL(isValid[i], i != 7);
+    }
+  }
+
+  BOOST_CHECK(Validator::verifySignatures({}, *publicKey, 4).empty());
+}
+
+BOOST_AUTO_TEST_CASE(VerifyWithDecodedKey)
+{
+  Name identity("/TestValidator/VerifyWithDecodedKey");
+  shared_ptr<PublicKey> publicKey = addIdentity(identity);
+  Name otherIdentity("/TestValidator/VerifyWithDecodedKey/other");
+  addIdentity(otherIdentity);
+  shared_ptr<Data> data = makeSignedData("/TestData/1", identity);
+  shared_ptr<Data> otherData = makeSignedData("/TestData/2", otherIdentity);
+
+  VerificationKey key(*publicKey);
+  BOOST_CHECK_EQUAL(key.getKeyType(), ::ndn::KEY_TYPE_ECDSA);
+  BOOST_CHECK_EQUAL(Validator::verifySignature(*data, key), true);
+  BOOST_CHECK_EQUAL(Validator::verifySignature(*otherData, key), false);
+
+  VerificationKey invalidKey((PublicKey()));
+  BOOST_CHECK_EQUAL(Validator::verifySignature(*data, invalidKey), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/security/verified-key-cache.hpp>
+
+#include "key-chain-fixture.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::PublicKey;
+using ::ndn::VerificationKey;
+using ::ndn::VerifiedKeyCache;
+
+BOOST_FIXTURE_TEST_SUITE(NdnCxxVerifiedKeyCache, KeyChainFixture)
+
+BOOST_AUTO_TEST_CASE(HitAndReplace)
+{
+  shared_ptr<PublicKey> key1 = addIdentity("/TestVerifiedKeyCache/HitAndReplace/id1");
+  shared_ptr<PublicKey> key2 = addIdentity("/TestVerifiedKeyCache/HitAndReplace/id2");
+  KeyLocator locator(Name("/TestVerifiedKeyCache/HitAndReplace/id1/KEY"));
+
+  VerifiedKeyCache cache;
+  BOOST_CHECK(cache.find(locator) == nullptr);
+
+  shared_ptr<const VerificationKey> decoded = cache.get(locator, *key1);
+  BOOST_REQUIRE(decoded != nullptr);
+  BOOST_CHECK(decoded->getPublicKey() == *key1);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  // an equal KeyLocator with the same key is a hit, and the key is not decoded again
+  BOOST_CHECK_EQUAL(cache.get(KeyLocator(locator.getName()), *key1), decoded);
+  BOOST_CHECK_EQUAL(cache.find(locator), decoded);
+
+  // a different key for the same KeyLocator replaces the cached one
+  shared_ptr<const VerificationKey> decoded2 = cache.get(locator, *key2);
+  BOOST_REQUIRE(decoded2 != nullptr);
+  BOOST_CHECK(decoded2 != decoded);
+  BOOST_CHECK(decoded2->getPublicKey() == *key2);
+  BOOST_CHECK_EQUAL(cache.find(locator), decoded2);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  cache.erase(locator);
+  BOOST_CHECK(cache.find(locator) == nullptr);
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Evict)
+{
+  shared_ptr<PublicKey> key = addIdentity("/TestVerifiedKeyCache/Evict");
+  KeyLocator locator1(Name("/A/KEY"));
+  KeyLocator locator2(Name("/B/KEY"));
+  KeyLocator locator3(Name("/C/KEY"));
+
+  VerifiedKeyCache cache(2);
+  BOOST_CHECK_EQUAL(cache.getCapacity(), 2);
+  shared_ptr<const VerificationKey> decoded1 = cache.get(locator1, *key);
+  cache.get(locator2, *key);
+  BOOST_CHECK_EQUAL(cache.find(locator1), decoded1);
+
+  // locator2 is the least recently used
+  cache.get(locator3, *key);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK_EQUAL(cache.find(locator1), decoded1);
+  BOOST_CHECK(cache.find(locator2) == nullptr);
+  BOOST_CHECK(cache.find(locator3) != nullptr);
+
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+  BOOST_CHECK(cache.find(locator1) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -97,6 +97,53 @@ BOOST_AUTO_TEST_CASE(InstallAll)
     "3.02087	2	0	1	FullDelay	0.0208712	20871.2	1	1\n");
 }
 
+BOOST_AUTO_TEST_CASE(InstallAllBinary)
+{
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), TraceFormat::BINARY);
+
+  Simulator::Stop(Seconds(4));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str(), std::ios_base::in | std::ios_base::binary);
+  BinaryTraceReader reader(t);
+  std::stringstream buffer;
+  reader.convert(buffer);
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	SeqNo	Type	DelayS	DelayUS	RetxCount	HopCount\n"
+    "0.0417424	1	0	0	LastDelay	0.0417424	41742.4	1	2\n"
+    "0.0417424	1	0	0	FullDelay	0.0417424	41742.4	1	2\n"
+    "2	2	0	0	LastDelay	0	0	1	0\n"
+    "2	2	0	0	FullDelay	0	0	1	0\n"
+    "3.02087	2	0	1	LastDelay	0.0208712	20871.2	1	1\n"
+    "3.02087	2	0	1	FullDelay	0.0208712	20871.2	1	1\n");
+}
+
+BOOST_AUTO_TEST_CASE(InstallAllAggregated)
+{
+  AppDelayTracer::InstallAll(TEST_TRACE.string(), Seconds(1.5));
+
+  Simulator::Stop(Seconds(5));
+  Simulator::Run();
+
+  AppDelayTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::stringstream buffer;
+  buffer << t.rdbuf();
+
+  BOOST_CHECK_EQUAL(buffer.str(),
+    "Time	Node	AppId	Prefix	Type	Count	DelayP50	DelayP90	DelayP99	DelayMax\n"
+    "1.5	1	0	/prefix	LastDelay	1	0.0417424	0.0417424	0.0417424	0.0417424\n"
+    "1.5	1	0	/prefix	FullDelay	1	0.0417424	0.0417424	0.0417424	0.0417424\n"
+    "3	2	0	/prefix	LastDelay	1	0	0	0	0\n"
+    "3	2	0	/prefix	FullDelay	1	0	0	0	0\n"
+    "4.5	2	0	/prefix	LastDelay	1	0.0208712	0.0208712	0.0208712	0.0208712\n"
+    "4.5	2	0	/prefix	FullDelay	1	0.0208712	0.0208712	0.0208712	0.0208712\n");
+}
+
 BOOST_AUTO_TEST_CASE(InstallNodeContainer)
 {
   NodeContainer nodes;
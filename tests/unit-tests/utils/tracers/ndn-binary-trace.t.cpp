@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-binary-trace.hpp"
+
+#include <sstream>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTracersNdnBinaryTrace)
+
+static std::vector<BinaryTraceColumn>
+makeColumns()
+{
+  return {{"Time", TRACE_COLUMN_TIMESTAMP},
+          {"Node", TRACE_COLUMN_STRING},
+          {"Id", TRACE_COLUMN_INTEGER},
+          {"Rate", TRACE_COLUMN_DOUBLE},
+          {"DelayS", TRACE_COLUMN_DURATION_S},
+          {"DelayUS", TRACE_COLUMN_DURATION_US}};
+}
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  auto os = make_shared<std::stringstream>();
+  {
+    BinaryTraceWriter writer(os, makeColumns());
+    uint64_t nodeA = writer.intern("A");
+    BOOST_CHECK_EQUAL(writer.intern("A"), nodeA);
+
+    writer.appendTimestamp(Seconds(1.5)).appendStringId(nodeA).appendInteger(-1)
+      .appendDouble(0.25).appendDuration(MilliSeconds(20)).appendDuration(MilliSeconds(20))
+      .endRow();
+    // "B" is interned in the middle of the row
+    writer.appendTimestamp(Seconds(1.5)).appendString("B").appendInteger(1234567890123)
+      .appendDouble(-1e100).appendDuration(NanoSeconds(1)).appendDuration(NanoSeconds(1))
+      .endRow();
+    writer.appendTimestamp(Seconds(2)).appendString("B").appendInteger(0)
+      .appendDouble(0).appendDuration(Seconds(0)).appendDuration(Seconds(0))
+      .endRow();
+  }
+
+  std::istringstream is(os->str());
+  BinaryTraceReader reader(is);
+  BOOST_REQUIRE_EQUAL(reader.getColumns().size(), 6);
+  BOOST_CHECK_EQUAL(reader.getColumns()[4].name, "DelayS");
+  BOOST_CHECK_EQUAL(reader.getColumns()[4].type, TRACE_COLUMN_DURATION_S);
+
+  std::vector<BinaryTraceReader::Value> row;
+  BOOST_REQUIRE(reader.readRow(row));
+  BOOST_CHECK_EQUAL(row[0].integer, 1500000000);
+  BOOST_CHECK_EQUAL(reader.getString(row[1].integer), "A");
+  BOOST_CHECK_EQUAL(row[2].integer, -1);
+  BOOST_CHECK_EQUAL(row[3].real, 0.25);
+  BOOST_CHECK_EQUAL(row[4].integer, 20000000);
+
+  BOOST_REQUIRE(reader.readRow(row));
+  BOOST_CHECK_EQUAL(row[0].integer, 1500000000);
+  BOOST_CHECK_EQUAL(reader.getString(row[1].integer), "B");
+  BOOST_CHECK_EQUAL(row[2].integer, 1234567890123);
+  BOOST_CHECK_EQUAL(row[3].real, -1e100);
+  BOOST_CHECK_EQUAL(row[5].integer, 1);
+
+  BOOST_REQUIRE(reader.readRow(row));
+  BOOST_CHECK_EQUAL(row[0].integer, 2000000000);
+
+  BOOST_CHECK(!reader.readRow(row));
+}
+
+BOOST_AUTO_TEST_CASE(Convert)
+{
+  auto os = make_shared<std::stringstream>();
+  {
+    BinaryTraceWriter writer(os, makeColumns());
+    writer.appendTimestamp(Seconds(0.5)).appendString("netdev://[00:00:00:00:00:01]")
+      .appendInteger(3).appendDouble(2.5).appendDuration(MicroSeconds(1500))
+      .appendDuration(MicroSeconds(1500)).endRow();
+    writer.appendTimestamp(Seconds(1)).appendString("a,\"b\"")
+      .appendInteger(-1).appendDouble(0).appendDuration(Seconds(0))
+      .appendDuration(Seconds(0)).endRow();
+  }
+
+  std::istringstream is1(os->str());
+  std::ostringstream text;
+  BinaryTraceReader(is1).convert(text);
+  BOOST_CHECK_EQUAL(text.str(),
+    "Time\tNode\tId\tRate\tDelayS\tDelayUS\n"
+    "0.5\tnetdev://[00:00:00:00:00:01]\t3\t2.5\t0.0015\t1500\n"
+    "1\ta,\"b\"\t-1\t0\t0\t0\n");
+
+  std::istringstream is2(os->str());
+  std::ostringstream csv;
+  BinaryTraceReader(is2).convert(csv, ',');
+  BOOST_CHECK_EQUAL(csv.str(),
+    "Time,Node,Id,Rate,DelayS,DelayUS\n"
+    "0.5,netdev://[00:00:00:00:00:01],3,2.5,0.0015,1500\n"
+    "1,\"a,\"\"b\"\"\",-1,0,0,0\n");
+}
+
+BOOST_AUTO_TEST_CASE(BlockWrites)
+{
+  auto os = make_shared<std::stringstream>();
+  size_t nRows = 0;
+  {
+    BinaryTraceWriter writer(os, makeColumns());
+    size_t headerSize = os->str().size();
+    BOOST_CHECK_EQUAL(headerSize, 0); // header is buffered too
+
+    while (os->str().empty()) {
+      writer.appendTimestamp(MilliSeconds(nRows)).appendString("A").appendInteger(nRows)
+        .appendDouble(nRows).appendDuration(Seconds(0)).appendDuration(Seconds(0)).endRow();
+      ++nRows;
+    }
+    BOOST_CHECK_GE(os->str().size(), BinaryTraceWriter::BLOCK_SIZE);
+
+    // "B" is defined in the second block
+    writer.appendTimestamp(MilliSeconds(nRows)).appendString("B").appendInteger(nRows)
+      .appendDouble(nRows).appendDuration(Seconds(0)).appendDuration(Seconds(0)).endRow();
+    ++nRows;
+  }
+
+  std::istringstream is(os->str());
+  BinaryTraceReader reader(is);
+  std::vector<BinaryTraceReader::Value> row;
+  size_t nRead = 0;
+  while (reader.readRow(row)) {
+    BOOST_CHECK_EQUAL(row[0].integer, static_cast<int64_t>(nRead) * 1000000);
+    BOOST_CHECK_EQUAL(reader.getString(row[1].integer), nRead + 1 < nRows ? "A" : "B");
+    BOOST_CHECK_EQUAL(row[2].integer, static_cast<int64_t>(nRead));
+    ++nRead;
+  }
+  BOOST_CHECK_EQUAL(nRead, nRows);
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  std::istringstream notTrace("Time\tNode\n");
+  BOOST_CHECK_THROW(BinaryTraceReader reader(notTrace), BinaryTraceReader::Error);
+
+  auto os = make_shared<std::stringstream>();
+  {
+    BinaryTraceWriter writer(os, makeColumns());
+    writer.appendTimestamp(Seconds(1)).appendString("A").appendInteger(1).appendDouble(1)
+      .appendDuration(Seconds(0)).appendDuration(Seconds(0)).endRow();
+  }
+  std::string truncated = os->str();
+  truncated.resize(truncated.size() - 3);
+  std::istringstream is(truncated);
+  BinaryTraceReader reader(is);
+  std::vector<BinaryTraceReader::Value> row;
+  BOOST_CHECK_THROW(reader.readRow(row), BinaryTraceReader::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
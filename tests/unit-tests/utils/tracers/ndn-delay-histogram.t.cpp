@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-delay-histogram.hpp"
+
+#include <algorithm>
+#include <random>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTracersNdnDelayHistogram)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  DelayHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.5).GetNanoSeconds(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMax().GetNanoSeconds(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SmallValuesAreExact)
+{
+  DelayHistogram histogram;
+  for (int i = 1; i <= 100; ++i) {
+    histogram.add(NanoSeconds(i));
+  }
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 100);
+  BOOST_CHECK_EQUAL(histogram.getMin().GetNanoSeconds(), 1);
+  BOOST_CHECK_EQUAL(histogram.getMax().GetNanoSeconds(), 100);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.5).GetNanoSeconds(), 50);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.9).GetNanoSeconds(), 90);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.99).GetNanoSeconds(), 99);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(1).GetNanoSeconds(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(RelativeError)
+{
+  std::mt19937 rng(1);
+  std::lognormal_distribution<double> distribution(17, 1.5); // around 24ms
+  std::vector<int64_t> delays;
+
+  DelayHistogram histogram;
+  for (int i = 0; i < 100000; ++i) {
+    int64_t delay = static_cast<int64_t>(distribution(rng));
+    delays.push_back(delay);
+    histogram.add(NanoSeconds(delay));
+  }
+  std::sort(delays.begin(), delays.end());
+
+  const double maxError = 1.0 / (1 << DelayHistogram::PRECISION_BITS);
+  for (double q : {0.01, 0.5, 0.9, 0.99, 0.999}) {
+    double exact = delays[static_cast<size_t>(std::ceil(q * delays.size())) - 1];
+    double estimate = histogram.getQuantile(q).GetNanoSeconds();
+    BOOST_CHECK_LE(std::abs(estimate - exact) / exact, maxError);
+  }
+  BOOST_CHECK_EQUAL(histogram.getMax().GetNanoSeconds(), delays.back());
+  BOOST_CHECK_EQUAL(histogram.getMin().GetNanoSeconds(), delays.front());
+}
+
+BOOST_AUTO_TEST_CASE(MergeAndReset)
+{
+  DelayHistogram low;
+  DelayHistogram high;
+  for (int i = 1; i <= 50; ++i) {
+    low.add(MilliSeconds(i));
+    high.add(Seconds(i));
+  }
+
+  DelayHistogram merged;
+  merged.merge(high);
+  merged.merge(low);
+  BOOST_CHECK_EQUAL(merged.getCount(), 100);
+  BOOST_CHECK_EQUAL(merged.getMin().GetNanoSeconds(), MilliSeconds(1).GetNanoSeconds());
+  BOOST_CHECK_EQUAL(merged.getMax().GetNanoSeconds(), Seconds(50).GetNanoSeconds());
+  BOOST_CHECK_LE(merged.getQuantile(0.5).GetNanoSeconds(), MilliSeconds(51).GetNanoSeconds());
+  BOOST_CHECK_GE(merged.getQuantile(0.51).GetNanoSeconds(), Seconds(0.99).GetNanoSeconds());
+
+  merged.reset();
+  BOOST_CHECK_EQUAL(merged.getCount(), 0);
+  merged.add(MilliSeconds(7));
+  BOOST_CHECK_EQUAL(merged.getQuantile(0.5).GetNanoSeconds(), MilliSeconds(7).GetNanoSeconds());
+  BOOST_CHECK_EQUAL(merged.getQuantile(1).GetNanoSeconds(), MilliSeconds(7).GetNanoSeconds());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
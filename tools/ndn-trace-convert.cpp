@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// Converts a binary trace written by L3RateTracer, CsTracer or AppDelayTracer
+// into their text format, or into CSV
+
+#include "ns3/ndnSIM/utils/tracers/ndn-binary-trace.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static void
+usage(std::ostream& os, const char* programName)
+{
+  os << "Usage: " << programName << " [--csv] INPUT [OUTPUT]\n"
+     << "\n"
+     << "Convert binary trace INPUT into tab-separated text, the format of the text traces,\n"
+     << "or into CSV with --csv.  The result is written to OUTPUT, or to the standard output.\n";
+}
+
+int
+main(int argc, char* argv[])
+{
+  char separator = '\t';
+  int argi = 1;
+  if (argi < argc && std::strcmp(argv[argi], "--csv") == 0) {
+    separator = ',';
+    ++argi;
+  }
+  if (argi < argc && (std::strcmp(argv[argi], "-h") == 0 || std::strcmp(argv[argi], "--help") == 0)) {
+    usage(std::cout, argv[0]);
+    return 0;
+  }
+  if (argc - argi < 1 || argc - argi > 2) {
+    usage(std::cerr, argv[0]);
+    return 2;
+  }
+
+  std::ifstream input(argv[argi], std::ios_base::in | std::ios_base::binary);
+  if (!input.is_open()) {
+    std::cerr << "ERROR: cannot open " << argv[argi] << std::endl;
+    return 1;
+  }
+
+  std::ofstream outputFile;
+  if (argc - argi == 2) {
+    outputFile.open(argv[argi + 1], std::ios_base::out | std::ios_base::trunc);
+    if (!outputFile.is_open()) {
+      std::cerr << "ERROR: cannot open " << argv[argi + 1] << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& output = outputFile.is_open() ? outputFile : std::cout;
+
+  try {
+    ns3::ndn::BinaryTraceReader reader(input);
+    reader.convert(output, separator);
+  }
+  catch (const ns3::ndn::BinaryTraceReader::Error& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -35,8 +35,12 @@ public:
     return 0xaee87802; // md5("Ns3PacketTag")[0:8]
   }
 
-  Ns3PacketTag(Ptr<const Packet> packet)
+  /** \param packet the received ns-3 packet, which still starts with the NDN packet
+   *  \param headerSize size of the NDN packet at the start of \p packet
+   */
+  Ns3PacketTag(Ptr<const Packet> packet, uint32_t headerSize = 0)
     : m_packet(packet)
+    , m_headerSize(headerSize)
   {
   }
 
@@ -46,8 +50,15 @@ public:
     return m_packet;
   }
 
+  uint32_t
+  getHeaderSize() const
+  {
+    return m_headerSize;
+  }
+
 private:
   Ptr<const Packet> m_packet;
+  uint32_t m_headerSize;
 };
 
 } // namespace ndn
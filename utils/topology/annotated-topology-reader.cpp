@@ -44,6 +44,7 @@
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-face.hpp"
+#include "helper/ndn-partition-helper.hpp"
 
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
@@ -70,6 +71,7 @@ AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double
   , m_randY(CreateObject<UniformRandomVariable>())
   , m_scale(scale)
   , m_requiredPartitions(1)
+  , m_nPartitions(0)
 {
   NS_LOG_FUNCTION(this);
 
@@ -94,6 +96,13 @@ AnnotatedTopologyReader::SetBoundingBox(double ulx, double uly, double lrx, doub
   m_randY->SetAttribute("Max", DoubleValue(lry));
 }
 
+void
+AnnotatedTopologyReader::SetNPartitions(uint32_t nPartitions)
+{
+  NS_LOG_FUNCTION(this << nPartitions);
+  m_nPartitions = nPartitions;
+}
+
 void
 AnnotatedTopologyReader::SetMobilityModel(const std::string& model)
 {
@@ -175,6 +184,15 @@ AnnotatedTopologyReader::Read(void)
     return m_nodes;
   }
 
+  struct NodeRecord
+  {
+    string name;
+    double latitude;
+    double longitude;
+    uint32_t systemId;
+  };
+  vector<NodeRecord> nodeRecords;
+
   while (!topgen.eof()) {
     string line;
     getline(topgen, line);
@@ -184,32 +202,28 @@ AnnotatedTopologyReader::Read(void)
       break; // stop reading nodes
 
     istringstream lineBuffer(line);
-    string name, city;
-    double latitude = 0, longitude = 0;
-    uint32_t systemId = 0;
+    NodeRecord record = {"", 0, 0, 0};
+    string city;
 
-    lineBuffer >> name >> city >> latitude >> longitude >> systemId;
-    if (name.empty())
+    lineBuffer >> record.name >> city >> record.latitude >> record.longitude >> record.systemId;
+    if (record.name.empty())
       continue;
 
-    Ptr<Node> node;
-
-    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
-    else {
-      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
-      // node = CreateNode (name, systemId);
-    }
+    nodeRecords.push_back(record);
   }
 
-  map<string, set<string>> processedLinks; // to eliminate duplications
-
   if (topgen.eof()) {
     NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
     return m_nodes;
   }
 
+  struct LinkRecord
+  {
+    string from, to, capacity, metric, delay, maxPackets, lossRate;
+  };
+  vector<LinkRecord> linkRecords;
+  map<string, set<string>> processedLinks; // to eliminate duplications
+
   // SeekToSection ("link");
   while (!topgen.eof()) {
     string line;
@@ -222,44 +236,79 @@ AnnotatedTopologyReader::Read(void)
     // NS_LOG_DEBUG ("Input: [" << line << "]");
 
     istringstream lineBuffer(line);
-    string from, to, capacity, metric, delay, maxPackets, lossRate;
+    LinkRecord record;
 
-    lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
+    lineBuffer >> record.from >> record.to >> record.capacity >> record.metric >> record.delay
+      >> record.maxPackets >> record.lossRate;
 
-    if (processedLinks[to].size() != 0
-        && processedLinks[to].find(from) != processedLinks[to].end()) {
+    if (processedLinks[record.to].size() != 0
+        && processedLinks[record.to].find(record.from) != processedLinks[record.to].end()) {
       continue; // duplicated link
     }
-    processedLinks[from].insert(to);
+    processedLinks[record.from].insert(record.to);
+
+    linkRecords.push_back(record);
+  }
+  topgen.close();
+
+  if (m_nPartitions > 0) {
+    ndn::PartitionHelper partitioner;
+    for (const NodeRecord& record : nodeRecords) {
+      partitioner.AddNode(record.name);
+    }
+    for (const LinkRecord& record : linkRecords) {
+      partitioner.AddLink(record.from, record.to,
+                          record.delay.empty() ? Seconds(0) : Time(record.delay));
+    }
+    partitioner.Partition(m_nPartitions);
+
+    for (NodeRecord& record : nodeRecords) {
+      record.systemId = partitioner.GetSystemId(record.name);
+    }
+    m_requiredPartitions = m_nPartitions;
+    NS_LOG_INFO("Topology split into " << m_nPartitions << " partitions with lookahead "
+                                       << partitioner.GetLookahead());
+  }
+
+  for (const NodeRecord& record : nodeRecords) {
+    if (abs(record.latitude) > 0.001 && abs(record.latitude) > 0.001)
+      CreateNode(record.name, m_scale * record.longitude, -m_scale * record.latitude,
+                 record.systemId);
+    else {
+      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
+      CreateNode(record.name, var->GetValue(0, 200), var->GetValue(0, 200), record.systemId);
+      // CreateNode (record.name, record.systemId);
+    }
+  }
 
-    Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
-    NS_ASSERT_MSG(fromNode != 0, from << " node not found");
-    Ptr<Node> toNode = Names::Find<Node>(m_path, to);
-    NS_ASSERT_MSG(toNode != 0, to << " node not found");
+  for (const LinkRecord& record : linkRecords) {
+    Ptr<Node> fromNode = Names::Find<Node>(m_path, record.from);
+    NS_ASSERT_MSG(fromNode != 0, record.from << " node not found");
+    Ptr<Node> toNode = Names::Find<Node>(m_path, record.to);
+    NS_ASSERT_MSG(toNode != 0, record.to << " node not found");
 
-    Link link(fromNode, from, toNode, to);
+    Link link(fromNode, record.from, toNode, record.to);
 
-    link.SetAttribute("DataRate", capacity);
-    link.SetAttribute("OSPF", metric);
+    link.SetAttribute("DataRate", record.capacity);
+    link.SetAttribute("OSPF", record.metric);
 
-    if (!delay.empty())
-      link.SetAttribute("Delay", delay);
-    if (!maxPackets.empty())
-      link.SetAttribute("MaxPackets", maxPackets);
+    if (!record.delay.empty())
+      link.SetAttribute("Delay", record.delay);
+    if (!record.maxPackets.empty())
+      link.SetAttribute("MaxPackets", record.maxPackets);
 
     // Saran Added lossRate
-    if (!lossRate.empty())
-      link.SetAttribute("LossRate", lossRate);
+    if (!record.lossRate.empty())
+      link.SetAttribute("LossRate", record.lossRate);
 
     AddLink(link);
-    NS_LOG_DEBUG("New link " << from << " <==> " << to << " / " << capacity << " with " << metric
-                             << " metric (" << delay << ", " << maxPackets << ", " << lossRate
-                             << ")");
+    NS_LOG_DEBUG("New link " << record.from << " <==> " << record.to << " / " << record.capacity
+                             << " with " << record.metric << " metric (" << record.delay << ", "
+                             << record.maxPackets << ", " << record.lossRate << ")");
   }
 
   NS_LOG_INFO("Annotated topology created with " << m_nodes.GetN() << " nodes and " << LinksSize()
                                                  << " links");
-  topgen.close();
 
   ApplySettings();
 
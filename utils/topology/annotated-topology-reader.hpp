@@ -90,6 +90,17 @@ public:
   virtual void
   SetBoundingBox(double ulx, double uly, double lrx, double lry);
 
+  /**
+   * \brief Assign nodes to partitions of the distributed simulator automatically
+   *
+   * Instead of using systemId column of the topology file, nodes are split into \p nPartitions
+   * partitions by ndn::PartitionHelper, which keeps low-delay links inside partitions.  Should
+   * be called before Read, usually with MpiInterface::GetSize ().  0 (default) disables
+   * automatic partitioning.
+   */
+  virtual void
+  SetNPartitions(uint32_t nPartitions);
+
   /**
    * \brief Set mobility model to be used on nodes
    * \param model class name of the model
@@ -147,6 +158,7 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+  uint32_t m_nPartitions;
 };
 }
 
@@ -28,6 +28,8 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 
+#include "helper/ndn-partition-helper.hpp"
+
 #include <boost/lexical_cast.hpp>
 #include <fstream>
 
@@ -51,10 +53,11 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
   std::shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     std::shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::string fileName = ndn::PartitionHelper::GetPartitionFileName(file);
+    os->open(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
 
     if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
       return;
     }
 
@@ -65,6 +68,10 @@ L2RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
   }
 
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!ndn::PartitionHelper::IsLocal(*node)) {
+      continue;
+    }
+
     NS_LOG_DEBUG("Node: " << boost::lexical_cast<std::string>((*node)->GetId()));
 
     Ptr<L2RateTracer> trace = Create<L2RateTracer>(outputStream, *node);
@@ -23,12 +23,15 @@
 #include "ns3/config.h"
 #include "ns3/names.h"
 #include "ns3/callback.h"
+#include "ns3/string.h"
 
 #include "apps/ndn-app.hpp"
 #include "ns3/simulator.h"
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
+#include "helper/ndn-partition-helper.hpp"
+
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
@@ -49,7 +52,13 @@ AppDelayTracer::Destroy()
 }
 
 void
-AppDelayTracer::InstallAll(const std::string& file)
+AppDelayTracer::InstallAll(const std::string& file, TraceFormat format)
+{
+  InstallAll(file, Seconds(0), format);
+}
+
+void
+AppDelayTracer::InstallAll(const std::string& file, Time averagingPeriod, TraceFormat format)
 {
   using namespace boost;
   using namespace std;
@@ -58,10 +67,15 @@ AppDelayTracer::InstallAll(const std::string& file)
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::string fileName = PartitionHelper::GetPartitionFileName(file);
+    std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+    if (format == TraceFormat::BINARY) {
+      mode |= std::ios_base::binary;
+    }
+    os->open(fileName.c_str(), mode);
 
     if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
       return;
     }
 
@@ -71,12 +85,31 @@ AppDelayTracer::InstallAll(const std::string& file)
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
+  bool isAggregated = !averagingPeriod.IsZero();
+  shared_ptr<BinaryTraceWriter> writer;
+  if (format == TraceFormat::BINARY) {
+    writer = make_shared<BinaryTraceWriter>(outputStream, isAggregated ?
+                                                            GetAggregatedBinaryColumns() :
+                                                            GetBinaryColumns());
+  }
+
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<AppDelayTracer> trace = Install(*node, outputStream);
+    if (!PartitionHelper::IsLocal(*node)) {
+      continue;
+    }
+
+    Ptr<AppDelayTracer> trace;
+    if (isAggregated) {
+      trace = writer != nullptr ? Install(*node, writer, averagingPeriod)
+                                : Install(*node, outputStream, averagingPeriod);
+    }
+    else {
+      trace = writer != nullptr ? Install(*node, writer) : Install(*node, outputStream);
+    }
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (writer == nullptr && tracers.size() > 0) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -95,10 +128,11 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::string fileName = PartitionHelper::GetPartitionFileName(file);
+    os->open(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
 
     if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
       return;
     }
 
@@ -109,6 +143,10 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if (!PartitionHelper::IsLocal(*node)) {
+      continue;
+    }
+
     Ptr<AppDelayTracer> trace = Install(*node, outputStream);
     tracers.push_back(trace);
   }
@@ -125,6 +163,10 @@ AppDelayTracer::Install(const NodeContainer& nodes, const std::string& file)
 void
 AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
 {
+  if (!PartitionHelper::IsLocal(node)) {
+    return;
+  }
+
   using namespace boost;
   using namespace std;
 
@@ -132,10 +174,11 @@ AppDelayTracer::Install(Ptr<Node> node, const std::string& file)
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::string fileName = PartitionHelper::GetPartitionFileName(file);
+    os->open(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
 
     if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
       return;
     }
 
@@ -167,6 +210,68 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
   return trace;
 }
 
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(writer, node);
+
+  return trace;
+}
+
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                        Time averagingPeriod)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(outputStream, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+Ptr<AppDelayTracer>
+AppDelayTracer::Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer, Time averagingPeriod)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<AppDelayTracer> trace = Create<AppDelayTracer>(writer, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+std::vector<BinaryTraceColumn>
+AppDelayTracer::GetBinaryColumns()
+{
+  return {{"Time", TRACE_COLUMN_TIMESTAMP},
+          {"Node", TRACE_COLUMN_STRING},
+          {"AppId", TRACE_COLUMN_INTEGER},
+          {"SeqNo", TRACE_COLUMN_INTEGER},
+          {"Type", TRACE_COLUMN_STRING},
+          {"DelayS", TRACE_COLUMN_DURATION_S},
+          {"DelayUS", TRACE_COLUMN_DURATION_US},
+          {"RetxCount", TRACE_COLUMN_INTEGER},
+          {"HopCount", TRACE_COLUMN_INTEGER}};
+}
+
+std::vector<BinaryTraceColumn>
+AppDelayTracer::GetAggregatedBinaryColumns()
+{
+  return {{"Time", TRACE_COLUMN_TIMESTAMP},
+          {"Node", TRACE_COLUMN_STRING},
+          {"AppId", TRACE_COLUMN_INTEGER},
+          {"Prefix", TRACE_COLUMN_STRING},
+          {"Type", TRACE_COLUMN_STRING},
+          {"Count", TRACE_COLUMN_INTEGER},
+          {"DelayP50", TRACE_COLUMN_DURATION_S},
+          {"DelayP90", TRACE_COLUMN_DURATION_S},
+          {"DelayP99", TRACE_COLUMN_DURATION_S},
+          {"DelayMax", TRACE_COLUMN_DURATION_S}};
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -174,6 +279,7 @@ AppDelayTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_nodeId(0)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -188,11 +294,31 @@ AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 AppDelayTracer::AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_nodeId(0)
 {
   Connect();
 }
 
-AppDelayTracer::~AppDelayTracer(){};
+AppDelayTracer::AppDelayTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_writer(writer)
+  , m_nodeId(0)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+  m_nodeId = m_writer->intern(m_node);
+}
+
+AppDelayTracer::~AppDelayTracer()
+{
+  m_printEvent.Cancel();
+}
 
 void
 AppDelayTracer::Connect()
@@ -206,9 +332,163 @@ AppDelayTracer::Connect()
                                 MakeCallback(&AppDelayTracer::FirstInterestDataDelay, this));
 }
 
+void
+AppDelayTracer::SetAveragingPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::PeriodicPrinter()
+{
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
+  Reset();
+
+  m_printEvent = Simulator::Schedule(m_period, &AppDelayTracer::PeriodicPrinter, this);
+}
+
+void
+AppDelayTracer::Reset()
+{
+  for (auto& stats : m_stats) {
+    stats.second.lastDelay.reset();
+    stats.second.fullDelay.reset();
+  }
+}
+
+AppDelayTracer::AppStats&
+AppDelayTracer::GetAppStats(Ptr<App> app)
+{
+  auto it = m_stats.find(app->GetId());
+  if (it == m_stats.end()) {
+    it = m_stats.insert(std::make_pair(app->GetId(), AppStats())).first;
+
+    // Prefix of consumers, whatever the type of the attribute
+    StringValue prefix;
+    if (app->GetAttributeFailSafe("Prefix", prefix)) {
+      it->second.prefix = prefix.Get();
+    }
+    else {
+      it->second.prefix = "-";
+    }
+  }
+  return it->second;
+}
+
+std::map<std::string, AppDelayTracer::AppStats>
+AppDelayTracer::GetSharedPrefixStats() const
+{
+  std::map<std::string, size_t> nApps;
+  for (const auto& stats : m_stats) {
+    ++nApps[stats.second.prefix];
+  }
+
+  std::map<std::string, AppStats> prefixStats;
+  for (const auto& stats : m_stats) {
+    if (nApps[stats.second.prefix] < 2) {
+      continue;
+    }
+    AppStats& merged = prefixStats[stats.second.prefix];
+    merged.prefix = stats.second.prefix;
+    merged.lastDelay.merge(stats.second.lastDelay);
+    merged.fullDelay.merge(stats.second.fullDelay);
+  }
+  return prefixStats;
+}
+
+void
+AppDelayTracer::Print(std::ostream& os) const
+{
+  Time time = Simulator::Now();
+
+#define PRINTER(appId, stats, type, histogram)                                                    \
+  if (histogram.getCount() > 0) {                                                                 \
+    os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << appId << "\t" << stats.prefix     \
+       << "\t" << type << "\t" << histogram.getCount() << "\t"                                    \
+       << histogram.getQuantile(0.5).ToDouble(Time::S) << "\t"                                    \
+       << histogram.getQuantile(0.9).ToDouble(Time::S) << "\t"                                    \
+       << histogram.getQuantile(0.99).ToDouble(Time::S) << "\t"                                   \
+       << histogram.getMax().ToDouble(Time::S) << "\n";                                           \
+  }
+
+  for (const auto& stats : m_stats) {
+    PRINTER(stats.first, stats.second, "LastDelay", stats.second.lastDelay);
+    PRINTER(stats.first, stats.second, "FullDelay", stats.second.fullDelay);
+  }
+
+  for (const auto& stats : GetSharedPrefixStats()) {
+    PRINTER(-1, stats.second, "LastDelay", stats.second.lastDelay);
+    PRINTER(-1, stats.second, "FullDelay", stats.second.fullDelay);
+  }
+#undef PRINTER
+}
+
+void
+AppDelayTracer::Write(BinaryTraceWriter& writer) const
+{
+  Time time = Simulator::Now();
+
+#define WRITER(appId, stats, type, histogram)                                                     \
+  if (histogram.getCount() > 0) {                                                                 \
+    writer.appendTimestamp(time)                                                                  \
+      .appendStringId(m_nodeId)                                                                   \
+      .appendInteger(appId)                                                                       \
+      .appendString(stats.prefix)                                                                 \
+      .appendString(type)                                                                         \
+      .appendInteger(histogram.getCount())                                                        \
+      .appendDuration(histogram.getQuantile(0.5))                                                 \
+      .appendDuration(histogram.getQuantile(0.9))                                                 \
+      .appendDuration(histogram.getQuantile(0.99))                                                \
+      .appendDuration(histogram.getMax())                                                         \
+      .endRow();                                                                                  \
+  }
+
+  for (const auto& stats : m_stats) {
+    WRITER(stats.first, stats.second, "LastDelay", stats.second.lastDelay);
+    WRITER(stats.first, stats.second, "FullDelay", stats.second.fullDelay);
+  }
+
+  for (const auto& stats : GetSharedPrefixStats()) {
+    WRITER(-1, stats.second, "LastDelay", stats.second.lastDelay);
+    WRITER(-1, stats.second, "FullDelay", stats.second.fullDelay);
+  }
+#undef WRITER
+}
+
 void
 AppDelayTracer::PrintHeader(std::ostream& os) const
 {
+  if (!m_period.IsZero()) {
+    os << "Time"
+       << "\t"
+       << "Node"
+       << "\t"
+       << "AppId"
+       << "\t"
+       << "Prefix"
+       << "\t"
+       << "Type"
+       << "\t"
+       << "Count"
+       << "\t"
+       << "DelayP50"
+       << "\t"
+       << "DelayP90"
+       << "\t"
+       << "DelayP99"
+       << "\t"
+       << "DelayMax"
+       << "";
+    return;
+  }
+
   os << "Time"
      << "\t"
      << "Node"
@@ -234,6 +514,25 @@ void
 AppDelayTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
                                                    int32_t hopCount)
 {
+  if (!m_period.IsZero()) {
+    GetAppStats(app).lastDelay.add(delay);
+    return;
+  }
+
+  if (m_writer != nullptr) {
+    m_writer->appendTimestamp(Simulator::Now())
+      .appendStringId(m_nodeId)
+      .appendInteger(app->GetId())
+      .appendInteger(seqno)
+      .appendString("LastDelay")
+      .appendDuration(delay)
+      .appendDuration(delay)
+      .appendInteger(1)
+      .appendInteger(hopCount)
+      .endRow();
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "LastDelay"
@@ -245,6 +544,25 @@ void
 AppDelayTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount,
                                        int32_t hopCount)
 {
+  if (!m_period.IsZero()) {
+    GetAppStats(app).fullDelay.add(delay);
+    return;
+  }
+
+  if (m_writer != nullptr) {
+    m_writer->appendTimestamp(Simulator::Now())
+      .appendStringId(m_nodeId)
+      .appendInteger(app->GetId())
+      .appendInteger(seqno)
+      .appendString("FullDelay")
+      .appendDuration(delay)
+      .appendDuration(delay)
+      .appendInteger(retxCount)
+      .appendInteger(hopCount)
+      .endRow();
+    return;
+  }
+
   *m_os << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t" << app->GetId() << "\t"
         << seqno << "\t"
         << "FullDelay"
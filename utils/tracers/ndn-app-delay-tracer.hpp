@@ -22,6 +22,9 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-binary-trace.hpp"
+#include "ndn-delay-histogram.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -30,6 +33,7 @@
 
 #include <tuple>
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -50,10 +54,32 @@ public:
    * @brief Helper method to install tracers on all simulation nodes
    *
    * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param format Format of the trace file; a binary trace can be converted to text or CSV
+   *        with ndn-trace-convert
    *
    */
   static void
-  InstallAll(const std::string& file);
+  InstallAll(const std::string& file, TraceFormat format = TraceFormat::TEXT);
+
+  /**
+   * @brief Helper method to install tracers on all simulation nodes, writing delay distributions
+   *        instead of individual delays
+   *
+   * For every application, delays are collected in DelayHistogram sketches and once per
+   * averaging period a line per delay type is written with the number of delays, their 50th,
+   * 90th and 99th percentiles and the maximum delay.  Applications without delays in the period
+   * are skipped.  When several applications on a node request the same prefix, an additional line
+   * with AppId -1 summarizes their delays.
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param averagingPeriod How often data will be written into the trace file; if zero, a line is
+   *        written for every delay, as with InstallAll (file, format)
+   * @param format Format of the trace file; a binary trace can be converted to text or CSV
+   *        with ndn-trace-convert
+   */
+  static void
+  InstallAll(const std::string& file, Time averagingPeriod,
+             TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -91,6 +117,50 @@ public:
   static Ptr<AppDelayTracer>
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream);
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node, writing a binary trace
+   *
+   * @param node Node on which to install tracer
+   * @param writer Binary trace writer, which must have been created with GetBinaryColumns ()
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer);
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node, writing delay
+   *        distributions once per averaging period
+   *
+   * @param node Node on which to install tracer
+   * @param outputStream Smart pointer to a stream
+   * @param averagingPeriod How often data will be written into the trace file
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream, Time averagingPeriod);
+
+  /**
+   * @brief Helper method to install tracers on a specific simulation node, writing delay
+   *        distributions once per averaging period into a binary trace
+   *
+   * @param node Node on which to install tracer
+   * @param writer Binary trace writer, which must have been created with
+   *        GetAggregatedBinaryColumns ()
+   * @param averagingPeriod How often data will be written into the trace file
+   */
+  static Ptr<AppDelayTracer>
+  Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer, Time averagingPeriod);
+
+  /**
+   * @brief Columns of the binary trace, same as those of the text trace
+   */
+  static std::vector<BinaryTraceColumn>
+  GetBinaryColumns();
+
+  /**
+   * @brief Columns of the binary trace of delay distributions
+   */
+  static std::vector<BinaryTraceColumn>
+  GetAggregatedBinaryColumns();
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -114,6 +184,14 @@ public:
    */
   AppDelayTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to all applications on the node using node's pointer
+   *        and writes a binary trace
+   * @param writer binary trace writer
+   * @param node   pointer to the node
+   */
+  AppDelayTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -138,11 +216,47 @@ private:
   FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount,
                          int32_t hopCount);
 
+  void
+  SetAveragingPeriod(const Time& period);
+
+  void
+  PeriodicPrinter();
+
+  void
+  Print(std::ostream& os) const;
+
+  void
+  Write(BinaryTraceWriter& writer) const;
+
+  void
+  Reset();
+
+  struct AppStats {
+    std::string prefix;
+    DelayHistogram lastDelay;
+    DelayHistogram fullDelay;
+  };
+
+  AppStats&
+  GetAppStats(Ptr<App> app);
+
+  /**
+   * @brief Per-prefix distributions of prefixes requested by several applications
+   */
+  std::map<std::string, AppStats>
+  GetSharedPrefixStats() const;
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_writer;
+  uint64_t m_nodeId; ///< interned node name, if writing a binary trace
+
+  Time m_period; ///< averaging period; zero if every delay is traced
+  EventId m_printEvent;
+  std::map<uint32_t, AppStats> m_stats; ///< AppId => delay distributions
 };
 
 } // namespace ndn
@@ -0,0 +1,433 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-binary-trace.hpp"
+
+#include "ns3/assert.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <cstring>
+
+namespace ns3 {
+namespace ndn {
+
+static const char TRACE_MAGIC[] = {'N', 'D', 'N', 'T', 'R', 'A', 'C', 'E'};
+static const uint8_t TRACE_VERSION = 2;
+
+static const uint8_t TRACE_RECORD_BLOCK = 0x01;
+
+const size_t BinaryTraceWriter::BLOCK_SIZE;
+
+static inline uint64_t
+encodeZigZag(int64_t value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static inline int64_t
+decodeZigZag(uint64_t value)
+{
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+static void
+writeVarNumber(std::vector<uint8_t>& buffer, uint64_t value)
+{
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<uint8_t>(value));
+}
+
+BinaryTraceWriter::BinaryTraceWriter(shared_ptr<std::ostream> os,
+                                     const std::vector<BinaryTraceColumn>& columns)
+  : m_os(os)
+  , m_columns(columns)
+  , m_values(columns.size())
+  , m_nNewStrings(0)
+  , m_nRows(0)
+  , m_nValues(0)
+  , m_lastTimestamp(0)
+{
+  for (std::vector<uint8_t>& values : m_values) {
+    values.reserve(BLOCK_SIZE / m_columns.size());
+  }
+
+  m_output.insert(m_output.end(), TRACE_MAGIC, TRACE_MAGIC + sizeof(TRACE_MAGIC));
+  m_output.push_back(TRACE_VERSION);
+  writeVarNumber(m_output, m_columns.size());
+  for (const BinaryTraceColumn& column : m_columns) {
+    m_output.push_back(column.type);
+    writeVarNumber(m_output, column.name.size());
+    m_output.insert(m_output.end(), column.name.begin(), column.name.end());
+  }
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+  flush();
+}
+
+uint64_t
+BinaryTraceWriter::intern(const std::string& str)
+{
+  auto it = m_strings.find(str);
+  if (it != m_strings.end()) {
+    return it->second;
+  }
+
+  uint64_t id = m_strings.size();
+  m_strings.emplace(str, id);
+
+  // defined at the start of the block, before any row that refers to it
+  writeVarNumber(m_newStrings, str.size());
+  m_newStrings.insert(m_newStrings.end(), str.begin(), str.end());
+  ++m_nNewStrings;
+  return id;
+}
+
+std::vector<uint8_t>&
+BinaryTraceWriter::beginValue(BinaryTraceColumnType type)
+{
+  NS_ASSERT_MSG(m_nValues < m_columns.size(), "Too many values in a row");
+  NS_ASSERT_MSG(m_columns[m_nValues].type == type ||
+                  (type == TRACE_COLUMN_DURATION_S &&
+                   m_columns[m_nValues].type == TRACE_COLUMN_DURATION_US),
+                "Value does not match type of column " << m_columns[m_nValues].name);
+
+  return m_values[m_nValues++];
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::appendTimestamp(const Time& time)
+{
+  std::vector<uint8_t>& values = beginValue(TRACE_COLUMN_TIMESTAMP);
+  int64_t ns = time.GetNanoSeconds();
+  writeVarNumber(values, encodeZigZag(ns - m_lastTimestamp));
+  m_lastTimestamp = ns;
+  return *this;
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::appendString(const std::string& str)
+{
+  uint64_t id = intern(str);
+  return appendStringId(id);
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::appendStringId(uint64_t id)
+{
+  NS_ASSERT(id < m_strings.size());
+  writeVarNumber(beginValue(TRACE_COLUMN_STRING), id);
+  return *this;
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::appendInteger(int64_t value)
+{
+  writeVarNumber(beginValue(TRACE_COLUMN_INTEGER), encodeZigZag(value));
+  return *this;
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::appendDouble(double value)
+{
+  std::vector<uint8_t>& values = beginValue(TRACE_COLUMN_DOUBLE);
+  uint64_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 8; ++i) {
+    values.push_back(static_cast<uint8_t>(bits >> (8 * i)));
+  }
+  return *this;
+}
+
+BinaryTraceWriter&
+BinaryTraceWriter::appendDuration(const Time& duration)
+{
+  writeVarNumber(beginValue(TRACE_COLUMN_DURATION_S), encodeZigZag(duration.GetNanoSeconds()));
+  return *this;
+}
+
+void
+BinaryTraceWriter::endRow()
+{
+  NS_ASSERT_MSG(m_nValues == m_columns.size(), "Row is missing values");
+  m_nValues = 0;
+  ++m_nRows;
+
+  size_t size = m_newStrings.size();
+  for (const std::vector<uint8_t>& values : m_values) {
+    size += values.size();
+  }
+  if (size >= BLOCK_SIZE) {
+    flush();
+  }
+}
+
+void
+BinaryTraceWriter::flush()
+{
+  NS_ASSERT_MSG(m_nValues == 0, "Cannot flush in the middle of a row");
+
+  if (m_nRows > 0 || m_nNewStrings > 0) {
+    m_output.push_back(TRACE_RECORD_BLOCK);
+    writeVarNumber(m_output, m_nRows);
+    writeVarNumber(m_output, m_nNewStrings);
+    m_output.insert(m_output.end(), m_newStrings.begin(), m_newStrings.end());
+    for (std::vector<uint8_t>& values : m_values) {
+      writeVarNumber(m_output, values.size());
+      m_output.insert(m_output.end(), values.begin(), values.end());
+      values.clear();
+    }
+    m_newStrings.clear();
+    m_nNewStrings = 0;
+    m_nRows = 0;
+  }
+
+  m_os->write(reinterpret_cast<const char*>(m_output.data()), m_output.size());
+  m_output.clear();
+  m_os->flush();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+BinaryTraceReader::BinaryTraceReader(std::istream& is)
+  : m_input(*is.rdbuf())
+  , m_lastTimestamp(0)
+  , m_nRowsLeft(0)
+{
+  char magic[sizeof(TRACE_MAGIC)];
+  if (m_input.sgetn(magic, sizeof(magic)) != sizeof(magic) ||
+      std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0) {
+    BOOST_THROW_EXCEPTION(Error("Not a binary trace"));
+  }
+
+  if (m_input.sbumpc() != TRACE_VERSION) {
+    BOOST_THROW_EXCEPTION(Error("Unsupported binary trace version"));
+  }
+
+  uint64_t nColumns = readVarNumber();
+  for (uint64_t i = 0; i < nColumns; ++i) {
+    BinaryTraceColumn column;
+    int type = m_input.sbumpc();
+    if (type < TRACE_COLUMN_TIMESTAMP || type > TRACE_COLUMN_DURATION_US) {
+      BOOST_THROW_EXCEPTION(Error("Unknown column type"));
+    }
+    column.type = static_cast<BinaryTraceColumnType>(type);
+
+    column.name.resize(readVarNumber());
+    if (m_input.sgetn(&column.name[0], column.name.size()) !=
+        static_cast<std::streamsize>(column.name.size())) {
+      BOOST_THROW_EXCEPTION(Error("Truncated binary trace header"));
+    }
+    m_columns.push_back(column);
+  }
+
+  m_values.resize(m_columns.size());
+  m_positions.resize(m_columns.size());
+}
+
+uint64_t
+BinaryTraceReader::readVarNumber()
+{
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = m_input.sbumpc();
+    if (byte == std::char_traits<char>::eof()) {
+      BOOST_THROW_EXCEPTION(Error("Truncated binary trace"));
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  BOOST_THROW_EXCEPTION(Error("Malformed number in binary trace"));
+}
+
+uint64_t
+BinaryTraceReader::readVarNumber(size_t column)
+{
+  const std::vector<uint8_t>& values = m_values[column];
+  size_t& pos = m_positions[column];
+
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (pos >= values.size()) {
+      BOOST_THROW_EXCEPTION(Error("Column " + m_columns[column].name + " is missing values"));
+    }
+    uint8_t byte = values[pos++];
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  BOOST_THROW_EXCEPTION(Error("Malformed number in binary trace"));
+}
+
+bool
+BinaryTraceReader::readBlock()
+{
+  do {
+    int tag = m_input.sbumpc();
+    if (tag == std::char_traits<char>::eof()) {
+      return false;
+    }
+    if (tag != TRACE_RECORD_BLOCK) {
+      BOOST_THROW_EXCEPTION(Error("Unknown record in binary trace"));
+    }
+
+    m_nRowsLeft = readVarNumber();
+
+    uint64_t nStrings = readVarNumber();
+    for (uint64_t i = 0; i < nStrings; ++i) {
+      std::string str(readVarNumber(), '\0');
+      if (m_input.sgetn(&str[0], str.size()) != static_cast<std::streamsize>(str.size())) {
+        BOOST_THROW_EXCEPTION(Error("Truncated binary trace"));
+      }
+      m_strings.push_back(std::move(str));
+    }
+
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+      m_values[i].resize(readVarNumber());
+      m_positions[i] = 0;
+      if (m_input.sgetn(reinterpret_cast<char*>(m_values[i].data()), m_values[i].size()) !=
+          static_cast<std::streamsize>(m_values[i].size())) {
+        BOOST_THROW_EXCEPTION(Error("Truncated binary trace"));
+      }
+    }
+  } while (m_nRowsLeft == 0);
+
+  return true;
+}
+
+bool
+BinaryTraceReader::readRow(std::vector<Value>& row)
+{
+  if (m_nRowsLeft == 0 && !readBlock()) {
+    return false;
+  }
+  --m_nRowsLeft;
+
+  row.resize(m_columns.size());
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    switch (m_columns[i].type) {
+    case TRACE_COLUMN_TIMESTAMP:
+      m_lastTimestamp += decodeZigZag(readVarNumber(i));
+      row[i].integer = m_lastTimestamp;
+      break;
+    case TRACE_COLUMN_STRING:
+      row[i].integer = readVarNumber(i);
+      if (static_cast<uint64_t>(row[i].integer) >= m_strings.size()) {
+        BOOST_THROW_EXCEPTION(Error("Undefined string in binary trace"));
+      }
+      break;
+    case TRACE_COLUMN_DOUBLE: {
+      if (m_values[i].size() - m_positions[i] < 8) {
+        BOOST_THROW_EXCEPTION(Error("Column " + m_columns[i].name + " is missing values"));
+      }
+      uint64_t bits = 0;
+      for (int j = 0; j < 8; ++j) {
+        bits |= static_cast<uint64_t>(m_values[i][m_positions[i]++]) << (8 * j);
+      }
+      std::memcpy(&row[i].real, &bits, sizeof(bits));
+      break;
+    }
+    default:
+      row[i].integer = decodeZigZag(readVarNumber(i));
+      break;
+    }
+  }
+  return true;
+}
+
+const std::string&
+BinaryTraceReader::getString(uint64_t id) const
+{
+  if (id >= m_strings.size()) {
+    BOOST_THROW_EXCEPTION(Error("Undefined string in binary trace"));
+  }
+  return m_strings[id];
+}
+
+void
+BinaryTraceReader::printString(std::ostream& os, const std::string& str, char separator) const
+{
+  if (separator == '\t' || str.find_first_of(std::string(1, separator) + "\"\n") == std::string::npos) {
+    os << str;
+    return;
+  }
+
+  os << '"';
+  for (char c : str) {
+    if (c == '"') {
+      os << '"';
+    }
+    os << c;
+  }
+  os << '"';
+}
+
+void
+BinaryTraceReader::convert(std::ostream& os, char separator)
+{
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    if (i > 0) {
+      os << separator;
+    }
+    printString(os, m_columns[i].name, separator);
+  }
+  os << "\n";
+
+  std::vector<Value> row;
+  while (readRow(row)) {
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+      if (i > 0) {
+        os << separator;
+      }
+      // same arithmetic as Time::ToDouble, so that the text matches the text trace
+      switch (m_columns[i].type) {
+      case TRACE_COLUMN_TIMESTAMP:
+      case TRACE_COLUMN_DURATION_S:
+        os << static_cast<double>(row[i].integer) / 1000000000;
+        break;
+      case TRACE_COLUMN_DURATION_US:
+        os << static_cast<double>(row[i].integer) / 1000;
+        break;
+      case TRACE_COLUMN_STRING:
+        printString(os, m_strings[row[i].integer], separator);
+        break;
+      case TRACE_COLUMN_INTEGER:
+        os << row[i].integer;
+        break;
+      case TRACE_COLUMN_DOUBLE:
+        os << row[i].real;
+        break;
+      }
+    }
+    os << "\n";
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,287 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_BINARY_TRACE_H
+#define NDN_BINARY_TRACE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Format of the trace files written by the tracers
+ */
+enum class TraceFormat {
+  TEXT,  ///< tab-separated text, one line per record
+  BINARY ///< compact binary records, see BinaryTraceWriter
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Column types of a binary trace
+ */
+enum BinaryTraceColumnType : uint8_t {
+  TRACE_COLUMN_TIMESTAMP = 1,   ///< simulation time, stored as a delta from the previous row
+  TRACE_COLUMN_STRING = 2,      ///< interned string
+  TRACE_COLUMN_INTEGER = 3,     ///< signed integer
+  TRACE_COLUMN_DOUBLE = 4,      ///< IEEE 754 double
+  TRACE_COLUMN_DURATION_S = 5,  ///< time interval, printed in seconds
+  TRACE_COLUMN_DURATION_US = 6, ///< time interval, printed in microseconds
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Column of a binary trace
+ */
+struct BinaryTraceColumn {
+  std::string name;
+  BinaryTraceColumnType type;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Writer of binary traces
+ *
+ * A binary trace holds the same rows as the text trace, without formatting them.  Node names,
+ * face URIs and record types are interned, so that each row refers to them by number.  Rows are
+ * buffered and written to the stream in blocks of about BLOCK_SIZE bytes, which store the values
+ * column by column.
+ *
+ * The file starts with a header:
+ *
+ *     "NDNTRACE" version(1 byte) nColumns(varint) { type(1 byte) nameLength(varint) name }...
+ *
+ * followed by blocks:
+ *
+ *     0x01 nRows(varint) nStrings(varint) { length(varint) bytes }... { size(varint) values }...
+ *
+ * A block first defines the strings interned since the previous block, their ids continuing
+ * from the previous ones starting from 0, then holds, for every column in order, the values of
+ * all nRows rows in `size` bytes.
+ *
+ * Values are encoded according to the column type: TIMESTAMP, INTEGER and DURATION_* as
+ * zigzag varints (TIMESTAMP and DURATION_* in nanoseconds), STRING as a varint string id,
+ * DOUBLE as 8 little-endian bytes.  Varints are LEB128.
+ *
+ * ndn-trace-convert turns a binary trace into the text format or CSV.
+ */
+class BinaryTraceWriter : boost::noncopyable {
+public:
+  static const size_t BLOCK_SIZE = 65536;
+
+  /**
+   * @brief Create writer and write the trace header
+   * @param os      stream to write to, must be opened in binary mode
+   * @param columns columns of every row
+   */
+  BinaryTraceWriter(shared_ptr<std::ostream> os, const std::vector<BinaryTraceColumn>& columns);
+
+  /**
+   * @brief Destructor, writes out buffered rows
+   */
+  ~BinaryTraceWriter();
+
+  /**
+   * @brief Get id of an interned string, defining it in the trace on first use
+   */
+  uint64_t
+  intern(const std::string& str);
+
+  /**
+   * @brief Append value of a TIMESTAMP column to the current row
+   */
+  BinaryTraceWriter&
+  appendTimestamp(const Time& time);
+
+  /**
+   * @brief Append value of a STRING column to the current row
+   */
+  BinaryTraceWriter&
+  appendString(const std::string& str);
+
+  /**
+   * @brief Append value of a STRING column to the current row, given its interned id
+   */
+  BinaryTraceWriter&
+  appendStringId(uint64_t id);
+
+  /**
+   * @brief Append value of an INTEGER column to the current row
+   */
+  BinaryTraceWriter&
+  appendInteger(int64_t value);
+
+  /**
+   * @brief Append value of a DOUBLE column to the current row
+   */
+  BinaryTraceWriter&
+  appendDouble(double value);
+
+  /**
+   * @brief Append value of a DURATION_S or DURATION_US column to the current row
+   */
+  BinaryTraceWriter&
+  appendDuration(const Time& duration);
+
+  /**
+   * @brief Finish the current row, after a value has been appended for every column
+   */
+  void
+  endRow();
+
+  /**
+   * @brief Write out buffered rows as a block
+   * @pre no row is being built
+   */
+  void
+  flush();
+
+private:
+  /**
+   * @return buffer of the column that the value goes to
+   */
+  std::vector<uint8_t>&
+  beginValue(BinaryTraceColumnType type);
+
+private:
+  shared_ptr<std::ostream> m_os;
+  std::vector<BinaryTraceColumn> m_columns;
+
+  std::vector<uint8_t> m_output;              ///< header or block being written out
+  std::vector<std::vector<uint8_t>> m_values; ///< values of each column in the current block
+  std::vector<uint8_t> m_newStrings;          ///< definitions of strings for the current block
+  size_t m_nNewStrings;
+  size_t m_nRows;   ///< number of finished rows in the current block
+  size_t m_nValues; ///< number of values in the current row
+
+  std::unordered_map<std::string, uint64_t> m_strings;
+  int64_t m_lastTimestamp;
+};
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Reader of binary traces written by BinaryTraceWriter
+ */
+class BinaryTraceReader : boost::noncopyable {
+public:
+  class Error : public std::runtime_error {
+  public:
+    explicit Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * @brief Value of one column in a row
+   */
+  struct Value {
+    int64_t integer; ///< TIMESTAMP and DURATION_* in nanoseconds, INTEGER, or STRING id
+    double real;     ///< DOUBLE
+  };
+
+  /**
+   * @brief Create reader and read the trace header
+   * @throw Error the stream does not start with a valid header
+   */
+  explicit BinaryTraceReader(std::istream& is);
+
+  const std::vector<BinaryTraceColumn>&
+  getColumns() const;
+
+  /**
+   * @brief Read the next row, along with the strings its block defines
+   * @return false at the end of the trace
+   * @throw Error the trace is truncated or malformed
+   */
+  bool
+  readRow(std::vector<Value>& row);
+
+  /**
+   * @brief Get an interned string
+   * @throw Error the string has not been defined
+   */
+  const std::string&
+  getString(uint64_t id) const;
+
+  /**
+   * @brief Convert the remaining rows to text
+   * @param os        output stream
+   * @param separator column separator; with a separator other than tab, strings containing
+   *                  it are quoted, as CSV requires
+   *
+   * The first line has the column names.  With tab as a separator, the output is the same as
+   * the text trace written by the tracer.
+   */
+  void
+  convert(std::ostream& os, char separator = '\t');
+
+private:
+  /**
+   * @brief Read the next block into m_values
+   * @return false at the end of the trace
+   */
+  bool
+  readBlock();
+
+  uint64_t
+  readVarNumber();
+
+  /**
+   * @brief Read the next number from values of a column in the current block
+   */
+  uint64_t
+  readVarNumber(size_t column);
+
+  void
+  printString(std::ostream& os, const std::string& str, char separator) const;
+
+private:
+  std::streambuf& m_input;
+  std::vector<BinaryTraceColumn> m_columns;
+  std::vector<std::string> m_strings;
+  int64_t m_lastTimestamp;
+
+  std::vector<std::vector<uint8_t>> m_values; ///< values of each column in the current block
+  std::vector<size_t> m_positions;            ///< position of the next value of each column
+  uint64_t m_nRowsLeft;                       ///< number of unread rows in the current block
+};
+
+inline const std::vector<BinaryTraceColumn>&
+BinaryTraceReader::getColumns() const
+{
+  return m_columns;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BINARY_TRACE_H
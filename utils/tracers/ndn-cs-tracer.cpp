@@ -30,6 +30,8 @@
 #include "ns3/node-list.h"
 #include "ns3/log.h"
 
+#include "helper/ndn-partition-helper.hpp"
+
 #include <boost/lexical_cast.hpp>
 
 #include <fstream>
@@ -48,7 +50,8 @@ CsTracer::Destroy()
 }
 
 void
-CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                     TraceFormat format /* = TraceFormat::TEXT*/)
 {
   using namespace boost;
   using namespace std;
@@ -57,10 +60,15 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::string fileName = PartitionHelper::GetPartitionFileName(file);
+    std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+    if (format == TraceFormat::BINARY) {
+      mode |= std::ios_base::binary;
+    }
+    os->open(fileName.c_str(), mode);
 
     if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
       return;
     }
 
@@ -70,12 +78,22 @@ CsTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
+  shared_ptr<BinaryTraceWriter> writer;
+  if (format == TraceFormat::BINARY) {
+    writer = make_shared<BinaryTraceWriter>(outputStream, GetBinaryColumns());
+  }
+
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
+    if (!PartitionHelper::IsLocal(*node)) {
+      continue;
+    }
+
+    Ptr<CsTracer> trace = writer != nullptr ? Install(*node, writer, averagingPeriod)
+                                            : Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (writer == nullptr && tracers.size() > 0) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -95,10 +113,11 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::string fileName = PartitionHelper::GetPartitionFileName(file);
+    os->open(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
 
     if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
       return;
     }
 
@@ -109,6 +128,10 @@ CsTracer::Install(const NodeContainer& nodes, const std::string& file,
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if (!PartitionHelper::IsLocal(*node)) {
+      continue;
+    }
+
     Ptr<CsTracer> trace = Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
@@ -126,6 +149,10 @@ void
 CsTracer::Install(Ptr<Node> node, const std::string& file,
                   Time averagingPeriod /* = Seconds (0.5)*/)
 {
+  if (!PartitionHelper::IsLocal(node)) {
+    return;
+  }
+
   using namespace boost;
   using namespace std;
 
@@ -133,10 +160,11 @@ CsTracer::Install(Ptr<Node> node, const std::string& file,
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::string fileName = PartitionHelper::GetPartitionFileName(file);
+    os->open(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
 
     if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
       return;
     }
 
@@ -170,6 +198,27 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
   return trace;
 }
 
+Ptr<CsTracer>
+CsTracer::Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer,
+                  Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<CsTracer> trace = Create<CsTracer>(writer, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+std::vector<BinaryTraceColumn>
+CsTracer::GetBinaryColumns()
+{
+  return {{"Time", TRACE_COLUMN_TIMESTAMP},
+          {"Node", TRACE_COLUMN_STRING},
+          {"Type", TRACE_COLUMN_STRING},
+          {"Packets", TRACE_COLUMN_DOUBLE}};
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -177,6 +226,7 @@ CsTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
 CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : m_nodePtr(node)
   , m_os(os)
+  , m_nodeId(0)
 {
   m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
 
@@ -191,10 +241,27 @@ CsTracer::CsTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 CsTracer::CsTracer(shared_ptr<std::ostream> os, const std::string& node)
   : m_node(node)
   , m_os(os)
+  , m_nodeId(0)
 {
   Connect();
 }
 
+CsTracer::CsTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_writer(writer)
+  , m_nodeId(0)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  Connect();
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+  m_nodeId = m_writer->intern(m_node);
+}
+
 CsTracer::~CsTracer(){};
 
 void
@@ -218,7 +285,12 @@ CsTracer::SetAveragingPeriod(const Time& period)
 void
 CsTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &CsTracer::PeriodicPrinter, this);
@@ -258,6 +330,19 @@ CsTracer::Print(std::ostream& os) const
   PRINTER("CacheMisses", m_cacheMisses);
 }
 
+#define WRITER(printName, fieldName)                                                               \
+  writer.appendTimestamp(time).appendStringId(m_nodeId).appendString(printName)                    \
+    .appendDouble(m_stats.fieldName).endRow();
+
+void
+CsTracer::Write(BinaryTraceWriter& writer) const
+{
+  Time time = Simulator::Now();
+
+  WRITER("CacheHits", m_cacheHits);
+  WRITER("CacheMisses", m_cacheMisses);
+}
+
 void
 CsTracer::CacheHits(shared_ptr<const Interest>, shared_ptr<const Data>)
 {
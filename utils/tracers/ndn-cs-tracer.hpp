@@ -22,6 +22,8 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ndn-binary-trace.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 #include <ns3/nstime.h>
@@ -67,6 +69,8 @@ public:
    * @param file File to which traces will be written.  If filename is -, then std::out is used
    * @param averagingPeriod How often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file; a binary trace can be converted to text or CSV
+   *        with ndn-trace-convert
    *
    * @returns a tuple of reference to output stream and list of tracers. !!! Attention !!! This
    *tuple needs to be preserved
@@ -74,7 +78,8 @@ public:
    *
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -124,6 +129,24 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node, writing a binary trace
+   *
+   * @param node Node on which to install tracer
+   * @param writer Binary trace writer, which must have been created with GetBinaryColumns ()
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<CsTracer>
+  Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer,
+          Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Columns of the binary trace, same as those of the text trace
+   */
+  static std::vector<BinaryTraceColumn>
+  GetBinaryColumns();
+
   /**
    * @brief Explicit request to remove all statically created tracers
    *
@@ -147,6 +170,14 @@ public:
    */
   CsTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   *        and writes a binary trace
+   * @param writer binary trace writer
+   * @param node   pointer to the node
+   */
+  CsTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -168,6 +199,14 @@ public:
   void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data as binary trace rows
+   *
+   * @param writer binary trace writer
+   */
+  void
+  Write(BinaryTraceWriter& writer) const;
+
 private:
   void
   Connect();
@@ -193,6 +232,8 @@ private:
   Ptr<Node> m_nodePtr;
 
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_writer;
+  uint64_t m_nodeId; ///< interned node name, if writing a binary trace
 
   Time m_period;
   EventId m_printEvent;
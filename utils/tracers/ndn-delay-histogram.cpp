@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-delay-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+
+const int DelayHistogram::PRECISION_BITS;
+
+static const uint64_t N_SUB_BUCKETS = 1 << DelayHistogram::PRECISION_BITS;
+static const uint64_t N_HALF_SUB_BUCKETS = N_SUB_BUCKETS / 2;
+
+static inline int
+log2Floor(uint64_t value)
+{
+  return 63 - __builtin_clzll(value);
+}
+
+DelayHistogram::DelayHistogram()
+  : m_offset(0)
+  , m_count(0)
+  , m_min(0)
+  , m_max(0)
+{
+}
+
+size_t
+DelayHistogram::getIndex(uint64_t value)
+{
+  // values below N_SUB_BUCKETS have a bucket each; above, each power-of-two range
+  // [2^k, 2^(k+1)) has N_HALF_SUB_BUCKETS buckets of width 2^(k - PRECISION_BITS + 1)
+  if (value < N_SUB_BUCKETS) {
+    return value;
+  }
+  int shift = log2Floor(value) - (PRECISION_BITS - 1);
+  return shift * N_HALF_SUB_BUCKETS + (value >> shift);
+}
+
+uint64_t
+DelayHistogram::getLowestValue(size_t index)
+{
+  if (index < N_SUB_BUCKETS) {
+    return index;
+  }
+  int shift = index / N_HALF_SUB_BUCKETS - 1;
+  return (index - shift * N_HALF_SUB_BUCKETS) << shift;
+}
+
+uint64_t
+DelayHistogram::getWidth(size_t index)
+{
+  if (index < N_SUB_BUCKETS) {
+    return 1;
+  }
+  return uint64_t(1) << (index / N_HALF_SUB_BUCKETS - 1);
+}
+
+void
+DelayHistogram::addToBucket(size_t index, uint64_t count)
+{
+  if (m_counts.empty()) {
+    m_offset = index;
+    m_counts.push_back(0);
+  }
+  else if (index < m_offset) {
+    m_counts.insert(m_counts.begin(), m_offset - index, 0);
+    m_offset = index;
+  }
+  else if (index >= m_offset + m_counts.size()) {
+    m_counts.resize(index - m_offset + 1, 0);
+  }
+  m_counts[index - m_offset] += count;
+}
+
+void
+DelayHistogram::add(const Time& delay)
+{
+  uint64_t value = std::max<int64_t>(delay.GetNanoSeconds(), 0);
+  addToBucket(getIndex(value), 1);
+
+  if (m_count == 0 || value < m_min) {
+    m_min = value;
+  }
+  if (m_count == 0 || value > m_max) {
+    m_max = value;
+  }
+  ++m_count;
+}
+
+void
+DelayHistogram::merge(const DelayHistogram& other)
+{
+  if (other.m_count == 0) {
+    return;
+  }
+
+  for (size_t i = 0; i < other.m_counts.size(); ++i) {
+    if (other.m_counts[i] > 0) {
+      addToBucket(other.m_offset + i, other.m_counts[i]);
+    }
+  }
+
+  if (m_count == 0 || other.m_min < m_min) {
+    m_min = other.m_min;
+  }
+  if (m_count == 0 || other.m_max > m_max) {
+    m_max = other.m_max;
+  }
+  m_count += other.m_count;
+}
+
+void
+DelayHistogram::reset()
+{
+  std::fill(m_counts.begin(), m_counts.end(), 0);
+  m_count = 0;
+  m_min = 0;
+  m_max = 0;
+}
+
+Time
+DelayHistogram::getQuantile(double q) const
+{
+  if (m_count == 0) {
+    return Seconds(0);
+  }
+
+  uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(q * m_count)), 1);
+  uint64_t seen = 0;
+  size_t i = 0;
+  for (; i < m_counts.size() - 1; ++i) {
+    seen += m_counts[i];
+    if (seen >= rank) {
+      break;
+    }
+  }
+
+  size_t index = m_offset + i;
+  uint64_t value = getLowestValue(index) + getWidth(index) / 2;
+  return NanoSeconds(std::min(std::max(value, m_min), m_max));
+}
+
+} // namespace ndn
+} // namespace ns3
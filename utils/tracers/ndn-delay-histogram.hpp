@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_DELAY_HISTOGRAM_H
+#define NDN_DELAY_HISTOGRAM_H
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Streaming sketch of a delay distribution
+ *
+ * Delays are counted in log-linear buckets, as in HDR histograms: every power-of-two range of
+ * nanoseconds is split into 2^(PRECISION_BITS - 1) buckets of equal width, so that quantiles are
+ * known within 1 / 2^PRECISION_BITS of their value.  Only the buckets between the smallest and
+ * the largest delay are stored, which keeps the sketch small for the narrow range of delays a
+ * single application observes.
+ */
+class DelayHistogram {
+public:
+  static const int PRECISION_BITS = 7;
+
+  DelayHistogram();
+
+  /**
+   * @brief Add a delay to the distribution
+   */
+  void
+  add(const Time& delay);
+
+  /**
+   * @brief Add all delays of another distribution
+   */
+  void
+  merge(const DelayHistogram& other);
+
+  /**
+   * @brief Forget all delays, keeping the allocated buckets
+   */
+  void
+  reset();
+
+  uint64_t
+  getCount() const;
+
+  Time
+  getMin() const;
+
+  Time
+  getMax() const;
+
+  /**
+   * @brief Get delay at quantile @p q, 0 < q <= 1
+   *
+   * @return the middle of the bucket holding the quantile, clamped to the observed minimum and
+   *         maximum; zero if the distribution is empty
+   */
+  Time
+  getQuantile(double q) const;
+
+private:
+  void
+  addToBucket(size_t index, uint64_t count);
+
+  static size_t
+  getIndex(uint64_t value);
+
+  static uint64_t
+  getLowestValue(size_t index);
+
+  static uint64_t
+  getWidth(size_t index);
+
+private:
+  size_t m_offset; ///< bucket index of m_counts[0]
+  std::vector<uint64_t> m_counts;
+  uint64_t m_count;
+  uint64_t m_min;
+  uint64_t m_max;
+};
+
+inline uint64_t
+DelayHistogram::getCount() const
+{
+  return m_count;
+}
+
+inline Time
+DelayHistogram::getMin() const
+{
+  return NanoSeconds(m_min);
+}
+
+inline Time
+DelayHistogram::getMax() const
+{
+  return NanoSeconds(m_max);
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DELAY_HISTOGRAM_H
@@ -24,6 +24,8 @@
 #include "ns3/callback.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+
+#include "helper/ndn-partition-helper.hpp"
 #include "ns3/node-list.h"
 
 #include "daemon/table/pit-entry.hpp"
@@ -46,16 +48,22 @@ L3RateTracer::Destroy()
 }
 
 void
-L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/,
+                         TraceFormat format /* = TraceFormat::TEXT*/)
 {
   std::list<Ptr<L3RateTracer>> tracers;
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::string fileName = PartitionHelper::GetPartitionFileName(file);
+    std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+    if (format == TraceFormat::BINARY) {
+      mode |= std::ios_base::binary;
+    }
+    os->open(fileName.c_str(), mode);
 
     if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
       return;
     }
 
@@ -65,12 +73,22 @@ L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seco
     outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
+  shared_ptr<BinaryTraceWriter> writer;
+  if (format == TraceFormat::BINARY) {
+    writer = make_shared<BinaryTraceWriter>(outputStream, GetBinaryColumns());
+  }
+
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
+    if (!PartitionHelper::IsLocal(*node)) {
+      continue;
+    }
+
+    Ptr<L3RateTracer> trace = writer != nullptr ? Install(*node, writer, averagingPeriod)
+                                                : Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
 
-  if (tracers.size() > 0) {
+  if (writer == nullptr && tracers.size() > 0) {
     // *m_l3RateTrace << "# "; // not necessary for R's read.table
     tracers.front()->PrintHeader(*outputStream);
     *outputStream << "\n";
@@ -90,10 +108,11 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::string fileName = PartitionHelper::GetPartitionFileName(file);
+    os->open(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
 
     if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
       return;
     }
 
@@ -104,6 +123,10 @@ L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
   }
 
   for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if (!PartitionHelper::IsLocal(*node)) {
+      continue;
+    }
+
     Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
     tracers.push_back(trace);
   }
@@ -121,6 +144,10 @@ void
 L3RateTracer::Install(Ptr<Node> node, const std::string& file,
                       Time averagingPeriod /* = Seconds (0.5)*/)
 {
+  if (!PartitionHelper::IsLocal(node)) {
+    return;
+  }
+
   using namespace boost;
   using namespace std;
 
@@ -128,10 +155,11 @@ L3RateTracer::Install(Ptr<Node> node, const std::string& file,
   shared_ptr<std::ostream> outputStream;
   if (file != "-") {
     shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+    std::string fileName = PartitionHelper::GetPartitionFileName(file);
+    os->open(fileName.c_str(), std::ios_base::out | std::ios_base::trunc);
 
     if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      NS_LOG_ERROR("File " << fileName << " cannot be opened for writing. Tracing disabled");
       return;
     }
 
@@ -165,9 +193,36 @@ L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
   return trace;
 }
 
+Ptr<L3RateTracer>
+L3RateTracer::Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<L3RateTracer> trace = Create<L3RateTracer>(writer, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+std::vector<BinaryTraceColumn>
+L3RateTracer::GetBinaryColumns()
+{
+  return {{"Time", TRACE_COLUMN_TIMESTAMP},
+          {"Node", TRACE_COLUMN_STRING},
+          {"FaceId", TRACE_COLUMN_INTEGER},
+          {"FaceDescr", TRACE_COLUMN_STRING},
+          {"Type", TRACE_COLUMN_STRING},
+          {"Packets", TRACE_COLUMN_DOUBLE},
+          {"Kilobytes", TRACE_COLUMN_DOUBLE},
+          {"PacketRaw", TRACE_COLUMN_DOUBLE},
+          {"KilobytesRaw", TRACE_COLUMN_DOUBLE}};
+}
+
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
+  , m_nodeId(0)
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -175,6 +230,15 @@ L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
   , m_os(os)
+  , m_nodeId(0)
+{
+  SetAveragingPeriod(Seconds(1.0));
+}
+
+L3RateTracer::L3RateTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node)
+  : L3Tracer(node)
+  , m_writer(writer)
+  , m_nodeId(writer->intern(m_node))
 {
   SetAveragingPeriod(Seconds(1.0));
 }
@@ -195,7 +259,12 @@ L3RateTracer::SetAveragingPeriod(const Time& period)
 void
 L3RateTracer::PeriodicPrinter()
 {
-  Print(*m_os);
+  if (m_writer != nullptr) {
+    Write(*m_writer);
+  }
+  else {
+    Print(*m_os);
+  }
   Reset();
 
   m_printEvent = Simulator::Schedule(m_period, &L3RateTracer::PeriodicPrinter, this);
@@ -239,12 +308,14 @@ const double alpha = 0.8;
 #define STATS(INDEX) std::get<INDEX>(stats.second)
 #define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
 
-#define PRINTER(printName, fieldName)                                                              \
+#define UPDATE(fieldName)                                                                          \
   STATS(2).fieldName =                                                                             \
     /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
   STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
-                                                                                                   \
+                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;
+
+#define PRINTER(printName, fieldName)                                                              \
+  UPDATE(fieldName)                                                                                \
   os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
   if (stats.first != nullptr) {                                                                    \
     os << stats.first->getId() << "\t" << stats.first->getLocalUri() << "\t";                      \
@@ -287,6 +358,55 @@ L3RateTracer::Print(std::ostream& os) const
   }
 }
 
+#define WRITER(printName, fieldName)                                                               \
+  UPDATE(fieldName)                                                                                \
+  writer.appendTimestamp(time).appendStringId(m_nodeId);                                           \
+  if (stats.first != nullptr) {                                                                    \
+    writer.appendInteger(stats.first->getId())                                                     \
+      .appendString(stats.first->getLocalUri().toString());                                        \
+  }                                                                                                \
+  else {                                                                                           \
+    writer.appendInteger(-1).appendString("all");                                                  \
+  }                                                                                                \
+  writer.appendString(printName)                                                                   \
+    .appendDouble(STATS(2).fieldName)                                                              \
+    .appendDouble(STATS(3).fieldName)                                                              \
+    .appendDouble(STATS(0).fieldName)                                                              \
+    .appendDouble(STATS(1).fieldName / 1024.0)                                                     \
+    .endRow();
+
+void
+L3RateTracer::Write(BinaryTraceWriter& writer) const
+{
+  Time time = Simulator::Now();
+
+  for (auto& stats : m_stats) {
+    if (stats.first == nullptr)
+      continue;
+
+    WRITER("InInterests", m_inInterests);
+    WRITER("OutInterests", m_outInterests);
+
+    WRITER("InData", m_inData);
+    WRITER("OutData", m_outData);
+
+    WRITER("InSatisfiedInterests", m_satisfiedInterests);
+    WRITER("InTimedOutInterests", m_timedOutInterests);
+
+    WRITER("OutSatisfiedInterests", m_outSatisfiedInterests);
+    WRITER("OutTimedOutInterests", m_outTimedOutInterests);
+  }
+
+  {
+    auto i = m_stats.find(nullptr);
+    if (i != m_stats.end()) {
+      auto& stats = *i;
+      WRITER("SatisfiedInterests", m_satisfiedInterests);
+      WRITER("TimedOutInterests", m_timedOutInterests);
+    }
+  }
+}
+
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
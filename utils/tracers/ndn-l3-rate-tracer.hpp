@@ -23,6 +23,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-l3-tracer.hpp"
+#include "ndn-binary-trace.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
@@ -48,9 +49,12 @@ public:
    * @param averagingPeriod Defines averaging period for the rate calculation,
    *        as well as how often data will be written into the trace file (default, every half
    *second)
+   * @param format Format of the trace file; a binary trace can be converted to text or CSV
+   *        with ndn-trace-convert
    */
   static void
-  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5));
+  InstallAll(const std::string& file, Time averagingPeriod = Seconds(0.5),
+             TraceFormat format = TraceFormat::TEXT);
 
   /**
    * @brief Helper method to install tracers on the selected simulation nodes
@@ -97,6 +101,14 @@ public:
    */
   L3RateTracer(shared_ptr<std::ostream> os, const std::string& node);
 
+  /**
+   * @brief Trace constructor that attaches to the node using node pointer
+   *        and writes a binary trace
+   * @param writer binary trace writer
+   * @param node   pointer to the node
+   */
+  L3RateTracer(shared_ptr<BinaryTraceWriter> writer, Ptr<Node> node);
+
   /**
    * @brief Destructor
    */
@@ -118,6 +130,24 @@ public:
   Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
           Time averagingPeriod = Seconds(0.5));
 
+  /**
+   * @brief Helper method to install tracers on a specific simulation node, writing a binary trace
+   *
+   * @param node Node on which to install tracer
+   * @param writer Binary trace writer, which must have been created with GetBinaryColumns ()
+   * @param averagingPeriod How often data will be written into the trace file (default, every half
+   *second)
+   */
+  static Ptr<L3RateTracer>
+  Install(Ptr<Node> node, shared_ptr<BinaryTraceWriter> writer,
+          Time averagingPeriod = Seconds(0.5));
+
+  /**
+   * @brief Columns of the binary trace, same as those of the text trace
+   */
+  static std::vector<BinaryTraceColumn>
+  GetBinaryColumns();
+
   // from L3Tracer
   virtual void
   PrintHeader(std::ostream& os) const;
@@ -125,6 +155,14 @@ public:
   virtual void
   Print(std::ostream& os) const;
 
+  /**
+   * @brief Write current trace data as binary trace rows
+   *
+   * @param writer binary trace writer
+   */
+  void
+  Write(BinaryTraceWriter& writer) const;
+
 protected:
   // from L3Tracer
   virtual void
@@ -157,6 +195,8 @@ private:
 
 private:
   shared_ptr<std::ostream> m_os;
+  shared_ptr<BinaryTraceWriter> m_writer;
+  uint64_t m_nodeId; ///< interned node name, if writing a binary trace
   Time m_period;
   EventId m_printEvent;
 